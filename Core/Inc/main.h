@@ -58,13 +58,30 @@ void Error_Handler(void);
 /* USER CODE END EFP */
 
 /* Private defines -----------------------------------------------------------*/
+#define SPI_NSS_Pin GPIO_PIN_0
+#define SPI_NSS_GPIO_Port GPIOB
+#define SPI_NSS_EXTI_IRQn EXTI0_IRQn
+#define SPI_READY_Pin GPIO_PIN_1
+#define SPI_READY_GPIO_Port GPIOB
+/* USER CODE BEGIN Private defines */
+/* RGB-LED, eingerichtet über die Pin-Tabelle in main.c (nicht über CubeMX) */
 #define RGB_BL_Pin GPIO_PIN_4
 #define RGB_BL_GPIO_Port GPIOA
 #define RGB_RT_Pin GPIO_PIN_6
 #define RGB_RT_GPIO_Port GPIOA
 #define RGB_GN_Pin GPIO_PIN_8
 #define RGB_GN_GPIO_Port GPIOA
-/* USER CODE BEGIN Private defines */
+/* Eingänge der Flankenerfassung, eingerichtet über die Tabelle EdgeTable in main.c (EXTI3 bzw. EXTI5) */
+#define EDGE_A_Pin GPIO_PIN_3
+#define EDGE_A_GPIO_Port GPIOA
+#define EDGE_B_Pin GPIO_PIN_5
+#define EDGE_B_GPIO_Port GPIOB
+/* Eingang des Frequenzmessers (TIM2_CH1, AF1), eingerichtet in MX_TIM2_FreqMeter_Init() */
+#define FREQ_IN_Pin GPIO_PIN_0
+#define FREQ_IN_GPIO_Port GPIOA
+/* Analogeingang des ADC-Streams (ADC1_IN10), eingerichtet in MX_ADC1_Stream_Init() */
+#define ADC_IN_Pin GPIO_PIN_5
+#define ADC_IN_GPIO_Port GPIOA
 
 /* USER CODE END Private defines */
 
@@ -23,7 +23,29 @@
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
 #include "string.h"
+#include "stdlib.h"
 #include "mylib_serialprot.h"
+#include "mylib_serialprot_uart.h"
+#include "mylib_serialprot_spi.h"
+#include "mylib_serialprot_i2c.h"
+#include "mylib_i2cbridge.h"
+#include "mylib_modbus.h"
+#include "mylib_gpiotable.h"
+#include "mylib_pwm.h"
+#include "mylib_sequencer.h"
+#include "mylib_scheduler.h"
+#include "mylib_edgecapture.h"
+#include "mylib_logic.h"
+#include "mylib_freqmeter.h"
+#include "mylib_adcstream.h"
+#include "mylib_stats.h"
+#include "mylib_capture.h"
+#include "mylib_script.h"
+#include "mylib_macro.h"
+#ifdef HAL_PCD_MODULE_ENABLED
+#include "usb_device.h"
+#include "mylib_serialprot_usb.h"
+#endif /* HAL_PCD_MODULE_ENABLED */
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -33,7 +55,19 @@
 
 /* Private define ------------------------------------------------------------*/
 /* USER CODE BEGIN PD */
-#define RxBuffer_SIZE 1
+/* Adresse dieses Boards am RS-485-Bus (USART1), je Board eindeutig 0..127 */
+#define RS485_NODE_ADDRESS 1
+/* UART2 (virtueller COM-Port) als Modbus-RTU-Slave mit dieser Adresse (1..247) statt der Kommandozeile */
+/* #define USART2_MODBUS_ADDRESS 17 */
+/* Pins, die mit "#gpm,maske:pegel" gemeinsam in einem BSRR-Zugriff geschaltet werden dürfen (nur Ausgänge) */
+#define GPM_GPIO_Port GPIOA
+#define GPM_PIN_MASK (RGB_BL_Pin|RGB_RT_Pin|RGB_GN_Pin)
+/* Quellen der Statistik, Zeile in StatsNames */
+#define STATS_SOURCE_ADC 0
+#define STATS_SOURCE_PERIOD 1
+#define STATS_SOURCE_HIGH 2
+#define STATS_SOURCE_RANDOM 3
+
 /* USER CODE END PD */
 
 /* Private macro -------------------------------------------------------------*/
@@ -42,20 +76,95 @@
 /* USER CODE END PM */
 
 /* Private variables ---------------------------------------------------------*/
+I2C_HandleTypeDef hi2c1;
+I2C_HandleTypeDef hi2c3;
+
+UART_HandleTypeDef huart1;
 UART_HandleTypeDef huart2;
+DMA_HandleTypeDef hdma_usart2_rx;
+DMA_HandleTypeDef hdma_usart2_tx;
 
 /* USER CODE BEGIN PV */
-SERIALPROTOCOL_TypeDef hserialprot;
-
-// Deklarieren und initialisieren des Ein-Zeichen-Empfangsbuffers
-uint8_t RxBuffer[RxBuffer_SIZE]={0};
+/* Pin-Tabelle der GPIOs (im Flash), Name für "#gpo,<name>:on|off", die LEDs leuchten bei Low */
+static const GPIOTABLE_DescriptorTypeDef GpioTable[] = {
+	{"rt", RGB_RT_GPIO_Port, RGB_RT_Pin, GPIO_PIN_RESET, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL},
+	{"gn", RGB_GN_GPIO_Port, RGB_GN_Pin, GPIO_PIN_RESET, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL},
+	{"bl", RGB_BL_GPIO_Port, RGB_BL_Pin, GPIO_PIN_RESET, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL},
+};
+GPIOTABLE_TypeDef hgpiotable;
+/* Helligkeit der LEDs mit "#pwm,<name>:<promille>", PA4 hat keinen TIM-Kanal und wird vom LPTIM2 getrieben */
+static const PWM_ChannelTypeDef PwmTable[] = {
+	{"rt", RGB_RT_GPIO_Port, RGB_RT_Pin, GPIO_AF14_TIM16, TIM16, TIM_CHANNEL_1, GPIO_PIN_RESET},
+	{"gn", RGB_GN_GPIO_Port, RGB_GN_Pin, GPIO_AF1_TIM1, TIM1, TIM_CHANNEL_1, GPIO_PIN_RESET},
+	{"bl", RGB_BL_GPIO_Port, RGB_BL_Pin, GPIO_AF14_LPTIM2, LPTIM2, 0, GPIO_PIN_RESET},
+};
+PWM_TypeDef hpwm;
+/* Pin-Muster der LEDs per TIM6 und DMA auf GPIOA->BSRR ("sqc", "sqa", "sqr", "sqs") */
+SEQUENCER_TypeDef hsequencer;
+/* Gerätezeit (TIM2, 1 MHz) und GPIO-Aktionen zu absoluten Zeitpunkten ("tnw", "tsh", "son", "sof", "scl", "sst") */
+SCHEDULER_TypeDef hscheduler;
+/* Eingänge mit Flankenerfassung per EXTI ("edg"), je Pin eine eigene EXTI-Leitung, Index = Zeile */
+static const EDGECAPTURE_InputTypeDef EdgeTable[] = {
+	{"ea", EDGE_A_GPIO_Port, EDGE_A_Pin, GPIO_PULLDOWN},
+	{"eb", EDGE_B_GPIO_Port, EDGE_B_Pin, GPIO_PULLDOWN},
+};
+EDGECAPTURE_TypeDef hedgecapture;
+/* Logikanalysator: TIM7 tastet GPIOA per DMA ab, die Läufe gehen an die Instanz von "lar" ("lch", "ltg", "lar", "las") */
+LOGIC_TypeDef hlogic;
+/* Frequenz und Pulsbreite an PA0 (TIM2 Kanal 1/2, Zeitstempel per DMA-Burst) ("fqs", "fqr", "fqx") */
+FREQMETER_TypeDef hfreqmeter;
+/* ADC1 an PA5, von TIM15 getaktet und per DMA gemittelt gestreamt ("ads", "adq", "adx", "ade") */
+ADCSTREAM_TypeDef hadcstream;
+/* laufende Statistik ("sgr", "sgw", "sgc"), Index = Zeile der Namenstabelle */
+static const char * const StatsNames[] = {"adc", "per", "hi", "rdm"};
+STATS_TypeDef hstats;
+/* Ringaufzeichnung von GPIOA, ADC-Mittelwerten oder empfangenen Zeichen um ein Ereignis ("cps", "cpt", "cpe", "cpa", "cpf", "cpx") */
+CAPTURE_TypeDef hcapture;
+/* Bytecode-Interpreter für Kommandofolgen, LPTIM1 taktet ihn jede ms ("vmc", "vma", "vmr", "vmx", "vmv") */
+SCRIPT_TypeDef hscript;
+/* Makros aus Kommandozeilen in der letzten Flash-Seite ("mcb", "mce", "mcu", "mcr", "mcd", "mcl", "mcs") */
+MACRO_TypeDef hmacro;
+/* je UART eine unabhängige Instanz des seriellen Protokolls */
+SERIALPROTOCOL_TypeDef hserialprot1;
+SERIALPROTOCOL_TypeDef hserialprot2;
+SERIALPROTOCOL_TypeDef hserialprot3;
+SERIALPROTOCOL_TypeDef hserialprot4;
+/* Transportschichten der Instanzen */
+SERIALPROT_UART_TypeDef hserialuart1;
+SERIALPROT_UART_TypeDef hserialuart2;
+SERIALPROT_SPI_TypeDef hserialspi1;
+SERIALPROT_I2C_TypeDef hseriali2c3;
+/* I2C1 als Master für die Sensoren der Prüfvorrichtung */
+I2CBRIDGE_TypeDef hi2cbridge1;
+#ifdef USART2_MODBUS_ADDRESS
+/* Modbus-RTU-Slave auf UART2, Coils und Register über die Kommandos des Protokolls */
+MODBUS_TypeDef hmodbus2;
+#endif /* USART2_MODBUS_ADDRESS */
+#ifdef HAL_PCD_MODULE_ENABLED
+/* USB-CDC-ACM (virtueller COM-Port direkt am USB des L432) */
+SERIALPROTOCOL_TypeDef hserialprot5;
+SERIALPROT_USB_TypeDef hserialusb;
+#endif /* HAL_PCD_MODULE_ENABLED */
 /* USER CODE END PV */
 
 /* Private function prototypes -----------------------------------------------*/
 void SystemClock_Config(void);
 static void MX_GPIO_Init(void);
+static void MX_DMA_Init(void);
 static void MX_USART2_UART_Init(void);
+static void MX_USART1_UART_Init(void);
+static void MX_I2C3_Init(void);
+static void MX_I2C1_Init(void);
 /* USER CODE BEGIN PFP */
+static void MX_SPI1_Slave_Init(void);
+static void MX_TIM6_Sequencer_Init(void);
+static void MX_TIM2_Scheduler_Init(void);
+static void MX_EXTI_EdgeCapture_Init(void);
+static void MX_TIM7_Logic_Init(void);
+static void MX_TIM2_FreqMeter_Init(void);
+static void MX_ADC1_Stream_Init(void);
+static void MX_LPTIM1_Script_Init(void);
+static uint8_t GPIO_Command_Mask(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
 
 /* USER CODE END PFP */
 
@@ -92,13 +201,124 @@ int main(void)
 
   /* Initialize all configured peripherals */
   MX_GPIO_Init();
+  MX_DMA_Init();
   MX_USART2_UART_Init();
+  MX_USART1_UART_Init();
+  MX_I2C3_Init();
+  MX_I2C1_Init();
   /* USER CODE BEGIN 2 */
-  HAL_UART_Receive_IT(&huart2, RxBuffer, RxBuffer_SIZE);
+  /* GPIOs der Pin-Tabelle einrichten, die LEDs starten ausgeschaltet */
+  MYLIB_GPIOTABLE_Init(&hgpiotable, GpioTable, sizeof(GpioTable)/sizeof(GpioTable[0]));
+  /* PWM-Timer der LEDs starten, Tastgrad 0 (Pins bleiben Ausgänge bis zum ersten "pwm") */
+  MYLIB_PWM_Init(&hpwm, PwmTable, sizeof(PwmTable)/sizeof(PwmTable[0]));
+
+#ifndef HAL_PCD_MODULE_ENABLED
+  /* PA11/PA12 sind bei USB die Datenleitungen, SPI1 nur ohne USB */
+  MX_SPI1_Slave_Init();
+#endif /* HAL_PCD_MODULE_ENABLED */
+
+  /* Transportschichten der UARTs anlegen (UART2 per DMA, USART1 per Interrupt),
+     Instanzen daran binden und den Empfang starten */
+#ifdef USART2_MODBUS_ADDRESS
+  /* UART2 als Modbus-RTU-Slave, Rahmenende über den Receiver-Timeout */
+  MYLIB_MODBUS_Init(&hmodbus2, &huart2, USART2_MODBUS_ADDRESS);
+#else
+  MYLIB_SERIALPROT_UART_Init(&hserialuart2, &huart2, SERIALPROT_UART_MODE_DMA);
+  /* '\r' sofort melden statt erst beim IDLE (schneller "gpo"-Pfad) */
+  MYLIB_SERIALPROT_UART_EnableLineMatch(&hserialuart2);
+  MYLIB_SERIALPROT_Init(&hserialprot2, &hserialuart2.Transport);
+#endif /* USART2_MODBUS_ADDRESS */
+  MYLIB_SERIALPROT_UART_Init(&hserialuart1, &huart1, SERIALPROT_UART_MODE_IT);
+
+  /* USART1 am RS-485-Bus: nur Rahmen mit der eigenen Adresse wecken den UART auf, kein Echo */
+  MYLIB_SERIALPROT_UART_EnableMultiDrop(&hserialuart1, RS485_NODE_ADDRESS);
+  MYLIB_SERIALPROT_Init(&hserialprot1, &hserialuart1.Transport);
+  hserialprot1.Quiet = 1;
+
+#ifdef HAL_PCD_MODULE_ENABLED
+  /* USB-CDC-ACM, Antworten werden als Übertragungen aus vollen Paketen gesendet */
+  MYLIB_SERIALPROT_USB_Init(&hserialusb, MYLIB_SERIALPROT_USB_CDC_Send, &hUsbDeviceFS);
+  MYLIB_SERIALPROT_Init(&hserialprot5, &hserialusb.Transport);
+#else
+  /* SPI1 als Slave für den schnellen Kommandobetrieb, ohne Echo und Eingabeaufforderung */
+  hserialspi1.Init.Instance = SPI1;
+  hserialspi1.Init.RxChannel = DMA1_Channel2;
+  hserialspi1.Init.TxChannel = DMA1_Channel3;
+  hserialspi1.Init.DmaRequest = 1;
+  hserialspi1.Init.ReadyPort = SPI_READY_GPIO_Port;
+  hserialspi1.Init.ReadyPin = SPI_READY_Pin;
+  MYLIB_SERIALPROT_SPI_Init(&hserialspi1);
+  MYLIB_SERIALPROT_Init(&hserialprot3, &hserialspi1.Transport);
+  hserialprot3.Quiet = 1;
+#endif /* HAL_PCD_MODULE_ENABLED */
+
+  /* I2C3 als Slave mit Registerschnittstelle, mehrere Boards an einem Bus */
+  MYLIB_SERIALPROT_I2C_Init(&hseriali2c3, &hi2c3);
+  MYLIB_SERIALPROT_Init(&hserialprot4, &hseriali2c3.Transport);
+  hserialprot4.Quiet = 1;
+
+  /* I2C1 als Master: Kommandos "isl", "ird", "iwr", "ibf", "ibw" aller Instanzen */
+  MYLIB_I2CBRIDGE_Init(&hi2cbridge1, &hi2c1);
+
+  /* Sequencer: TIM6-Update fordert je Schritt DMA2 Kanal 4 (Request 3 = TIM6_UP) an, Ziel GPIOA->BSRR */
+  MX_TIM6_Sequencer_Init();
+  hsequencer.Init.Timer = TIM6;
+  hsequencer.Init.Channel = DMA2_Channel4;
+  hsequencer.Init.DmaRequest = 3;
+  hsequencer.Init.Port = GPM_GPIO_Port;
+  hsequencer.Init.Pins = GPM_PIN_MASK;
+  MYLIB_SEQUENCER_Init(&hsequencer);
+
+  /* Scheduler: TIM2 läuft ab hier als Gerätezeit, Kanal 4 vergleicht mit der nächsten Aktion */
+  MX_TIM2_Scheduler_Init();
+  MYLIB_SCHEDULER_Init(&hscheduler, TIM2, &hgpiotable);
+
+  /* Flankenerfassung: PA3 (EXTI3) und PB5 (EXTI5), Zeitstempel aus dem DWT-Zyklenzähler */
+  MYLIB_EDGECAPTURE_Init(&hedgecapture, EdgeTable, sizeof(EdgeTable)/sizeof(EdgeTable[0]));
+  MX_EXTI_EdgeCapture_Init();
+
+  /* Logikanalysator: TIM7-Update fordert je Abtastung DMA2 Kanal 5 (Request 3 = TIM7_UP) an, Quelle GPIOA->IDR */
+  MX_TIM7_Logic_Init();
+  hlogic.Init.Timer = TIM7;
+  hlogic.Init.Channel = DMA2_Channel5;
+  hlogic.Init.DmaRequest = 3;
+  hlogic.Init.Port = GPIOA;
+  MYLIB_LOGIC_Init(&hlogic);
+
+  /* Frequenzmesser: TIM2 (Gerätezeit) Kanal 1 an PA0, CC1 fordert DMA1 Kanal 5 an (Request 4 = TIM2_CH1) */
+  MX_TIM2_FreqMeter_Init();
+  hfreqmeter.Init.Timer = TIM2;
+  hfreqmeter.Init.Channel = DMA1_Channel5;
+  hfreqmeter.Init.DmaRequest = 4;
+  MYLIB_FREQMETER_Init(&hfreqmeter);
+
+  /* ADC-Stream: TIM15-Update (TRGO, EXTSEL 14) startet je Abtastung eine Wandlung von ADC1_IN10 (PA5), DMA1 Kanal 1 (Request 0) */
+  MX_ADC1_Stream_Init();
+  hadcstream.Init.Instance = ADC1;
+  hadcstream.Init.AdcChannel = 10;
+  hadcstream.Init.ExternalTrigger = 14;
+  hadcstream.Init.Timer = TIM15;
+  hadcstream.Init.Channel = DMA1_Channel1;
+  hadcstream.Init.DmaRequest = 0;
+  MYLIB_ADCSTREAM_Init(&hadcstream);
+
+  /* Statistik über ADC-Mittelwerte, Perioden und High-Zeiten des Frequenzmessers und Zufallszahlen */
+  MYLIB_STATS_Init(&hstats, StatsNames, sizeof(StatsNames)/sizeof(StatsNames[0]));
 
-  HAL_GPIO_WritePin(RGB_BL_GPIO_Port, RGB_BL_Pin, GPIO_PIN_SET);
-  HAL_GPIO_WritePin(RGB_RT_GPIO_Port, RGB_RT_Pin, GPIO_PIN_SET);
-  HAL_GPIO_WritePin(RGB_GN_GPIO_Port, RGB_GN_Pin, GPIO_PIN_SET);
+  /* Ringaufzeichnung: TIM2 (Gerätezeit) Kanal 3 taktet die Abtastung von GPIOA und das Hochladen */
+  hcapture.Init.Timer = TIM2;
+  hcapture.Init.Port = GPIOA;
+  MYLIB_CAPTURE_Init(&hcapture);
+
+  /* Interpreter: LPTIM1 (Takt PCLK1) löst jede ms einen Interrupt aus, die Programme rufen die Kommandos direkt auf */
+  MX_LPTIM1_Script_Init();
+  hscript.Init.Timer = LPTIM1;
+  MYLIB_SCRIPT_Init(&hscript);
+
+  /* Makros: letzte Flash-Seite (im Linker-Skript ausgenommen), "boot" richtet das Board nach dem Reset ein */
+  hmacro.Init.Page = 127;
+  MYLIB_MACRO_Init(&hmacro);
+  MYLIB_MACRO_Boot(&hmacro);
 
   /* USER CODE END 2 */
 
@@ -155,6 +375,133 @@ void SystemClock_Config(void)
   }
 }
 
+/**
+  * @brief I2C1 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_I2C1_Init(void)
+{
+
+  /* USER CODE BEGIN I2C1_Init 0 */
+
+  /* USER CODE END I2C1_Init 0 */
+
+  /* USER CODE BEGIN I2C1_Init 1 */
+
+  /* USER CODE END I2C1_Init 1 */
+  hi2c1.Instance = I2C1;
+  hi2c1.Init.Timing = 0x00420F13;
+  hi2c1.Init.OwnAddress1 = 0;
+  hi2c1.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+  hi2c1.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+  hi2c1.Init.OwnAddress2 = 0;
+  hi2c1.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
+  hi2c1.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+  hi2c1.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+  if (HAL_I2C_Init(&hi2c1) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /** Configure Analogue filter
+  */
+  if (HAL_I2CEx_ConfigAnalogFilter(&hi2c1, I2C_ANALOGFILTER_ENABLE) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /** Configure Digital filter
+  */
+  if (HAL_I2CEx_ConfigDigitalFilter(&hi2c1, 0) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN I2C1_Init 2 */
+
+  /* USER CODE END I2C1_Init 2 */
+
+}
+
+/**
+  * @brief I2C3 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_I2C3_Init(void)
+{
+
+  /* USER CODE BEGIN I2C3_Init 0 */
+
+  /* USER CODE END I2C3_Init 0 */
+
+  /* USER CODE BEGIN I2C3_Init 1 */
+
+  /* USER CODE END I2C3_Init 1 */
+  hi2c3.Instance = I2C3;
+  hi2c3.Init.Timing = 0x00100309;
+  hi2c3.Init.OwnAddress1 = 96;
+  hi2c3.Init.AddressingMode = I2C_ADDRESSINGMODE_7BIT;
+  hi2c3.Init.DualAddressMode = I2C_DUALADDRESS_DISABLE;
+  hi2c3.Init.OwnAddress2 = 0;
+  hi2c3.Init.OwnAddress2Masks = I2C_OA2_NOMASK;
+  hi2c3.Init.GeneralCallMode = I2C_GENERALCALL_DISABLE;
+  hi2c3.Init.NoStretchMode = I2C_NOSTRETCH_DISABLE;
+  if (HAL_I2C_Init(&hi2c3) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /** Configure Analogue filter
+  */
+  if (HAL_I2CEx_ConfigAnalogFilter(&hi2c3, I2C_ANALOGFILTER_ENABLE) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /** Configure Digital filter
+  */
+  if (HAL_I2CEx_ConfigDigitalFilter(&hi2c3, 0) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN I2C3_Init 2 */
+
+  /* USER CODE END I2C3_Init 2 */
+
+}
+
+/**
+  * @brief USART1 Initialization Function
+  * @param None
+  * @retval None
+  */
+static void MX_USART1_UART_Init(void)
+{
+
+  /* USER CODE BEGIN USART1_Init 0 */
+
+  /* USER CODE END USART1_Init 0 */
+
+  /* USER CODE BEGIN USART1_Init 1 */
+
+  /* USER CODE END USART1_Init 1 */
+  huart1.Instance = USART1;
+  huart1.Init.BaudRate = 115200;
+  huart1.Init.WordLength = UART_WORDLENGTH_8B;
+  huart1.Init.StopBits = UART_STOPBITS_1;
+  huart1.Init.Parity = UART_PARITY_NONE;
+  huart1.Init.Mode = UART_MODE_TX_RX;
+  huart1.Init.HwFlowCtl = UART_HWCONTROL_NONE;
+  huart1.Init.OverSampling = UART_OVERSAMPLING_16;
+  huart1.Init.OneBitSampling = UART_ONE_BIT_SAMPLE_DISABLE;
+  huart1.AdvancedInit.AdvFeatureInit = UART_ADVFEATURE_NO_INIT;
+  if (HAL_RS485Ex_Init(&huart1, UART_DE_POLARITY_HIGH, 16, 16) != HAL_OK)
+  {
+    Error_Handler();
+  }
+  /* USER CODE BEGIN USART1_Init 2 */
+
+  /* USER CODE END USART1_Init 2 */
+
+}
+
 /**
   * @brief USART2 Initialization Function
   * @param None
@@ -190,6 +537,25 @@ static void MX_USART2_UART_Init(void)
 
 }
 
+/**
+  * Enable DMA controller clock
+  */
+static void MX_DMA_Init(void)
+{
+
+  /* DMA controller clock enable */
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* DMA interrupt init */
+  /* DMA1_Channel6_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel6_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel6_IRQn);
+  /* DMA1_Channel7_IRQn interrupt configuration */
+  HAL_NVIC_SetPriority(DMA1_Channel7_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel7_IRQn);
+
+}
+
 /**
   * @brief GPIO Initialization Function
   * @param None
@@ -201,85 +567,428 @@ static void MX_GPIO_Init(void)
 
   /* GPIO Ports Clock Enable */
   __HAL_RCC_GPIOA_CLK_ENABLE();
+  __HAL_RCC_GPIOB_CLK_ENABLE();
 
   /*Configure GPIO pin Output Level */
-  HAL_GPIO_WritePin(GPIOA, RGB_BL_Pin|RGB_RT_Pin|RGB_GN_Pin, GPIO_PIN_RESET);
+  HAL_GPIO_WritePin(SPI_READY_GPIO_Port, SPI_READY_Pin, GPIO_PIN_RESET);
+
+#ifndef HAL_PCD_MODULE_ENABLED
+  /*Configure GPIO pin : SPI_NSS_Pin */
+  GPIO_InitStruct.Pin = SPI_NSS_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+  GPIO_InitStruct.Pull = GPIO_PULLUP;
+  HAL_GPIO_Init(SPI_NSS_GPIO_Port, &GPIO_InitStruct);
+#endif /* HAL_PCD_MODULE_ENABLED */
 
-  /*Configure GPIO pins : RGB_BL_Pin RGB_RT_Pin RGB_GN_Pin */
-  GPIO_InitStruct.Pin = RGB_BL_Pin|RGB_RT_Pin|RGB_GN_Pin;
+  /*Configure GPIO pin : SPI_READY_Pin */
+  GPIO_InitStruct.Pin = SPI_READY_Pin;
   GPIO_InitStruct.Mode = GPIO_MODE_OUTPUT_PP;
   GPIO_InitStruct.Pull = GPIO_NOPULL;
   GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
-  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+  HAL_GPIO_Init(SPI_READY_GPIO_Port, &GPIO_InitStruct);
+
+#ifndef HAL_PCD_MODULE_ENABLED
+  /* EXTI interrupt init (NSS nur mit dem SPI1-Slave, mit USB bleibt hserialspi1 uninitialisiert) */
+  HAL_NVIC_SetPriority(EXTI0_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI0_IRQn);
+#endif /* HAL_PCD_MODULE_ENABLED */
 
 }
 
 /* USER CODE BEGIN 4 */
 
-/* UART-Callback wird nach jedem Zeichen aufgerufen */
-void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+/**
+  * @brief SPI1 Slave Initialization Function
+  * Der SPI-HAL-Treiber ist nicht im Projekt enthalten, daher werden hier nur Takt, Pins und Interrupts
+  * eingerichtet, die SPI selbst konfiguriert die Transportschicht mylib_serialprot_spi über die Register.
+  * @param None
+  * @retval None
+  */
+static void MX_SPI1_Slave_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_SPI1_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /**SPI1 GPIO Configuration
+  PA1     ------> SPI1_SCK
+  PA11     ------> SPI1_MISO
+  PA12     ------> SPI1_MOSI
+  */
+  GPIO_InitStruct.Pin = GPIO_PIN_1|GPIO_PIN_11|GPIO_PIN_12;
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_VERY_HIGH;
+  GPIO_InitStruct.Alternate = GPIO_AF5_SPI1;
+  HAL_GPIO_Init(GPIOA, &GPIO_InitStruct);
+
+  /* DMA1 Kanal 2 (SPI1_RX) und Kanal 3 (SPI1_TX), gleiche Priorität wie die UARTs */
+  HAL_NVIC_SetPriority(DMA1_Channel2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel2_IRQn);
+  HAL_NVIC_SetPriority(DMA1_Channel3_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel3_IRQn);
+}
+
+/**
+  * @brief TIM6 und DMA2 für den Sequencer: nur Takt und Interrupt, Timer und DMA-Kanal konfiguriert mylib_sequencer über die Register.
+  * @param None
+  * @retval None
+  */
+static void MX_TIM6_Sequencer_Init(void)
+{
+  __HAL_RCC_TIM6_CLK_ENABLE();
+  __HAL_RCC_DMA2_CLK_ENABLE();
+
+  /* DMA2 Kanal 4 (TIM6_UP), gleiche Priorität wie die Transportschichten */
+  HAL_NVIC_SetPriority(DMA2_Channel4_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Channel4_IRQn);
+}
+
+/**
+  * @brief TIM2 für den Scheduler: nur Takt und Interrupt, den Timer konfiguriert mylib_scheduler über die Register.
+  * @param None
+  * @retval None
+  */
+static void MX_TIM2_Scheduler_Init(void)
+{
+  __HAL_RCC_TIM2_CLK_ENABLE();
+
+  /* gleiche Priorität wie die Transportschichten: Kommandos und Vergleich unterbrechen sich nicht */
+  HAL_NVIC_SetPriority(TIM2_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(TIM2_IRQn);
+}
+
+/**
+  * @brief EXTI Initialization Function für die Flankenerfassung
+  * @param None
+  * @retval None
+  */
+static void MX_EXTI_EdgeCapture_Init(void)
+{
+  /* gleiche Priorität wie die Transportschichten: "edg" und die Flanken unterbrechen sich nicht */
+  HAL_NVIC_SetPriority(EXTI3_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI3_IRQn);
+  HAL_NVIC_SetPriority(EXTI9_5_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(EXTI9_5_IRQn);
+}
+
+/**
+  * @brief TIM7 und DMA2 für den Logikanalysator: nur Takt und Interrupt, Timer und DMA-Kanal konfiguriert mylib_logic über die Register.
+  * @param None
+  * @retval None
+  */
+static void MX_TIM7_Logic_Init(void)
 {
-	/* Nachrichtenbuffer für die Konsolen-Nachricht */
-	uint8_t exchangedMessage[50] ={0};
+  __HAL_RCC_TIM7_CLK_ENABLE();
+  __HAL_RCC_DMA2_CLK_ENABLE();
+
+  /* DMA2 Kanal 5 (TIM7_UP), gleiche Priorität wie die Transportschichten */
+  HAL_NVIC_SetPriority(DMA2_Channel5_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA2_Channel5_IRQn);
+}
 
+/**
+  * @brief TIM2 Kanal 1 als Eingang des Frequenzmessers: Pin und DMA-Interrupt, der Timer läuft bereits als Gerätezeit.
+  * @param None
+  * @retval None
+  */
+static void MX_TIM2_FreqMeter_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* PA0 -> TIM2_CH1 */
+  GPIO_InitStruct.Pin = FREQ_IN_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_AF_PP;
+  GPIO_InitStruct.Pull = GPIO_PULLDOWN;
+  GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+  GPIO_InitStruct.Alternate = GPIO_AF1_TIM2;
+  HAL_GPIO_Init(FREQ_IN_GPIO_Port, &GPIO_InitStruct);
+
+  /* DMA1 Kanal 5 (TIM2_CH1), gleiche Priorität wie die Transportschichten */
+  HAL_NVIC_SetPriority(DMA1_Channel5_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel5_IRQn);
+}
+
+/**
+  * @brief ADC1 und TIM15 für den ADC-Stream: Takte, Analogeingang und DMA-Interrupt, ADC und Timer konfiguriert mylib_adcstream über die Register.
+  * @param None
+  * @retval None
+  */
+static void MX_ADC1_Stream_Init(void)
+{
+  GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+  __HAL_RCC_ADC_CLK_ENABLE();
+  __HAL_RCC_TIM15_CLK_ENABLE();
+  __HAL_RCC_DMA1_CLK_ENABLE();
+
+  /* PA5 -> ADC1_IN10 */
+  GPIO_InitStruct.Pin = ADC_IN_Pin;
+  GPIO_InitStruct.Mode = GPIO_MODE_ANALOG;
+  GPIO_InitStruct.Pull = GPIO_NOPULL;
+  HAL_GPIO_Init(ADC_IN_GPIO_Port, &GPIO_InitStruct);
+
+  /* DMA1 Kanal 1 (ADC1), gleiche Priorität wie die Transportschichten */
+  HAL_NVIC_SetPriority(DMA1_Channel1_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+}
+
+/**
+  * @brief LPTIM1 als Takt des Interpreters: nur Takt und Interrupt, den Timer konfiguriert mylib_script über die Register.
+  * @param None
+  * @retval None
+  */
+static void MX_LPTIM1_Script_Init(void)
+{
+  __HAL_RCC_LPTIM1_CLK_ENABLE();
+  __HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_PCLK1);
+
+  /* gleiche Priorität wie die Transportschichten: Kommandos der Programme und der Schnittstellen unterbrechen sich nicht */
+  HAL_NVIC_SetPriority(LPTIM1_IRQn, 0, 0);
+  HAL_NVIC_EnableIRQ(LPTIM1_IRQn);
+}
+
+/* EXTI-Callback: Flanke an NSS wählt den SPI-Slave aus bzw. beendet die Übertragung */
+void HAL_GPIO_EXTI_Callback(uint16_t GPIO_Pin)
+{
+#ifndef HAL_PCD_MODULE_ENABLED
+	if(GPIO_Pin == SPI_NSS_Pin){
+		MYLIB_SERIALPROT_SPI_NSS_Callback(&hserialspi1, HAL_GPIO_ReadPin(SPI_NSS_GPIO_Port, SPI_NSS_Pin));
+	}
+#endif /* HAL_PCD_MODULE_ENABLED */
+}
+
+/* UART-Callback wird im Interrupt-Betrieb nach jedem Zeichen aufgerufen */
+void HAL_UART_RxCpltCallback(UART_HandleTypeDef *huart)
+{
 	/*
-	 * MYLIB_SERIALPROT_XCHANGE -> Verarbeitet die eingegebenen Zeichen des UART und gibt das demenstspechende Ergebnis/Nachricht zurück
-	 * hserialprot -> Objekt des Seriellen Protokolls
-	 * RxBuffer -> Ein-Zeichen-Empfangspuffer
-	 * exchangedMessage -> zurückgegebene Nachricht aufgrund der Eingaben von Rx bzw. auf der Konsole
+	 * MYLIB_SERIALPROT_UART_RxCpltCallback -> sucht die an den UART gebundene Transportschicht,
+	 * übergibt das empfangene Zeichen an die Instanz des Seriellen Protokolls und aktiviert den Empfang wieder
 	 * Die Verarbeitung erfolgt in der MyLibrary/mylib_serialprot-Bibliothek
 	 */
-	MYLIB_SERIALPROT_XCHANGE(&hserialprot,RxBuffer,exchangedMessage);
+	MYLIB_SERIALPROT_UART_RxCpltCallback(huart);
+#ifdef USART2_MODBUS_ADDRESS
+	/* Modbus: Empfangspuffer übergelaufen, Rahmen zu lang */
+	MYLIB_MODBUS_RxCpltCallback(&hmodbus2, huart);
+#endif /* USART2_MODBUS_ADDRESS */
+}
 
-	/* exchangedMessage an Putty/Konsole senden */
-	if(HAL_UART_Transmit(&huart2, exchangedMessage,(uint16_t)strlen(exchangedMessage), 100)!= HAL_OK){Error_Handler();}
+/* UART-Callback wird im DMA-Betrieb bei halbem/vollem Empfangspuffer und bei einer Empfangspause (IDLE) aufgerufen */
+void HAL_UARTEx_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size)
+{
+	MYLIB_SERIALPROT_UART_RxEventCallback(huart, Size);
+}
 
-	/* UART_Receive Interrupt aktivieren */
-	if(HAL_UART_Receive_IT(&huart2, RxBuffer, RxBuffer_SIZE)!= HAL_OK){Error_Handler();}
+/* UART-Callback wird nach jedem gesendeten Block aufgerufen, der zweite Sendepuffer wird gesendet */
+void HAL_UART_TxCpltCallback(UART_HandleTypeDef *huart)
+{
+	MYLIB_SERIALPROT_UART_TxCpltCallback(huart);
 }
 
-/* Callback für GPIO-Commands, welche der User selbst definieren kann */
-uint8_t SERIALPROT_Command_GPO_Callback(SERIALPROTOCOL_TypeDef *hserialprot)
+/* UART-Fehler-Callback: ORE/FE/NE/PE zählen, Flags löschen und den Empfang wieder aktivieren */
+void HAL_UART_ErrorCallback(UART_HandleTypeDef *huart)
+{
+	MYLIB_SERIALPROT_UART_ErrorCallback(huart);
+#ifdef USART2_MODBUS_ADDRESS
+	/* Modbus: Receiver-Timeout = Rahmenende */
+	MYLIB_MODBUS_ErrorCallback(&hmodbus2, huart);
+#endif /* USART2_MODBUS_ADDRESS */
+}
+
+/* I2C-Callbacks der Slave-Transportschicht: Adresse erkannt, Zeichen empfangen/gesendet, Übertragung beendet, Fehler */
+void HAL_I2C_AddrCallback(I2C_HandleTypeDef *hi2c, uint8_t TransferDirection, uint16_t AddrMatchCode)
 {
-	uint8_t ret=1;
+	MYLIB_SERIALPROT_I2C_AddrCallback(hi2c, TransferDirection, AddrMatchCode);
+}
+
+void HAL_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	MYLIB_SERIALPROT_I2C_SlaveRxCpltCallback(hi2c);
+}
+
+void HAL_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	MYLIB_SERIALPROT_I2C_SlaveTxCpltCallback(hi2c);
+}
+
+void HAL_I2C_ListenCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	MYLIB_SERIALPROT_I2C_ListenCpltCallback(hi2c);
+}
+
+/* I2C-Callbacks der Bridge (I2C1), die Funktionen ignorieren andere I2C */
+void HAL_I2C_MasterTxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	MYLIB_I2CBRIDGE_MasterTxCpltCallback(&hi2cbridge1, hi2c);
+}
 
-	/* Prüfen ob das Kommando "gpo" mit dem Parameter 1 "gn" und dem Parameter 2 "on" eingegeben wurde um die blaue LED einzuschalten */
-	if(__SERIALPROT_IS_COMMAND(hserialprot,"gpo","gn","on")){
-		HAL_GPIO_WritePin(RGB_GN_GPIO_Port, RGB_GN_Pin, GPIO_PIN_RESET);
-		ret=0;
+void HAL_I2C_MasterRxCpltCallback(I2C_HandleTypeDef *hi2c)
+{
+	MYLIB_I2CBRIDGE_MasterRxCpltCallback(&hi2cbridge1, hi2c);
+}
 
-	/* Prüfen ob das Kommando "gpo" mit dem Parameter 1 "gn" und dem Parameter 2 "on" eingegeben wurde um die blaue LED auszuschalten */
-	}else if(__SERIALPROT_IS_COMMAND(hserialprot,"gpo","gn","off") ){
-		HAL_GPIO_WritePin(RGB_GN_GPIO_Port, RGB_GN_Pin, GPIO_PIN_SET);
-		ret=0;
+void HAL_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c)
+{
+	MYLIB_SERIALPROT_I2C_ErrorCallback(hi2c);
+	MYLIB_I2CBRIDGE_ErrorCallback(&hi2cbridge1, hi2c);
+}
+
+/* Werte für die Statistik: gemittelte ADC-Werte, Perioden und High-Zeiten einer Messung, Zufallszahlen von "rdm",
+   ADC-Werte und empfangene Zeichen zusätzlich für die Ringaufzeichnung */
+void ADCSTREAM_Value_Callback(ADCSTREAM_TypeDef *hadcstream, uint16_t Value)
+{
+	MYLIB_STATS_Add(&hstats, STATS_SOURCE_ADC, Value);
+	MYLIB_CAPTURE_Add(&hcapture, CAPTURE_SOURCE_ADC, Value);
+}
+
+void FREQMETER_Period_Callback(FREQMETER_TypeDef *hfreqmeter, uint32_t Period, uint32_t High)
+{
+	MYLIB_STATS_Add(&hstats, STATS_SOURCE_PERIOD, Period);
+	if(High != 0){
+		MYLIB_STATS_Add(&hstats, STATS_SOURCE_HIGH, High);
 	}
+}
 
+void SERIALPROT_Random_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint16_t Value)
+{
+	MYLIB_STATS_Add(&hstats, STATS_SOURCE_RANDOM, Value);
+}
 
-	/* Prüfen ob das Kommando "gpo" mit dem Parameter 1 "gn" und dem Parameter 2 "on" eingegeben wurde um die grüne LED einzuschalten */
-	if(__SERIALPROT_IS_COMMAND(hserialprot,"gpo","bl","on")){
-		HAL_GPIO_WritePin(RGB_BL_GPIO_Port, RGB_BL_Pin, GPIO_PIN_RESET);
-		ret=0;
+void SERIALPROT_RxByte_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Byte)
+{
+	/* nur Zeichen echter Schnittstellen, nicht die der internen Instanzen von Modbus, Skript und Makro */
+	if(hserialprot->Transport != NULL){
+		MYLIB_CAPTURE_Add(&hcapture, CAPTURE_SOURCE_RX, Byte);
+	}
+	MYLIB_MACRO_RxByte(&hmacro, hserialprot, Byte);
+}
 
-	/* Prüfen ob das Kommando "gpo" mit dem Parameter 1 "gn" und dem Parameter 2 "on" eingegeben wurde um die grüne LED auszuschalten */
-	}else if(__SERIALPROT_IS_COMMAND(hserialprot,"gpo","bl","off")){
-		HAL_GPIO_WritePin(RGB_BL_GPIO_Port, RGB_BL_Pin, GPIO_PIN_SET);
-		ret=0;
+/* Callback für Kommandos, welche die Bibliothek nicht kennt ("gpm", "pwm", Sequencer, Scheduler, Flankenerfassung,
+   Logikanalysator, Frequenzmesser, ADC-Stream, Statistik, Ringaufzeichnung, Interpreter, Makros, I2C-Bridge) */
+uint8_t SERIALPROT_Command_User_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result)
+{
+	uint8_t status;
+
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"gpm")){
+		return GPIO_Command_Mask(hserialprot, Result);
+	}
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"pwm")){
+		return MYLIB_PWM_Command(&hpwm, hserialprot, Result);
+	}
+	if(!strncmp((char *)hserialprot->CommandName, "sq", 2)){
+		/* das Muster schreibt BSRR, die Pins dürfen nicht mehr vom PWM-Timer getrieben werden */
+		if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqr")){
+			MYLIB_PWM_ReleasePins(&hpwm, GPM_GPIO_Port, GPM_PIN_MASK);
+		}
+		return MYLIB_SEQUENCER_Command(&hsequencer, hserialprot, Result);
+	}
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"son") || __SERIALPROT_IS_COMMANDNAME(hserialprot,"sof")){
+		/* wie bei "gpo": die geplante Aktion schaltet statisch, eine laufende PWM am Pin endet schon jetzt */
+		const GPIOTABLE_DescriptorTypeDef *descriptor = MYLIB_GPIOTABLE_Find(&hgpiotable, (char *)hserialprot->Parameter1);
+		if(descriptor != NULL){
+			MYLIB_PWM_ReleasePins(&hpwm, descriptor->Port, descriptor->Pin);
+		}
+	}
+
+	status = MYLIB_SCHEDULER_Command(&hscheduler, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_EDGECAPTURE_Command(&hedgecapture, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_LOGIC_Command(&hlogic, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_FREQMETER_Command(&hfreqmeter, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_ADCSTREAM_Command(&hadcstream, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_STATS_Command(&hstats, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_CAPTURE_Command(&hcapture, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_SCRIPT_Command(&hscript, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	status = MYLIB_MACRO_Command(&hmacro, hserialprot, Result);
+	if(status != SERIALPROT_COMMAND_UNKNOWN){
+		return status;
+	}
+	return MYLIB_I2CBRIDGE_Command(&hi2cbridge1, hserialprot, Result);
+}
+
+/* Kommando "#gpm,maske:pegel": alle Pins der Maske (Bit n = Pin n) mit einem einzigen BSRR-Zugriff schalten,
+   gesetzte Bits im Pegel -> High, sonst Low. Die LEDs wechseln so ohne Zwischenfarben, Ergebnis ist der neue Ausgangszustand */
+static uint8_t GPIO_Command_Mask(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result)
+{
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	uint32_t mask = atoi((char *)hserialprot->Parameter1);
+	uint32_t level = atoi((char *)hserialprot->Parameter2);
+
+	/* nur freigegebene Pins, Pegel nur innerhalb der Maske */
+	if(mask == 0 || (mask & ~GPM_PIN_MASK) != 0 || (level & ~mask) != 0){
+		return SERIALPROT_COMMAND_INVALID;
 	}
 
+	/* Pins mit laufender PWM zuerst wieder als Ausgang übernehmen */
+	MYLIB_PWM_ReleasePins(&hpwm, GPM_GPIO_Port, mask);
 
-	/* Prüfen ob das Kommando "gpo" mit dem Parameter 1 "gn" und dem Parameter 2 "on" eingegeben wurde um die rote LED einzuschalten */
-	if(__SERIALPROT_IS_COMMAND(hserialprot,"gpo","rt","on")){
-		HAL_GPIO_WritePin(RGB_RT_GPIO_Port, RGB_RT_Pin, GPIO_PIN_RESET);
-		ret=0;
+	/* untere Hälfte von BSRR setzt, obere setzt zurück, ein Schreibzugriff für alle Pins */
+	GPM_GPIO_Port->BSRR = level | ((mask & ~level) << 16);
 
-	/* Prüfen ob das Kommando "gpo" mit dem Parameter 1 "gn" und dem Parameter 2 "on" eingegeben wurde um die rote LED auszuschalten */
-	}else if(__SERIALPROT_IS_COMMAND(hserialprot,"gpo","rt","off")){
-		HAL_GPIO_WritePin(RGB_RT_GPIO_Port, RGB_RT_Pin, GPIO_PIN_SET);
-		ret=0;
+	itoa(GPM_GPIO_Port->ODR & GPM_PIN_MASK, (char *)Result, 10);
+	return SERIALPROT_COMMAND_OK;
+}
+
+/* Callback für GPIO-Commands: die Pins und ihre Namen stehen in der Pin-Tabelle GpioTable */
+uint8_t SERIALPROT_Command_GPO_Callback(SERIALPROTOCOL_TypeDef *hserialprot)
+{
+	const GPIOTABLE_DescriptorTypeDef *descriptor = MYLIB_GPIOTABLE_Find(&hgpiotable, (char *)hserialprot->Parameter1);
+
+	/* "gpo" schaltet statisch, eine laufende PWM am Pin beenden */
+	if(descriptor != NULL){
+		MYLIB_PWM_ReleasePins(&hpwm, descriptor->Port, descriptor->Pin);
 	}
+	return MYLIB_GPIOTABLE_Command(&hgpiotable, hserialprot);
+}
+
+/* Schneller Pfad für "gpo": Pin-Name schon vor dem '\r' in Port und BSRR-Werte auflösen,
+   bei laufender PWM schaltet erst SERIALPROT_Command_GPO_Callback() den Pin wieder als Ausgang */
+uint8_t SERIALPROT_FastPath_Resolve_Callback(SERIALPROTOCOL_TypeDef *hserialprot, const uint8_t * Name, GPIO_TypeDef ** Port, uint32_t * BsrrOn, uint32_t * BsrrOff)
+{
+	const GPIOTABLE_DescriptorTypeDef *descriptor = MYLIB_GPIOTABLE_Find(&hgpiotable, (const char *)Name);
 
-	/* Rückgabe des Abfrageergebnisses */
-	return ret;
+	if(descriptor == NULL || descriptor->Mode == GPIO_MODE_INPUT){
+		return 1;
+	}
+
+	*Port = descriptor->Port;
+	if(descriptor->ActiveLevel == GPIO_PIN_SET){
+		*BsrrOn = descriptor->Pin;
+		*BsrrOff = (uint32_t)descriptor->Pin << 16;
+	}else{
+		*BsrrOn = (uint32_t)descriptor->Pin << 16;
+		*BsrrOff = descriptor->Pin;
+	}
+	return 0;
 }
 /* USER CODE END 4 */
 
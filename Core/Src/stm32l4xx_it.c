@@ -23,6 +23,17 @@
 #include "stm32l4xx_it.h"
 /* Private includes ----------------------------------------------------------*/
 /* USER CODE BEGIN Includes */
+#include "mylib_serialprot_uart.h"
+#include "mylib_serialprot_spi.h"
+#include "mylib_i2cbridge.h"
+#include "mylib_sequencer.h"
+#include "mylib_scheduler.h"
+#include "mylib_edgecapture.h"
+#include "mylib_logic.h"
+#include "mylib_freqmeter.h"
+#include "mylib_adcstream.h"
+#include "mylib_capture.h"
+#include "mylib_script.h"
 /* USER CODE END Includes */
 
 /* Private typedef -----------------------------------------------------------*/
@@ -56,8 +67,23 @@
 /* USER CODE END 0 */
 
 /* External variables --------------------------------------------------------*/
+extern I2C_HandleTypeDef hi2c1;
+extern I2C_HandleTypeDef hi2c3;
+extern DMA_HandleTypeDef hdma_usart2_rx;
+extern DMA_HandleTypeDef hdma_usart2_tx;
+extern UART_HandleTypeDef huart1;
 extern UART_HandleTypeDef huart2;
 /* USER CODE BEGIN EV */
+extern SERIALPROT_SPI_TypeDef hserialspi1;
+extern I2CBRIDGE_TypeDef hi2cbridge1;
+extern SEQUENCER_TypeDef hsequencer;
+extern SCHEDULER_TypeDef hscheduler;
+extern EDGECAPTURE_TypeDef hedgecapture;
+extern LOGIC_TypeDef hlogic;
+extern FREQMETER_TypeDef hfreqmeter;
+extern ADCSTREAM_TypeDef hadcstream;
+extern CAPTURE_TypeDef hcapture;
+extern SCRIPT_TypeDef hscript;
 
 /* USER CODE END EV */
 
@@ -199,13 +225,98 @@ void SysTick_Handler(void)
 /* please refer to the startup file (startup_stm32l4xx.s).                    */
 /******************************************************************************/
 
+/**
+  * @brief This function handles EXTI line0 interrupt.
+  */
+void EXTI0_IRQHandler(void)
+{
+  /* USER CODE BEGIN EXTI0_IRQn 0 */
+
+  /* USER CODE END EXTI0_IRQn 0 */
+  HAL_GPIO_EXTI_IRQHandler(SPI_NSS_Pin);
+  /* USER CODE BEGIN EXTI0_IRQn 1 */
+
+  /* USER CODE END EXTI0_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel6 global interrupt.
+  */
+void DMA1_Channel6_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel6_IRQn 0 */
+
+  /* USER CODE END DMA1_Channel6_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart2_rx);
+  /* USER CODE BEGIN DMA1_Channel6_IRQn 1 */
+
+  /* USER CODE END DMA1_Channel6_IRQn 1 */
+}
+
+/**
+  * @brief This function handles DMA1 channel7 global interrupt.
+  */
+void DMA1_Channel7_IRQHandler(void)
+{
+  /* USER CODE BEGIN DMA1_Channel7_IRQn 0 */
+
+  /* USER CODE END DMA1_Channel7_IRQn 0 */
+  HAL_DMA_IRQHandler(&hdma_usart2_tx);
+  /* USER CODE BEGIN DMA1_Channel7_IRQn 1 */
+
+  /* USER CODE END DMA1_Channel7_IRQn 1 */
+}
+
+/**
+  * @brief This function handles I2C1 event interrupt.
+  */
+void I2C1_EV_IRQHandler(void)
+{
+  /* USER CODE BEGIN I2C1_EV_IRQn 0 */
+
+  /* USER CODE END I2C1_EV_IRQn 0 */
+  HAL_I2C_EV_IRQHandler(&hi2c1);
+  /* USER CODE BEGIN I2C1_EV_IRQn 1 */
+
+  /* USER CODE END I2C1_EV_IRQn 1 */
+}
+
+/**
+  * @brief This function handles I2C1 error interrupt.
+  */
+void I2C1_ER_IRQHandler(void)
+{
+  /* USER CODE BEGIN I2C1_ER_IRQn 0 */
+  /* SCL-Timeout wird vom HAL-Treiber nicht behandelt */
+  MYLIB_I2CBRIDGE_ER_IRQHandler(&hi2cbridge1);
+  /* USER CODE END I2C1_ER_IRQn 0 */
+  HAL_I2C_ER_IRQHandler(&hi2c1);
+  /* USER CODE BEGIN I2C1_ER_IRQn 1 */
+
+  /* USER CODE END I2C1_ER_IRQn 1 */
+}
+
+/**
+  * @brief This function handles USART1 global interrupt.
+  */
+void USART1_IRQHandler(void)
+{
+  /* USER CODE BEGIN USART1_IRQn 0 */
+
+  /* USER CODE END USART1_IRQn 0 */
+  HAL_UART_IRQHandler(&huart1);
+  /* USER CODE BEGIN USART1_IRQn 1 */
+
+  /* USER CODE END USART1_IRQn 1 */
+}
+
 /**
   * @brief This function handles USART2 global interrupt.
   */
 void USART2_IRQHandler(void)
 {
   /* USER CODE BEGIN USART2_IRQn 0 */
-
+  MYLIB_SERIALPROT_UART_IRQHandler(&huart2);
   /* USER CODE END USART2_IRQn 0 */
   HAL_UART_IRQHandler(&huart2);
   /* USER CODE BEGIN USART2_IRQn 1 */
@@ -213,7 +324,116 @@ void USART2_IRQHandler(void)
   /* USER CODE END USART2_IRQn 1 */
 }
 
+/**
+  * @brief This function handles I2C3 event interrupt.
+  */
+void I2C3_EV_IRQHandler(void)
+{
+  /* USER CODE BEGIN I2C3_EV_IRQn 0 */
+
+  /* USER CODE END I2C3_EV_IRQn 0 */
+  HAL_I2C_EV_IRQHandler(&hi2c3);
+  /* USER CODE BEGIN I2C3_EV_IRQn 1 */
+
+  /* USER CODE END I2C3_EV_IRQn 1 */
+}
+
+/**
+  * @brief This function handles I2C3 error interrupt.
+  */
+void I2C3_ER_IRQHandler(void)
+{
+  /* USER CODE BEGIN I2C3_ER_IRQn 0 */
+
+  /* USER CODE END I2C3_ER_IRQn 0 */
+  HAL_I2C_ER_IRQHandler(&hi2c3);
+  /* USER CODE BEGIN I2C3_ER_IRQn 1 */
+
+  /* USER CODE END I2C3_ER_IRQn 1 */
+}
+
 /* USER CODE BEGIN 1 */
 
+/**
+  * @brief This function handles DMA1 channel2 global interrupt (SPI1_RX, registerbasiert).
+  */
+void DMA1_Channel2_IRQHandler(void)
+{
+  MYLIB_SERIALPROT_SPI_RxDMA_IRQHandler(&hserialspi1);
+}
+
+/**
+  * @brief This function handles DMA1 channel3 global interrupt (SPI1_TX, registerbasiert).
+  */
+void DMA1_Channel3_IRQHandler(void)
+{
+  MYLIB_SERIALPROT_SPI_TxDMA_IRQHandler(&hserialspi1);
+}
+
+/**
+  * @brief This function handles DMA2 channel4 global interrupt (TIM6_UP Sequencer, registerbasiert).
+  */
+void DMA2_Channel4_IRQHandler(void)
+{
+  MYLIB_SEQUENCER_DMA_IRQHandler(&hsequencer);
+}
+
+/**
+  * @brief This function handles TIM2 global interrupt (Scheduler Kanal 4, Ringaufzeichnung Kanal 3, registerbasiert).
+  */
+void TIM2_IRQHandler(void)
+{
+  MYLIB_SCHEDULER_IRQHandler(&hscheduler);
+  MYLIB_CAPTURE_IRQHandler(&hcapture);
+}
+
+/**
+  * @brief This function handles EXTI line3 interrupt (Flankenerfassung).
+  */
+void EXTI3_IRQHandler(void)
+{
+  MYLIB_EDGECAPTURE_IRQHandler(&hedgecapture);
+}
+
+/**
+  * @brief This function handles EXTI line[9:5] interrupts (Flankenerfassung).
+  */
+void EXTI9_5_IRQHandler(void)
+{
+  MYLIB_EDGECAPTURE_IRQHandler(&hedgecapture);
+}
+
+/**
+  * @brief This function handles DMA2 channel5 global interrupt (TIM7_UP Logikanalysator, registerbasiert).
+  */
+void DMA2_Channel5_IRQHandler(void)
+{
+  MYLIB_LOGIC_DMA_IRQHandler(&hlogic);
+}
+
+/**
+  * @brief This function handles DMA1 channel5 global interrupt (TIM2_CH1 Frequenzmesser, registerbasiert).
+  */
+void DMA1_Channel5_IRQHandler(void)
+{
+  MYLIB_FREQMETER_DMA_IRQHandler(&hfreqmeter);
+}
+
+/**
+  * @brief This function handles DMA1 channel1 global interrupt (ADC1 Stream, registerbasiert).
+  */
+void DMA1_Channel1_IRQHandler(void)
+{
+  MYLIB_ADCSTREAM_DMA_IRQHandler(&hadcstream);
+}
+
+/**
+  * @brief This function handles LPTIM1 global interrupt (Takt des Interpreters, registerbasiert).
+  */
+void LPTIM1_IRQHandler(void)
+{
+  MYLIB_SCRIPT_IRQHandler(&hscript);
+}
+
 /* USER CODE END 1 */
 /************************ (C) COPYRIGHT STMicroelectronics *****END OF FILE****/
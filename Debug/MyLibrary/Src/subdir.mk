@@ -5,13 +5,76 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../MyLibrary/Src/mylib_serialprot.c 
+../MyLibrary/Src/mylib_adcstream.c \
+../MyLibrary/Src/mylib_capture.c \
+../MyLibrary/Src/mylib_dmachannel.c \
+../MyLibrary/Src/mylib_edgecapture.c \
+../MyLibrary/Src/mylib_encode.c \
+../MyLibrary/Src/mylib_freqmeter.c \
+../MyLibrary/Src/mylib_gpiotable.c \
+../MyLibrary/Src/mylib_i2cbridge.c \
+../MyLibrary/Src/mylib_logic.c \
+../MyLibrary/Src/mylib_macro.c \
+../MyLibrary/Src/mylib_modbus.c \
+../MyLibrary/Src/mylib_pwm.c \
+../MyLibrary/Src/mylib_scheduler.c \
+../MyLibrary/Src/mylib_script.c \
+../MyLibrary/Src/mylib_sequencer.c \
+../MyLibrary/Src/mylib_serialprot.c \
+../MyLibrary/Src/mylib_serialprot_i2c.c \
+../MyLibrary/Src/mylib_serialprot_loopback.c \
+../MyLibrary/Src/mylib_serialprot_spi.c \
+../MyLibrary/Src/mylib_serialprot_uart.c \
+../MyLibrary/Src/mylib_stats.c \
+../MyLibrary/Src/mylib_serialprot_usb.c 
 
 OBJS += \
-./MyLibrary/Src/mylib_serialprot.o 
+./MyLibrary/Src/mylib_adcstream.o \
+./MyLibrary/Src/mylib_capture.o \
+./MyLibrary/Src/mylib_dmachannel.o \
+./MyLibrary/Src/mylib_edgecapture.o \
+./MyLibrary/Src/mylib_encode.o \
+./MyLibrary/Src/mylib_freqmeter.o \
+./MyLibrary/Src/mylib_gpiotable.o \
+./MyLibrary/Src/mylib_i2cbridge.o \
+./MyLibrary/Src/mylib_logic.o \
+./MyLibrary/Src/mylib_macro.o \
+./MyLibrary/Src/mylib_modbus.o \
+./MyLibrary/Src/mylib_pwm.o \
+./MyLibrary/Src/mylib_scheduler.o \
+./MyLibrary/Src/mylib_script.o \
+./MyLibrary/Src/mylib_sequencer.o \
+./MyLibrary/Src/mylib_serialprot.o \
+./MyLibrary/Src/mylib_serialprot_i2c.o \
+./MyLibrary/Src/mylib_serialprot_loopback.o \
+./MyLibrary/Src/mylib_serialprot_spi.o \
+./MyLibrary/Src/mylib_serialprot_uart.o \
+./MyLibrary/Src/mylib_stats.o \
+./MyLibrary/Src/mylib_serialprot_usb.o 
 
 C_DEPS += \
-./MyLibrary/Src/mylib_serialprot.d 
+./MyLibrary/Src/mylib_adcstream.d \
+./MyLibrary/Src/mylib_capture.d \
+./MyLibrary/Src/mylib_dmachannel.d \
+./MyLibrary/Src/mylib_edgecapture.d \
+./MyLibrary/Src/mylib_encode.d \
+./MyLibrary/Src/mylib_freqmeter.d \
+./MyLibrary/Src/mylib_gpiotable.d \
+./MyLibrary/Src/mylib_i2cbridge.d \
+./MyLibrary/Src/mylib_logic.d \
+./MyLibrary/Src/mylib_macro.d \
+./MyLibrary/Src/mylib_modbus.d \
+./MyLibrary/Src/mylib_pwm.d \
+./MyLibrary/Src/mylib_scheduler.d \
+./MyLibrary/Src/mylib_script.d \
+./MyLibrary/Src/mylib_sequencer.d \
+./MyLibrary/Src/mylib_serialprot.d \
+./MyLibrary/Src/mylib_serialprot_i2c.d \
+./MyLibrary/Src/mylib_serialprot_loopback.d \
+./MyLibrary/Src/mylib_serialprot_spi.d \
+./MyLibrary/Src/mylib_serialprot_uart.d \
+./MyLibrary/Src/mylib_stats.d \
+./MyLibrary/Src/mylib_serialprot_usb.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -21,7 +84,7 @@ MyLibrary/Src/%.o MyLibrary/Src/%.su: ../MyLibrary/Src/%.c MyLibrary/Src/subdir.
 clean: clean-MyLibrary-2f-Src
 
 clean-MyLibrary-2f-Src:
-	-$(RM) ./MyLibrary/Src/mylib_serialprot.d ./MyLibrary/Src/mylib_serialprot.o ./MyLibrary/Src/mylib_serialprot.su
+	-$(RM) ./MyLibrary/Src/mylib_adcstream.d ./MyLibrary/Src/mylib_adcstream.o ./MyLibrary/Src/mylib_adcstream.su ./MyLibrary/Src/mylib_capture.d ./MyLibrary/Src/mylib_capture.o ./MyLibrary/Src/mylib_capture.su ./MyLibrary/Src/mylib_dmachannel.d ./MyLibrary/Src/mylib_dmachannel.o ./MyLibrary/Src/mylib_dmachannel.su ./MyLibrary/Src/mylib_edgecapture.d ./MyLibrary/Src/mylib_edgecapture.o ./MyLibrary/Src/mylib_edgecapture.su ./MyLibrary/Src/mylib_encode.d ./MyLibrary/Src/mylib_encode.o ./MyLibrary/Src/mylib_encode.su ./MyLibrary/Src/mylib_freqmeter.d ./MyLibrary/Src/mylib_freqmeter.o ./MyLibrary/Src/mylib_freqmeter.su ./MyLibrary/Src/mylib_gpiotable.d ./MyLibrary/Src/mylib_gpiotable.o ./MyLibrary/Src/mylib_gpiotable.su ./MyLibrary/Src/mylib_i2cbridge.d ./MyLibrary/Src/mylib_i2cbridge.o ./MyLibrary/Src/mylib_i2cbridge.su ./MyLibrary/Src/mylib_logic.d ./MyLibrary/Src/mylib_logic.o ./MyLibrary/Src/mylib_logic.su ./MyLibrary/Src/mylib_macro.d ./MyLibrary/Src/mylib_macro.o ./MyLibrary/Src/mylib_macro.su ./MyLibrary/Src/mylib_modbus.d ./MyLibrary/Src/mylib_modbus.o ./MyLibrary/Src/mylib_modbus.su ./MyLibrary/Src/mylib_pwm.d ./MyLibrary/Src/mylib_pwm.o ./MyLibrary/Src/mylib_pwm.su ./MyLibrary/Src/mylib_scheduler.d ./MyLibrary/Src/mylib_scheduler.o ./MyLibrary/Src/mylib_scheduler.su ./MyLibrary/Src/mylib_script.d ./MyLibrary/Src/mylib_script.o ./MyLibrary/Src/mylib_script.su ./MyLibrary/Src/mylib_sequencer.d ./MyLibrary/Src/mylib_sequencer.o ./MyLibrary/Src/mylib_sequencer.su ./MyLibrary/Src/mylib_serialprot.d ./MyLibrary/Src/mylib_serialprot.o ./MyLibrary/Src/mylib_serialprot.su ./MyLibrary/Src/mylib_serialprot_i2c.d ./MyLibrary/Src/mylib_serialprot_i2c.o ./MyLibrary/Src/mylib_serialprot_i2c.su ./MyLibrary/Src/mylib_serialprot_loopback.d ./MyLibrary/Src/mylib_serialprot_loopback.o ./MyLibrary/Src/mylib_serialprot_loopback.su ./MyLibrary/Src/mylib_serialprot_spi.d ./MyLibrary/Src/mylib_serialprot_spi.o ./MyLibrary/Src/mylib_serialprot_spi.su ./MyLibrary/Src/mylib_serialprot_uart.d ./MyLibrary/Src/mylib_serialprot_uart.o ./MyLibrary/Src/mylib_serialprot_uart.su ./MyLibrary/Src/mylib_serialprot_usb.d ./MyLibrary/Src/mylib_serialprot_usb.o ./MyLibrary/Src/mylib_serialprot_usb.su ./MyLibrary/Src/mylib_stats.d ./MyLibrary/Src/mylib_stats.o ./MyLibrary/Src/mylib_stats.su
 
 .PHONY: clean-MyLibrary-2f-Src
 
@@ -0,0 +1,127 @@
+/**
+  ******************************************************************************
+  * @file    mylib_adcstream.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_ADCSTREAM (ADC per Timer und DMA, gemittelt und über das serielle Protokoll gestreamt)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_ADCSTREAM_H_
+#define INC_MYLIB_ADCSTREAM_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+#include "mylib_encode.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup ADCSTREAM_Exported_Constants ADCSTREAM Exported Constants
+   * @{
+   */
+#define ADCSTREAM_HALF_SIZE 64					/*!< Abtastwerte je Hälfte des zirkulären DMA-Puffers, Vielfaches der größten Mittelung */
+#define ADCSTREAM_SHIFT_MAX 6					/*!< größte Mittelung 2^6 = 64 Abtastwerte */
+#define ADCSTREAM_LINE_SAMPLES 16				/*!< gemittelte Werte je gesendeter Zeile im Hex-Format */
+#define ADCSTREAM_LINE_SAMPLES_PACKED 48		/*!< gemittelte Werte je gepackter Zeile (max. 2 Varint-Bytes je Wert, <= ENCODE_BYTES_MAX) */
+#define ADCSTREAM_COUNTER_CLOCK 1000000U		/*!< Zähltakt des Timers in Hz, die Abtastperiode wird in µs angegeben */
+#define ADCSTREAM_PERIOD_MIN_US 20				/*!< kürzeste Abtastperiode (Wandlung 47,5 + 12,5 ADC-Takte bei 4 MHz) */
+#define ADCSTREAM_PERIOD_MAX_US SERIALPROT_PARAM_MAX	/*!< längste Abtastperiode */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup ADCSTREAM_Exported_Types ADCSTREAM Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  ADCSTREAM Konfiguration structures definition
+   */
+ typedef struct
+ {
+   ADC_TypeDef *Instance;             /*!< ADC (ADC1), Takt bereits eingeschaltet */
+
+   uint32_t AdcChannel;               /*!< Eingangskanal des ADC (z.B. 10 = PA5), der Pin ist als Analogeingang eingerichtet */
+
+   uint32_t ExternalTrigger;          /*!< EXTSEL des Timers (z.B. 14 = TIM15_TRGO) */
+
+   TIM_TypeDef *Timer;                /*!< Timer, dessen Update (TRGO) je Abtastung eine Wandlung startet */
+
+   DMA_Channel_TypeDef *Channel;      /*!< DMA-Kanal des ADC */
+
+   uint32_t DmaRequest;               /*!< DMA-Request des ADC auf dem Kanal (CSELR) */
+ }ADCSTREAM_InitTypeDef;
+
+
+ /**
+   * @brief  ADCSTREAM handle structures definition
+   */
+ typedef struct
+ {
+   ADCSTREAM_InitTypeDef Init;   /*!< Konfiguration */
+
+   uint16_t Buffer[2 * ADCSTREAM_HALF_SIZE] __ALIGNED(4); /*!< zirkulärer DMA-Puffer, je zwei Werte werden als ein Wort gemittelt */
+
+   uint8_t Shift;                /*!< Mittelung über 2^Shift Abtastwerte */
+
+   ENCODE_ModeTypeDef Encoding;  /*!< Format der gesendeten Zeilen, nur im angehaltenen Zustand änderbar */
+
+   uint16_t Line[ADCSTREAM_LINE_SAMPLES_PACKED]; /*!< gemittelte Werte der nächsten Zeile */
+
+   uint8_t LineCount;            /*!< Anzahl der Werte in Line */
+
+   uint16_t Sequence;            /*!< laufende Nummer der nächsten Zeile, Lücken zeigen verworfene Zeilen */
+
+   uint32_t LinesSent;           /*!< Anzahl gesendeter Zeilen seit dem Start */
+
+   uint32_t LinesDropped;        /*!< Anzahl verworfener Zeilen (Sendewarteschlange voll) */
+
+   volatile uint8_t Running;     /*!< 1: Timer, ADC und DMA laufen */
+
+   SERIALPROTOCOL_TypeDef *hserialprot; /*!< Instanz, die den Stream gestartet hat und ihn empfängt, NULL = ohne Zeilen */
+ }ADCSTREAM_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup ADCSTREAM_Exported_Functions ADCSTREAM Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_ADCSTREAM_Init(ADCSTREAM_TypeDef *hadcstream);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_ADCSTREAM_Start(ADCSTREAM_TypeDef *hadcstream, uint16_t PeriodUs, uint8_t Shift);
+void MYLIB_ADCSTREAM_Stop(ADCSTREAM_TypeDef *hadcstream);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_ADCSTREAM_Command(ADCSTREAM_TypeDef *hadcstream, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_ADCSTREAM_DMA_IRQHandler(ADCSTREAM_TypeDef *hadcstream);
+
+/* Callback functions  ********************************************************/
+void ADCSTREAM_Value_Callback(ADCSTREAM_TypeDef *hadcstream, uint16_t Value);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_ADCSTREAM_H_ */
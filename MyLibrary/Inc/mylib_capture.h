@@ -0,0 +1,174 @@
+/**
+  ******************************************************************************
+  * @file    mylib_capture.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_CAPTURE (Ringaufzeichnung mit Vor- und Nachlauf um ein Triggerereignis)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_CAPTURE_H_
+#define INC_MYLIB_CAPTURE_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+#include "mylib_encode.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup CAPTURE_Exported_Constants CAPTURE Exported Constants
+   * @{
+   */
+#define CAPTURE_SIZE 1024						/*!< Werte im Ring (Zweierpotenz), Vor- und Nachlauf zusammen */
+#define CAPTURE_TICK_US 1000U					/*!< Takt der GPIO-Abtastung und des Hochladens in µs der Gerätezeit (Kanal 3 des Timers) */
+#define CAPTURE_LINE_VALUES 16					/*!< Werte je hochgeladener Zeile im Hex-Format */
+#define CAPTURE_LINE_VALUES_PACKED 32			/*!< Werte je gepackter Zeile (max. 3 Varint-Bytes je Wert, <= ENCODE_BYTES_MAX) */
+#define CAPTURE_DIVIDER_MAX SERIALPROT_PARAM_MAX	/*!< größter Teiler der Quelle */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup CAPTURE_Exported_Types CAPTURE Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  CAPTURE Quelle der Werte
+   */
+ typedef enum
+ {
+	 CAPTURE_SOURCE_GPIO = 0x00,		/*!< Eingangsregister des Ports (IDR), je CAPTURE_TICK_US abgetastet */
+	 CAPTURE_SOURCE_ADC = 0x01,			/*!< Mittelwerte des ADC-Streams (ADCSTREAM_Value_Callback()) */
+	 CAPTURE_SOURCE_RX = 0x02			/*!< empfangene Zeichen aller Instanzen des Protokolls (SERIALPROT_RxByte_Callback()) */
+ } CAPTURE_SourceTypeDef;
+
+
+ /**
+   * @brief  CAPTURE Triggerbedingung, verglichen wird mit Level
+   */
+ typedef enum
+ {
+	 CAPTURE_TRIGGER_RISING = 0x00,		/*!< der Wert erreicht Level von unten (vorher < Level <= jetzt) */
+	 CAPTURE_TRIGGER_FALLING = 0x01,	/*!< der Wert fällt unter Level (vorher >= Level > jetzt) */
+	 CAPTURE_TRIGGER_EQUAL = 0x02,		/*!< der Wert ist gleich Level (z.B. ein bestimmtes Zeichen) */
+	 CAPTURE_TRIGGER_BIT = 0x03,		/*!< Bit Level des Werts ändert sich (z.B. Pin Level des Ports) */
+	 CAPTURE_TRIGGER_MANUAL = 0x04		/*!< nur mit MYLIB_CAPTURE_Force() */
+ } CAPTURE_TriggerTypeDef;
+
+
+ /**
+   * @brief  CAPTURE Zustand der Aufzeichnung
+   */
+ typedef enum
+ {
+	 CAPTURE_STATE_IDLE = 0x00,			/*!< keine Aufzeichnung */
+	 CAPTURE_STATE_ARMED = 0x01,		/*!< der Ring läuft, es wird auf den Trigger gewartet */
+	 CAPTURE_STATE_TRIGGERED = 0x02,	/*!< Trigger erkannt, der Nachlauf wird aufgezeichnet */
+	 CAPTURE_STATE_UPLOAD = 0x03		/*!< Ring eingefroren, das Fenster wird hochgeladen */
+ } CAPTURE_StateTypeDef;
+
+
+ /**
+   * @brief  CAPTURE Konfiguration structures definition
+   */
+ typedef struct
+ {
+   TIM_TypeDef *Timer;                /*!< 32-Bit-Timer der Gerätezeit (TIM2), läuft bereits frei mit 1 MHz, Kanal 3 ist frei */
+
+   GPIO_TypeDef *Port;                /*!< Port der Quelle CAPTURE_SOURCE_GPIO */
+ }CAPTURE_InitTypeDef;
+
+
+ /**
+   * @brief  CAPTURE handle structures definition
+   */
+ typedef struct
+ {
+   CAPTURE_InitTypeDef Init;     /*!< Konfiguration */
+
+   uint16_t Ring[CAPTURE_SIZE];  /*!< Ring der letzten Werte */
+
+   uint16_t Head;                /*!< nächster Platz im Ring */
+
+   uint16_t Count;               /*!< Anzahl der Werte im Ring seit dem Scharfschalten (max. CAPTURE_SIZE) */
+
+   CAPTURE_SourceTypeDef Source; /*!< aufgezeichnete Quelle */
+
+   uint16_t Divider;             /*!< nur jeder Divider-te Wert der Quelle wird aufgezeichnet */
+
+   uint16_t DividerCount;        /*!< Werte der Quelle seit dem letzten aufgezeichneten */
+
+   CAPTURE_TriggerTypeDef Trigger; /*!< Triggerbedingung */
+
+   uint16_t Level;               /*!< Schwelle, Wert bzw. Bitnummer der Triggerbedingung */
+
+   uint16_t Pre;                 /*!< gewünschte Werte vor dem Trigger */
+
+   uint16_t Post;                /*!< Werte ab dem Trigger (der auslösende Wert ist der erste) */
+
+   uint16_t Previous;            /*!< letzter aufgezeichneter Wert, Bezug für Flanken */
+
+   uint16_t PostRemaining;       /*!< noch aufzuzeichnende Werte des Nachlaufs */
+
+   uint16_t PreCaptured;         /*!< tatsächliche Werte vor dem Trigger (weniger, wenn der Ring noch nicht voll war) */
+
+   uint32_t TriggerTime;         /*!< Gerätezeit des Triggers in µs */
+
+   uint16_t Start;               /*!< Platz des ersten Werts des eingefrorenen Fensters im Ring */
+
+   uint16_t Length;              /*!< Werte im eingefrorenen Fenster */
+
+   uint16_t Sent;                /*!< bereits hochgeladene Werte des Fensters */
+
+   uint8_t HeaderSent;           /*!< 1: die Kopfzeile des Fensters ist gesendet */
+
+   ENCODE_ModeTypeDef Encoding;  /*!< Format der hochgeladenen Zeilen */
+
+   volatile CAPTURE_StateTypeDef State; /*!< Zustand der Aufzeichnung */
+
+   SERIALPROTOCOL_TypeDef *hserialprot; /*!< Instanz, die die Aufzeichnung scharf geschaltet hat und das Fenster erhält */
+ }CAPTURE_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup CAPTURE_Exported_Functions CAPTURE Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_CAPTURE_Init(CAPTURE_TypeDef *hcapture);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_CAPTURE_Arm(CAPTURE_TypeDef *hcapture, uint16_t Pre, uint16_t Post);
+HAL_StatusTypeDef MYLIB_CAPTURE_Force(CAPTURE_TypeDef *hcapture);
+void MYLIB_CAPTURE_Stop(CAPTURE_TypeDef *hcapture);
+void MYLIB_CAPTURE_Add(CAPTURE_TypeDef *hcapture, CAPTURE_SourceTypeDef Source, uint16_t Value);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_CAPTURE_Command(CAPTURE_TypeDef *hcapture, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_CAPTURE_IRQHandler(CAPTURE_TypeDef *hcapture);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_CAPTURE_H_ */
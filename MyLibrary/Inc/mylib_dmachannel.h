@@ -0,0 +1,42 @@
+/**
+  ******************************************************************************
+  * @file    mylib_dmachannel.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_DMACHANNEL (Request-Auswahl und Flags eines registerbasiert betriebenen DMA-Kanals)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_DMACHANNEL_H_
+#define INC_MYLIB_DMACHANNEL_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "stm32l4xx_hal.h"
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup DMACHANNEL_Exported_Functions DMACHANNEL Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+void MYLIB_DMACHANNEL_SetRequest(DMA_Channel_TypeDef *Channel, uint32_t Request);
+
+/* IO operation functions *****************************************************/
+void MYLIB_DMACHANNEL_ClearFlags(DMA_Channel_TypeDef *Channel);
+uint32_t MYLIB_DMACHANNEL_GetFlags(DMA_Channel_TypeDef *Channel);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_DMACHANNEL_H_ */
@@ -0,0 +1,124 @@
+/**
+  ******************************************************************************
+  * @file    mylib_edgecapture.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_EDGECAPTURE (Flanken der EXTI-Eingänge mit Zeitstempel, Lesen der Ports)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_EDGECAPTURE_H_
+#define INC_MYLIB_EDGECAPTURE_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup EDGECAPTURE_Exported_Constants EDGECAPTURE Exported Constants
+   * @{
+   */
+#define EDGECAPTURE_RING_SIZE 64				/*!< Plätze des Ereignisrings (Zweierpotenz), ein Platz bleibt frei */
+#define EDGECAPTURE_MAX_INPUTS 8				/*!< maximale Anzahl Eingänge, Index 0..7 im Ereigniscode */
+#define EDGECAPTURE_DRAIN_MAX 8					/*!< maximale Anzahl Ereignisse je Antwort ("edg") */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup EDGECAPTURE_Exported_Types EDGECAPTURE Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  EDGECAPTURE Eingang structures definition
+   * @note   Die Tabelle wird als const angelegt und liegt damit im Flash. Jeder Pin braucht eine eigene
+   *         EXTI-Leitung, d.h. eine eigene Pin-Nummer (PA5 und PB5 teilen sich EXTI5)
+   */
+ typedef struct
+ {
+   const char *Name;             /*!< Name des Eingangs (nur zur Dokumentation, im Ereignis steht der Index) */
+
+   GPIO_TypeDef *Port;           /*!< GPIO-Port */
+
+   uint16_t Pin;                 /*!< GPIO-Pin (GPIO_PIN_x) */
+
+   uint32_t Pull;                /*!< GPIO_NOPULL, GPIO_PULLUP oder GPIO_PULLDOWN */
+ }EDGECAPTURE_InputTypeDef;
+
+
+ /**
+   * @brief  EDGECAPTURE Ereignis structures definition
+   */
+ typedef struct
+ {
+   uint32_t Cycles;              /*!< DWT-Zyklenzähler beim Eintritt in den EXTI-Interrupt */
+
+   uint8_t Input;                /*!< Index des Eingangs in der Tabelle */
+
+   uint8_t Level;                /*!< Pegel nach der Flanke: 1 = High (steigend), 0 = Low (fallend) */
+ }EDGECAPTURE_EventTypeDef;
+
+
+ /**
+   * @brief  EDGECAPTURE handle structures definition
+   * @note   Der Ring hat genau einen Schreiber (EXTI-Interrupt, Head) und einen Leser (Kommando, Tail),
+   *         beide ändern nur ihren eigenen Index und brauchen daher keine Sperre
+   */
+ typedef struct
+ {
+   const EDGECAPTURE_InputTypeDef *Table; /*!< konstante Tabelle der Eingänge */
+
+   uint8_t Count;                /*!< Anzahl der Eingänge */
+
+   uint32_t Lines;               /*!< Maske der belegten EXTI-Leitungen (Bit n = EXTI n) */
+
+   EDGECAPTURE_EventTypeDef Ring[EDGECAPTURE_RING_SIZE]; /*!< Ereignisring */
+
+   volatile uint16_t Head;       /*!< nächster freier Platz, nur vom Interrupt geschrieben */
+
+   volatile uint16_t Tail;       /*!< ältestes ungelesenes Ereignis, nur vom Leser geschrieben */
+
+   volatile uint32_t Overruns;   /*!< wegen vollem Ring verlorene Flanken */
+ }EDGECAPTURE_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup EDGECAPTURE_Exported_Functions EDGECAPTURE Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_EDGECAPTURE_Init(EDGECAPTURE_TypeDef *hedgecapture, const EDGECAPTURE_InputTypeDef *Table, uint8_t Count);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_EDGECAPTURE_Read(EDGECAPTURE_TypeDef *hedgecapture, EDGECAPTURE_EventTypeDef *Event);
+uint16_t MYLIB_EDGECAPTURE_Pending(EDGECAPTURE_TypeDef *hedgecapture);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_EDGECAPTURE_Command(EDGECAPTURE_TypeDef *hedgecapture, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_EDGECAPTURE_IRQHandler(EDGECAPTURE_TypeDef *hedgecapture);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_EDGECAPTURE_H_ */
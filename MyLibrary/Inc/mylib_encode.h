@@ -0,0 +1,97 @@
+/**
+  ******************************************************************************
+  * @file    mylib_encode.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_ENCODE (kompakte Kodierung von Messwerten: Zig-Zag-Delta, Varint, LZ, Base64)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_ENCODE_H_
+#define INC_MYLIB_ENCODE_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "stm32l4xx_hal.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup ENCODE_Exported_Constants ENCODE Exported Constants
+   * @{
+   */
+#define ENCODE_BYTES_MAX 96						/*!< maximale Anzahl Varint-Bytes je Zeile (< 255, Positionen der LZ-Stufe sind 8 Bit) */
+#define ENCODE_FIELDS_MAX 2						/*!< maximale Anzahl verschränkter Felder mit eigener Differenzbildung */
+#define ENCODE_LZ_MATCH_MIN 3					/*!< kürzeste Wiederholung, die die LZ-Stufe als Verweis kodiert */
+#define ENCODE_LZ_MATCH_MAX (ENCODE_LZ_MATCH_MIN + 127) /*!< längste Wiederholung je Verweis */
+#define ENCODE_LZ_LITERAL_MAX 128				/*!< längste Folge unveränderter Bytes je Literal-Token */
+#define ENCODE_LZ_BYTES_MAX (ENCODE_BYTES_MAX + (ENCODE_BYTES_MAX + ENCODE_LZ_LITERAL_MAX - 1) / ENCODE_LZ_LITERAL_MAX) /*!< Länge nach der LZ-Stufe im ungünstigsten Fall */
+#define ENCODE_TEXT_MAX (((ENCODE_LZ_BYTES_MAX + 2) / 3) * 4 + 1) /*!< Länge des Base64-Texts im ungünstigsten Fall, mit Nullterminierung */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup ENCODE_Exported_Types ENCODE Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  ENCODE Kodierung eines Streams
+   */
+ typedef enum
+ {
+	 ENCODE_MODE_HEX = 0x00,			/*!< feste Hex-Stellen je Wert (bisheriges Format, nicht in diesem Modul) */
+	 ENCODE_MODE_DELTA = 0x01,			/*!< Zig-Zag-Differenz zum Vorgänger als Varint, Base64 */
+	 ENCODE_MODE_DELTA_LZ = 0x02		/*!< wie ENCODE_MODE_DELTA, danach LZ-Stufe über die Varint-Bytes */
+ } ENCODE_ModeTypeDef;
+
+
+ /**
+   * @brief  ENCODE handle structures definition, eine Zeile, wird je Zeile mit MYLIB_ENCODE_Begin() neu begonnen
+   */
+ typedef struct
+ {
+   ENCODE_ModeTypeDef Mode;      /*!< Kodierung der Zeile */
+
+   uint8_t Bytes[ENCODE_BYTES_MAX]; /*!< Varint-Bytes der Zeile */
+
+   uint16_t Length;              /*!< Anzahl der Bytes in Bytes */
+
+   int32_t Previous[ENCODE_FIELDS_MAX]; /*!< letzter Wert je Feld, Bezug der nächsten Differenz */
+
+   uint8_t Fields;               /*!< Anzahl der Felder, die Werte gehören der Reihe nach zu Feld 0, 1, .. 0, 1, .. */
+
+   uint8_t Field;                /*!< Feld des nächsten Werts */
+ }ENCODE_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup ENCODE_Exported_Functions ENCODE Exported Functions
+   * @{
+   */
+
+/* IO operation functions *****************************************************/
+void MYLIB_ENCODE_Begin(ENCODE_TypeDef *hencode, ENCODE_ModeTypeDef Mode, uint8_t Fields);
+HAL_StatusTypeDef MYLIB_ENCODE_Put(ENCODE_TypeDef *hencode, int32_t Value);
+uint16_t MYLIB_ENCODE_End(ENCODE_TypeDef *hencode, char *Text);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_ENCODE_H_ */
@@ -0,0 +1,141 @@
+/**
+  ******************************************************************************
+  * @file    mylib_freqmeter.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_FREQMETER (Frequenz und Pulsbreite per Input Capture und DMA)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_FREQMETER_H_
+#define INC_MYLIB_FREQMETER_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup FREQMETER_Exported_Constants FREQMETER Exported Constants
+   * @{
+   */
+#define FREQMETER_PERIODS_MAX 128				/*!< maximale Anzahl Perioden je Messung */
+#define FREQMETER_COUNTER_CLOCK 1000000U		/*!< Zähltakt des Timers in Hz (Gerätezeit des Schedulers, 1 µs je Zählschritt) */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup FREQMETER_Exported_Types FREQMETER Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  FREQMETER Konfiguration structures definition
+   */
+ typedef struct
+ {
+   TIM_TypeDef *Timer;                /*!< 32-Bit-Timer (TIM2), läuft bereits frei mit FREQMETER_COUNTER_CLOCK, Eingang an Kanal 1 */
+
+   DMA_Channel_TypeDef *Channel;      /*!< DMA-Kanal mit dem CC1-Request des Timers */
+
+   uint32_t DmaRequest;               /*!< DMA-Request des Timers auf dem Kanal (CSELR) */
+ }FREQMETER_InitTypeDef;
+
+
+ /**
+   * @brief  FREQMETER Aufzeichnung structures definition
+   * @note   Die DMA schreibt je steigender Flanke beide Capture-Register (Burst über DMAR)
+   */
+ typedef struct
+ {
+   uint32_t Rising;              /*!< Zeitpunkt dieser steigenden Flanke (CCR1) */
+
+   uint32_t Falling;             /*!< Zeitpunkt der letzten fallenden Flanke davor (CCR2) */
+ }FREQMETER_CaptureTypeDef;
+
+
+ /**
+   * @brief  FREQMETER Ergebnis structures definition, alle Zeiten in µs, Mittelwerte in ns
+   */
+ typedef struct
+ {
+   uint16_t Periods;             /*!< Anzahl ausgewerteter Perioden */
+
+   uint32_t PeriodMin;           /*!< kürzeste Periode */
+
+   uint32_t PeriodMax;           /*!< längste Periode */
+
+   uint64_t PeriodMeanNs;        /*!< mittlere Periode in ns (64 Bit, Perioden bis 71 Minuten) */
+
+   uint32_t HighMin;             /*!< kürzeste High-Zeit */
+
+   uint32_t HighMax;             /*!< längste High-Zeit */
+
+   uint64_t HighMeanNs;          /*!< mittlere High-Zeit in ns (64 Bit, wie PeriodMeanNs) */
+
+   uint32_t FrequencyMilliHz;    /*!< mittlere Frequenz in mHz */
+
+   uint16_t DutyPermille;        /*!< Tastgrad in Promille */
+ }FREQMETER_ResultTypeDef;
+
+
+ /**
+   * @brief  FREQMETER handle structures definition
+   */
+ typedef struct
+ {
+   FREQMETER_InitTypeDef Init;   /*!< Konfiguration */
+
+   FREQMETER_CaptureTypeDef Capture[FREQMETER_PERIODS_MAX + 1]; /*!< Zeitstempel, n Perioden brauchen n + 1 steigende Flanken */
+
+   uint16_t Periods;             /*!< angeforderte Anzahl Perioden der laufenden bzw. letzten Messung */
+
+   volatile uint8_t Running;     /*!< 1: die DMA nimmt Flanken auf */
+
+   SERIALPROTOCOL_TypeDef *hserialprot; /*!< Instanz, die die Messung gestartet hat und das Ende gemeldet bekommt */
+ }FREQMETER_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup FREQMETER_Exported_Functions FREQMETER Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_FREQMETER_Init(FREQMETER_TypeDef *hfreqmeter);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_FREQMETER_Start(FREQMETER_TypeDef *hfreqmeter, uint16_t Periods);
+void MYLIB_FREQMETER_Stop(FREQMETER_TypeDef *hfreqmeter);
+HAL_StatusTypeDef MYLIB_FREQMETER_Evaluate(FREQMETER_TypeDef *hfreqmeter, FREQMETER_ResultTypeDef *Result);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_FREQMETER_Command(FREQMETER_TypeDef *hfreqmeter, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_FREQMETER_DMA_IRQHandler(FREQMETER_TypeDef *hfreqmeter);
+
+/* Callback functions  ********************************************************/
+void FREQMETER_Period_Callback(FREQMETER_TypeDef *hfreqmeter, uint32_t Period, uint32_t High);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_FREQMETER_H_ */
@@ -0,0 +1,98 @@
+/**
+  ******************************************************************************
+  * @file    mylib_gpiotable.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_GPIOTABLE (GPIOs über eine konstante Pin-Tabelle)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_GPIOTABLE_H_
+#define INC_MYLIB_GPIOTABLE_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup GPIOTABLE_Exported_Constants GPIOTABLE Exported Constants
+   * @{
+   */
+#define GPIOTABLE_MAX_PINS 16					/*!< maximale Anzahl der Einträge einer Pin-Tabelle */
+#define GPIOTABLE_HASH_SIZE 32					/*!< Plätze der Hash-Tabelle (Zweierpotenz, mind. doppelt so viele wie Pins) */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup GPIOTABLE_Exported_Types GPIOTABLE Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  GPIOTABLE Pin-Beschreibung structures definition
+   * @note   Die Tabelle wird als const angelegt und liegt damit im Flash
+   */
+ typedef struct
+ {
+   const char *Name;             /*!< Name des Pins im Kommando "gpo" (max. 4 Kleinbuchstaben, z.B. "rt") */
+
+   GPIO_TypeDef *Port;           /*!< GPIO-Port */
+
+   uint16_t Pin;                 /*!< GPIO-Pin (GPIO_PIN_x) */
+
+   GPIO_PinState ActiveLevel;    /*!< Pegel für "on": GPIO_PIN_SET (aktiv High) oder GPIO_PIN_RESET (aktiv Low) */
+
+   uint32_t Mode;                /*!< GPIO_MODE_OUTPUT_PP, GPIO_MODE_OUTPUT_OD oder GPIO_MODE_INPUT (nicht schaltbar) */
+
+   uint32_t Pull;                /*!< GPIO_NOPULL, GPIO_PULLUP oder GPIO_PULLDOWN */
+ }GPIOTABLE_DescriptorTypeDef;
+
+
+ /**
+   * @brief  GPIOTABLE handle structures definition
+   */
+ typedef struct
+ {
+   const GPIOTABLE_DescriptorTypeDef *Table; /*!< Pin-Tabelle */
+
+   uint8_t Count;                /*!< Anzahl der Einträge */
+
+   uint8_t Index[GPIOTABLE_HASH_SIZE]; /*!< Hash-Tabelle Name -> Eintrag + 1 (0 = frei), bei der Initialisierung berechnet */
+ }GPIOTABLE_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup GPIOTABLE_Exported_Functions GPIOTABLE Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_GPIOTABLE_Init(GPIOTABLE_TypeDef *hgpiotable, const GPIOTABLE_DescriptorTypeDef *Table, uint8_t Count);
+
+/* IO operation functions *****************************************************/
+const GPIOTABLE_DescriptorTypeDef * MYLIB_GPIOTABLE_Find(GPIOTABLE_TypeDef *hgpiotable, const char *Name);
+HAL_StatusTypeDef MYLIB_GPIOTABLE_Write(const GPIOTABLE_DescriptorTypeDef *Descriptor, uint8_t On);
+uint8_t MYLIB_GPIOTABLE_Command(GPIOTABLE_TypeDef *hgpiotable, SERIALPROTOCOL_TypeDef *hserialprot);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_GPIOTABLE_H_ */
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    mylib_i2cbridge.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_I2CBRIDGE (I2C-Master mit Warteschlange für Protokoll-Kommandos)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_I2CBRIDGE_H_
+#define INC_MYLIB_I2CBRIDGE_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup I2CBRIDGE_Exported_Constants I2CBRIDGE Exported Constants
+   * @{
+   */
+#define I2CBRIDGE_QUEUE_SIZE 8					/*!< maximale Anzahl wartender Übertragungen */
+#define I2CBRIDGE_DATA_SIZE 16					/*!< maximale Anzahl Datenbytes je Übertragung */
+#define I2CBRIDGE_TIMEOUT_MS 25					/*!< SCL länger Low als diese Zeit: Übertragung abbrechen (Clock-Stretching, hängender Bus) */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup I2CBRIDGE_Exported_Types I2CBRIDGE Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  I2CBRIDGE Übertragung structures definition
+   */
+ typedef struct
+ {
+   uint8_t Id;                   /*!< Kennung, wird mit dem ACK und mit dem Ergebnis gemeldet */
+
+   uint8_t Address;              /*!< 7-Bit-Adresse des Slaves */
+
+   uint8_t Read;                 /*!< 1: Register lesen, 0: Register schreiben */
+
+   uint8_t Length;               /*!< Anzahl der Datenbytes */
+
+   uint8_t Data[I2CBRIDGE_DATA_SIZE + 1]; /*!< Registeradresse gefolgt von den Datenbytes */
+
+   SERIALPROTOCOL_TypeDef *hserialprot; /*!< Instanz, an die das Ergebnis gemeldet wird */
+ }I2CBRIDGE_TransactionTypeDef;
+
+
+ /**
+   * @brief  I2CBRIDGE handle structures definition
+   */
+ typedef struct
+ {
+   I2C_HandleTypeDef *hi2c;      /*!< verwendeter I2C im Master-Betrieb */
+
+   I2CBRIDGE_TransactionTypeDef Queue[I2CBRIDGE_QUEUE_SIZE]; /*!< Warteschlange der Übertragungen */
+
+   uint8_t QueueHead;            /*!< nächster freier Platz der Warteschlange */
+
+   uint8_t QueueTail;            /*!< laufende bzw. nächste Übertragung */
+
+   uint8_t QueueCount;           /*!< Anzahl der Übertragungen in der Warteschlange */
+
+   volatile uint8_t Busy;        /*!< 1: die Übertragung an QueueTail läuft */
+
+   uint8_t Phase;                /*!< Lesen: 0 = Registeradresse wird gesendet, 1 = Daten werden empfangen */
+
+   uint8_t NextId;               /*!< Kennung der nächsten Übertragung */
+
+   uint8_t Address;              /*!< mit "isl" gewählte Slave-Adresse */
+
+   uint8_t Burst[I2CBRIDGE_DATA_SIZE]; /*!< mit "ibf" gesammelte Datenbytes für "ibw" */
+
+   uint8_t BurstLength;          /*!< Anzahl der gesammelten Datenbytes */
+
+   uint32_t Completed;           /*!< Anzahl der erfolgreichen Übertragungen */
+
+   uint32_t Failed;              /*!< Anzahl der fehlgeschlagenen Übertragungen (NACK, Busfehler, Timeout) */
+ }I2CBRIDGE_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup I2CBRIDGE_Exported_Functions I2CBRIDGE Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_I2CBRIDGE_Init(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_I2CBRIDGE_Command(I2CBRIDGE_TypeDef *hbridge, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler and callback functions  ****************************************/
+void MYLIB_I2CBRIDGE_ER_IRQHandler(I2CBRIDGE_TypeDef *hbridge);
+void MYLIB_I2CBRIDGE_MasterTxCpltCallback(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c);
+void MYLIB_I2CBRIDGE_MasterRxCpltCallback(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c);
+void MYLIB_I2CBRIDGE_ErrorCallback(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_I2CBRIDGE_H_ */
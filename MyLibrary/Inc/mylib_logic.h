@@ -0,0 +1,164 @@
+/**
+  ******************************************************************************
+  * @file    mylib_logic.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_LOGIC (Logikanalysator: GPIO-Abtastung per Timer und DMA, lauflängenkodiert)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_LOGIC_H_
+#define INC_MYLIB_LOGIC_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+#include "mylib_encode.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup LOGIC_Exported_Constants LOGIC Exported Constants
+   * @{
+   */
+#define LOGIC_BUFFER_SIZE 256					/*!< Abtastwerte des zirkulären DMA-Puffers, je Hälfte wird kodiert */
+#define LOGIC_PRE_RUNS 32						/*!< Läufe vor dem Trigger, die aufbewahrt und nach dem Trigger gesendet werden */
+#define LOGIC_LINE_RUNS 8						/*!< Läufe je gesendeter Zeile */
+#define LOGIC_COUNTER_CLOCK 1000000U			/*!< Zähltakt des Timers in Hz, die Abtastperiode wird in µs angegeben */
+#define LOGIC_PERIOD_MIN_US 20					/*!< kürzeste Abtastperiode (Kodierung einer Pufferhälfte bei 4 MHz) */
+#define LOGIC_PERIOD_MAX_US SERIALPROT_PARAM_MAX	/*!< längste Abtastperiode */
+#define LOGIC_RUN_MAX 0xFFFFU					/*!< längster Lauf, längere gleiche Pegel werden auf mehrere Läufe verteilt */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup LOGIC_Exported_Types LOGIC Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  LOGIC Zustand definition
+   */
+ typedef enum
+ {
+	 LOGIC_STATE_IDLE = 0x00,			/*!< keine Aufzeichnung */
+	 LOGIC_STATE_ARMED = 0x01,			/*!< Abtastung läuft, die Läufe füllen den Vortrigger-Ring */
+	 LOGIC_STATE_TRIGGERED = 0x02		/*!< Trigger erkannt, die Läufe werden gesendet */
+ } LOGIC_StateTypeDef;
+
+
+ /**
+   * @brief  LOGIC Triggerflanke definition
+   */
+ typedef enum
+ {
+	 LOGIC_EDGE_FALLING = 0x00,			/*!< fallende Flanke am Triggerpin */
+	 LOGIC_EDGE_RISING = 0x01,			/*!< steigende Flanke am Triggerpin */
+	 LOGIC_EDGE_BOTH = 0x02,			/*!< jede Flanke am Triggerpin */
+	 LOGIC_EDGE_NONE = 0x03				/*!< ohne Trigger, die Aufzeichnung beginnt sofort */
+ } LOGIC_EdgeTypeDef;
+
+
+ /**
+   * @brief  LOGIC Konfiguration structures definition
+   */
+ typedef struct
+ {
+   TIM_TypeDef *Timer;                /*!< Basis-Timer TIM6 oder TIM7 (Takt PCLK1), sein Update-Ereignis löst je Abtastung eine DMA-Übertragung aus */
+
+   DMA_Channel_TypeDef *Channel;      /*!< DMA-Kanal mit dem Update-Request des Timers */
+
+   uint32_t DmaRequest;               /*!< DMA-Request des Timers auf dem Kanal (CSELR) */
+
+   GPIO_TypeDef *Port;                /*!< abgetasteter Port (IDR) */
+ }LOGIC_InitTypeDef;
+
+
+ /**
+   * @brief  LOGIC Lauf structures definition
+   */
+ typedef struct
+ {
+   uint16_t Value;               /*!< Pegel der Kanäle (IDR & Mask) */
+
+   uint16_t Length;              /*!< Anzahl gleicher Abtastwerte, 0 = kein Lauf */
+ }LOGIC_RunTypeDef;
+
+
+ /**
+   * @brief  LOGIC handle structures definition
+   */
+ typedef struct
+ {
+   LOGIC_InitTypeDef Init;       /*!< Konfiguration */
+
+   uint16_t Buffer[LOGIC_BUFFER_SIZE]; /*!< zirkulärer DMA-Puffer der Abtastwerte */
+
+   uint16_t Mask;                /*!< aufgezeichnete Kanäle, Bit n = Pin n des Ports */
+
+   uint16_t TriggerPin;          /*!< Pin des Triggers (GPIO_PIN_x) */
+
+   LOGIC_EdgeTypeDef TriggerEdge; /*!< Flanke des Triggers */
+
+   ENCODE_ModeTypeDef Encoding;  /*!< Format der gesendeten Läufe */
+
+   volatile LOGIC_StateTypeDef State; /*!< Zustand der Aufzeichnung */
+
+   uint32_t PostRemaining;       /*!< noch aufzuzeichnende Abtastwerte nach dem Trigger */
+
+   LOGIC_RunTypeDef Run;         /*!< laufender, noch nicht abgeschlossener Lauf */
+
+   LOGIC_RunTypeDef Pre[LOGIC_PRE_RUNS]; /*!< Ring der letzten Läufe vor dem Trigger */
+
+   uint8_t PreHead;              /*!< nächster Platz im Vortrigger-Ring */
+
+   uint8_t PreCount;             /*!< Anzahl der Läufe im Vortrigger-Ring */
+
+   LOGIC_RunTypeDef Line[LOGIC_LINE_RUNS]; /*!< Läufe der nächsten zu sendenden Zeile */
+
+   uint8_t LineCount;            /*!< Anzahl der Läufe in Line */
+
+   uint32_t RunsSent;            /*!< Anzahl der gesendeten Läufe der laufenden bzw. letzten Aufzeichnung */
+
+   SERIALPROTOCOL_TypeDef *hserialprot; /*!< Instanz, die die Aufzeichnung gestartet hat und sie empfängt */
+ }LOGIC_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup LOGIC_Exported_Functions LOGIC Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_LOGIC_Init(LOGIC_TypeDef *hlogic);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_LOGIC_Start(LOGIC_TypeDef *hlogic, uint16_t PeriodUs, uint32_t PostSamples);
+void MYLIB_LOGIC_Stop(LOGIC_TypeDef *hlogic);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_LOGIC_Command(LOGIC_TypeDef *hlogic, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_LOGIC_DMA_IRQHandler(LOGIC_TypeDef *hlogic);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_LOGIC_H_ */
@@ -0,0 +1,122 @@
+/**
+  ******************************************************************************
+  * @file    mylib_macro.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_MACRO (benannte Kommandofolgen in einer Flash-Seite)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_MACRO_H_
+#define INC_MYLIB_MACRO_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup MACRO_Exported_Constants MACRO Exported Constants
+   * @{
+   */
+#define MACRO_MAGIC 0x4D41434FU					/*!< Kennung einer gültigen Seite ("MACO") */
+#define MACRO_HEADER_SIZE 8						/*!< Kennung, Länge und Prüfsumme vor dem Text */
+#define MACRO_TEXT_SIZE (FLASH_PAGE_SIZE - MACRO_HEADER_SIZE) /*!< Zeichen aller Makros zusammen, mit Nullterminierung */
+#define MACRO_NAME_MAX SERIALPROT_PARAM_SIZE	/*!< längster Name (ein Parameter des Protokolls) */
+#define MACRO_BOOT "boot"						/*!< Makro, das MYLIB_MACRO_Boot() nach dem Reset ausführt */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup MACRO_Exported_Types MACRO Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  MACRO Inhalt der Flash-Seite, im RAM bearbeitet und als Ganzes gespeichert
+   *         Text: je Makro "<name>:" gefolgt von den Zeilen "#...\r" und einem '\n'
+   */
+ typedef struct
+ {
+   uint32_t Magic;               /*!< MACRO_MAGIC, sonst ist die Seite leer bzw. ungültig */
+
+   uint16_t Length;              /*!< Zeichen im Text ohne Nullterminierung */
+
+   uint16_t Checksum;            /*!< Summe der Zeichen des Texts (unvollständig geschriebene Seite erkennen) */
+
+   char Text[MACRO_TEXT_SIZE];   /*!< alle Makros, nullterminiert */
+ }MACRO_StoreTypeDef;
+
+
+ /**
+   * @brief  MACRO Konfiguration structures definition
+   */
+ typedef struct
+ {
+   uint32_t Page;                     /*!< Nummer der für die Makros reservierten Flash-Seite (im Linker-Skript ausgenommen) */
+ }MACRO_InitTypeDef;
+
+
+ /**
+   * @brief  MACRO handle structures definition
+   */
+ typedef struct
+ {
+   MACRO_InitTypeDef Init;       /*!< Konfiguration */
+
+   MACRO_StoreTypeDef Store;     /*!< Arbeitskopie der Flash-Seite */
+
+   uint8_t Modified;             /*!< 1: die Arbeitskopie weicht von der Flash-Seite ab */
+
+   uint16_t RecordStart;         /*!< Beginn des aufgezeichneten Makros im Text */
+
+   uint16_t RecordLines;         /*!< bisher aufgezeichnete Zeilen */
+
+   uint8_t RecordFull;           /*!< 1: mindestens eine Zeile passte nicht mehr in den Text */
+
+   uint8_t RecordRejected;       /*!< Zeilen, die nicht aufgezeichnet wurden, weil ihr Kommando später Meldungen sendet */
+
+   SERIALPROTOCOL_TypeDef *hrecord; /*!< Instanz, deren Zeilen aufgezeichnet werden, NULL = keine Aufzeichnung */
+
+   SERIALPROTOCOL_TypeDef Engine; /*!< eigene Instanz des Protokolls ohne Transportschicht für die Zeilen der Makros */
+ }MACRO_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup MACRO_Exported_Functions MACRO Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_MACRO_Init(MACRO_TypeDef *hmacro);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_MACRO_Run(MACRO_TypeDef *hmacro, const char * Name, uint16_t * Executed, uint16_t * Lines);
+HAL_StatusTypeDef MYLIB_MACRO_Boot(MACRO_TypeDef *hmacro);
+HAL_StatusTypeDef MYLIB_MACRO_Save(MACRO_TypeDef *hmacro);
+void MYLIB_MACRO_RxByte(MACRO_TypeDef *hmacro, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Byte);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_MACRO_Command(MACRO_TypeDef *hmacro, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_MACRO_H_ */
@@ -0,0 +1,127 @@
+/**
+  ******************************************************************************
+  * @file    mylib_modbus.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_MODBUS (Modbus-RTU-Slave über die Kommandos des seriellen Protokolls)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_MODBUS_H_
+#define INC_MYLIB_MODBUS_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup MODBUS_Exported_Constants MODBUS Exported Constants
+   * @{
+   */
+#define MODBUS_FRAME_SIZE 256					/*!< maximale Länge eines RTU-Rahmens (Adresse, PDU, CRC) */
+#define MODBUS_COIL_COUNT 3						/*!< Coils 0..2: rote, grüne, blaue LED ("gpo") */
+
+#define MODBUS_PARAM_MAX SERIALPROT_PARAM_MAX	/*!< größter Wert der Parameter-Register */
+
+#define MODBUS_REG_PARAM1 0						/*!< Holding-Register: Parameter 1 der Kommandos (lesen/schreiben) */
+#define MODBUS_REG_PARAM2 1						/*!< Holding-Register: Parameter 2 der Kommandos (lesen/schreiben) */
+#define MODBUS_REG_RDM 2						/*!< Holding-Register: Ergebnis "#rdm,P1:P2" (nur lesen) */
+#define MODBUS_REG_ADD 3						/*!< Holding-Register: Ergebnis "#add,P1:P2" (nur lesen) */
+#define MODBUS_REG_ASC 4						/*!< Holding-Register: Ergebnis "#asc,<Zeichen P1>:0" (nur lesen) */
+#define MODBUS_REG_STATUS 5						/*!< Holding-Register: NACK der letzten Auswertung, Bit 0 rdm, Bit 1 add, Bit 2 asc (nur lesen) */
+#define MODBUS_REGISTER_COUNT 6					/*!< Anzahl der Holding-Register */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup MODBUS_Exported_Types MODBUS Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  MODBUS Statistik structures definition
+   */
+ typedef struct
+ {
+   uint32_t FramesReceived;      /*!< Anzahl der an diesen Slave (oder Broadcast) gerichteten, gültigen Rahmen */
+
+   uint32_t FramesIgnored;       /*!< Anzahl der gültigen Rahmen für andere Slaves */
+
+   uint32_t CrcErrors;           /*!< Anzahl der Rahmen mit falscher CRC oder zu kurz */
+
+   uint32_t Overflows;           /*!< Anzahl der Rahmen länger als MODBUS_FRAME_SIZE */
+
+   uint32_t Exceptions;          /*!< Anzahl der mit einer Ausnahme beantworteten Anfragen */
+
+   uint32_t UartErrors;          /*!< Anzahl der wegen ORE/FE/NE/PE verworfenen Rahmen */
+
+   uint32_t TxErrors;            /*!< Anzahl der verworfenen Anfragen, weil die letzte Antwort noch gesendet wurde */
+ }MODBUS_StatisticsTypeDef;
+
+
+ /**
+   * @brief  MODBUS handle structures definition
+   */
+ typedef struct
+ {
+   UART_HandleTypeDef *huart;    /*!< verwendeter UART, hdmarx (zirkulär) und hdmatx müssen verknüpft sein */
+
+   uint8_t SlaveAddress;         /*!< eigene Slave-Adresse 1..247 */
+
+   uint32_t FrameTimeout;        /*!< Rahmenende nach dieser Pause in Bitzeiten (3,5 Zeichen bzw. 1,75 ms) */
+
+   SERIALPROTOCOL_TypeDef Engine; /*!< eigene Instanz des seriellen Protokolls (ohne Transportschicht) für die Kommandos */
+
+   uint8_t Coils;                /*!< zuletzt geschriebener Zustand der Coils, Bit n = Coil n */
+
+   uint16_t Param[2];            /*!< Holding-Register MODBUS_REG_PARAM1 und MODBUS_REG_PARAM2 */
+
+   uint16_t Status;              /*!< Holding-Register MODBUS_REG_STATUS */
+
+   volatile uint8_t Overflow;    /*!< 1: der Empfangspuffer ist im laufenden Rahmen übergelaufen */
+
+   uint8_t RxFrame[MODBUS_FRAME_SIZE]; /*!< Empfangspuffer der DMA, je Rahmen ab Index 0 */
+
+   uint8_t TxFrame[MODBUS_FRAME_SIZE]; /*!< Antwortrahmen, wird per DMA gesendet */
+
+   MODBUS_StatisticsTypeDef Statistics; /*!< Statistikzähler des Slaves */
+ }MODBUS_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup MODBUS_Exported_Functions MODBUS Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_MODBUS_Init(MODBUS_TypeDef *hmodbus, UART_HandleTypeDef *huart, uint8_t SlaveAddress);
+
+/* Frame functions  ***********************************************************/
+uint16_t MYLIB_MODBUS_CRC16(const uint8_t *pData, uint16_t Size);
+
+/* Callback functions  ********************************************************/
+void MYLIB_MODBUS_RxCpltCallback(MODBUS_TypeDef *hmodbus, UART_HandleTypeDef *huart);
+void MYLIB_MODBUS_ErrorCallback(MODBUS_TypeDef *hmodbus, UART_HandleTypeDef *huart);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_MODBUS_H_ */
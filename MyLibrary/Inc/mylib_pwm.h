@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file    mylib_pwm.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_PWM (Helligkeit der LEDs per Hardware-PWM)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_PWM_H_
+#define INC_MYLIB_PWM_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup PWM_Exported_Constants PWM Exported Constants
+   * @{
+   */
+#define PWM_MAX_CHANNELS 4						/*!< maximale Anzahl der Kanäle einer Kanal-Tabelle */
+#define PWM_COUNTER_CLOCK 1000000U				/*!< Zähltakt der Timer in Hz */
+#define PWM_DUTY_MAX 1000						/*!< Tastgrad in Promille, zugleich Periode in Zähltakten (1 kHz) */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup PWM_Exported_Types PWM Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  PWM Kanal-Beschreibung structures definition
+   * @note   Jeder Kanal verwendet einen eigenen Timer: TIMx (HAL, Kanal Channel) oder LPTIMx (Register, Ausgang OUT)
+   */
+ typedef struct
+ {
+   const char *Name;             /*!< Name des Kanals im Kommando "pwm" (wie in der Pin-Tabelle, z.B. "rt") */
+
+   GPIO_TypeDef *Port;           /*!< GPIO-Port des Ausgangs */
+
+   uint16_t Pin;                 /*!< GPIO-Pin des Ausgangs (GPIO_PIN_x) */
+
+   uint8_t Alternate;            /*!< Alternate Function des Timer-Ausgangs am Pin (z.B. GPIO_AF1_TIM1) */
+
+   void *Instance;               /*!< TIM_TypeDef oder LPTIM_TypeDef */
+
+   uint32_t Channel;             /*!< TIM_CHANNEL_x (bei LPTIM ohne Bedeutung) */
+
+   GPIO_PinState ActiveLevel;    /*!< Pegel, bei dem die LED leuchtet */
+ }PWM_ChannelTypeDef;
+
+
+ /**
+   * @brief  PWM handle structures definition
+   */
+ typedef struct
+ {
+   const PWM_ChannelTypeDef *Table; /*!< Kanal-Tabelle */
+
+   uint8_t Count;                /*!< Anzahl der Kanäle */
+
+   TIM_HandleTypeDef htim[PWM_MAX_CHANNELS]; /*!< HAL-Handles der TIM-Kanäle */
+
+   uint16_t Duty[PWM_MAX_CHANNELS]; /*!< eingestellter Tastgrad je Kanal in Promille */
+
+   uint8_t Running;              /*!< Bit n = Pin von Kanal n wird vom Timer getrieben */
+ }PWM_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup PWM_Exported_Functions PWM Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_PWM_Init(PWM_TypeDef *hpwm, const PWM_ChannelTypeDef *Table, uint8_t Count);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_PWM_SetDuty(PWM_TypeDef *hpwm, uint8_t Channel, uint16_t Duty);
+void MYLIB_PWM_ReleasePins(PWM_TypeDef *hpwm, GPIO_TypeDef *Port, uint16_t Pins);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_PWM_Command(PWM_TypeDef *hpwm, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_PWM_H_ */
@@ -0,0 +1,107 @@
+/**
+  ******************************************************************************
+  * @file    mylib_scheduler.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SCHEDULER (GPIO-Aktionen zu absoluten Zeitpunkten der Gerätezeit)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SCHEDULER_H_
+#define INC_MYLIB_SCHEDULER_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+#include "mylib_gpiotable.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SCHEDULER_Exported_Constants SCHEDULER Exported Constants
+   * @{
+   */
+#define SCHEDULER_QUEUE_SIZE 16					/*!< maximale Anzahl wartender Aktionen */
+#define SCHEDULER_COUNTER_CLOCK 1000000U		/*!< Takt der Gerätezeit in Hz (1 µs je Zählschritt) */
+#define SCHEDULER_LEAD_MIN_US 20				/*!< Mindestabstand einer neuen Aktion zur aktuellen Gerätezeit */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SCHEDULER_Exported_Types SCHEDULER Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SCHEDULER Aktion structures definition
+   */
+ typedef struct
+ {
+   uint32_t Time;                /*!< Zeitpunkt der Aktion in µs Gerätezeit */
+
+   GPIO_TypeDef *Port;           /*!< Port des Pins */
+
+   uint32_t Bsrr;                /*!< in BSRR zu schreibender Wert (Pin setzen bzw. rücksetzen) */
+ }SCHEDULER_ActionTypeDef;
+
+
+ /**
+   * @brief  SCHEDULER handle structures definition
+   */
+ typedef struct
+ {
+   TIM_TypeDef *Timer;           /*!< 32-Bit-Timer der Gerätezeit (TIM2, Takt PCLK1), Kanal 4 vergleicht mit der nächsten Aktion */
+
+   GPIOTABLE_TypeDef *hgpiotable; /*!< Pin-Tabelle, aus der die Namen der Kommandos aufgelöst werden */
+
+   SCHEDULER_ActionTypeDef Queue[SCHEDULER_QUEUE_SIZE]; /*!< Warteschlange, nach Zeitpunkt sortiert, Index 0 ist die nächste Aktion */
+
+   volatile uint8_t Count;       /*!< Anzahl der wartenden Aktionen */
+
+   uint32_t TimeHigh;            /*!< mit "tsh" gesetzter oberer Teil des nächsten Zeitpunkts (hoch * 10^8 + mitte * 10^4) */
+
+   uint32_t Fired;               /*!< Anzahl der ausgeführten Aktionen */
+
+   uint32_t MaxLate;             /*!< größte Verspätung einer Aktion in µs (Interrupt-Latenz) */
+ }SCHEDULER_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SCHEDULER_Exported_Functions SCHEDULER Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_SCHEDULER_Init(SCHEDULER_TypeDef *hscheduler, TIM_TypeDef *Timer, GPIOTABLE_TypeDef *hgpiotable);
+
+/* IO operation functions *****************************************************/
+uint32_t MYLIB_SCHEDULER_GetTime(SCHEDULER_TypeDef *hscheduler);
+HAL_StatusTypeDef MYLIB_SCHEDULER_Add(SCHEDULER_TypeDef *hscheduler, uint32_t Time, const GPIOTABLE_DescriptorTypeDef *Descriptor, uint8_t On);
+uint8_t MYLIB_SCHEDULER_Clear(SCHEDULER_TypeDef *hscheduler);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_SCHEDULER_Command(SCHEDULER_TypeDef *hscheduler, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_SCHEDULER_IRQHandler(SCHEDULER_TypeDef *hscheduler);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SCHEDULER_H_ */
@@ -0,0 +1,176 @@
+/**
+  ******************************************************************************
+  * @file    mylib_script.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SCRIPT (Bytecode-Interpreter für Kommandofolgen am Gerät)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SCRIPT_H_
+#define INC_MYLIB_SCRIPT_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SCRIPT_Exported_Constants SCRIPT Exported Constants
+   * @{
+   */
+#define SCRIPT_CODE_SIZE 256					/*!< Bytes des Programms, Sprungziele sind 8 Bit */
+#define SCRIPT_STACK_SIZE 16					/*!< Einträge des Stacks */
+#define SCRIPT_VARS 8							/*!< Variablen 0..SCRIPT_VARS-1 */
+#define SCRIPT_TICK_MS 1						/*!< Takt des Interpreters in ms (Interrupt des LPTIM) */
+#define SCRIPT_STEPS_PER_TICK 200				/*!< Befehle je Takt, danach gibt der Interpreter die CPU bis zum nächsten Takt ab */
+#define SCRIPT_CALL_STEPS 50					/*!< Kosten eines Kommandos des Protokolls in Befehlen */
+#define SCRIPT_ARG_MAX SERIALPROT_PARAM_MAX		/*!< größter Parameter eines Kommandos */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SCRIPT_Exported_Types SCRIPT Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SCRIPT Befehle, Operanden folgen dem Befehl im Programm, Werte liegen als int32_t auf dem Stack
+   */
+ typedef enum
+ {
+	 SCRIPT_OP_END = 0x00,				/*!< Ende, meldet "vm,end" */
+	 SCRIPT_OP_PUSH = 0x01,				/*!< <b>: legt b (0..255) auf den Stack */
+	 SCRIPT_OP_PUSHW = 0x02,			/*!< <lo> <hi>: legt lo + 256 * hi (0..65535) auf den Stack */
+	 SCRIPT_OP_LOAD = 0x03,				/*!< <v>: legt Variable v auf den Stack */
+	 SCRIPT_OP_STORE = 0x04,			/*!< <v>: nimmt den obersten Wert in Variable v */
+	 SCRIPT_OP_DUP = 0x05,				/*!< verdoppelt den obersten Wert */
+	 SCRIPT_OP_DROP = 0x06,				/*!< verwirft den obersten Wert */
+	 SCRIPT_OP_SWAP = 0x07,				/*!< tauscht die beiden obersten Werte */
+	 SCRIPT_OP_ADD = 0x08,				/*!< a b -> a + b */
+	 SCRIPT_OP_SUB = 0x09,				/*!< a b -> a - b */
+	 SCRIPT_OP_MUL = 0x0A,				/*!< a b -> a * b */
+	 SCRIPT_OP_EQ = 0x0B,				/*!< a b -> 1 wenn a == b, sonst 0 */
+	 SCRIPT_OP_LT = 0x0C,				/*!< a b -> 1 wenn a < b, sonst 0 */
+	 SCRIPT_OP_NOT = 0x0D,				/*!< a -> 1 wenn a == 0, sonst 0 */
+	 SCRIPT_OP_JMP = 0x0E,				/*!< <adr>: springt nach adr */
+	 SCRIPT_OP_JZ = 0x0F,				/*!< <adr>: nimmt den obersten Wert, springt bei 0 */
+	 SCRIPT_OP_DJNZ = 0x10,				/*!< <v> <adr>: Variable v - 1, springt solange sie nicht 0 ist (Schleifenzähler) */
+	 SCRIPT_OP_WAIT = 0x11,				/*!< nimmt ms und wartet, 0 gibt die CPU nur bis zum nächsten Takt ab */
+	 SCRIPT_OP_CALL = 0x12,				/*!< <c> <c> <c>: a b -> Ergebnis von "#ccc,a:b", nur "rdm" und "add" */
+	 SCRIPT_OP_ASC = 0x13,				/*!< c -> Ergebnis von "#asc,<Zeichen c>:0" */
+	 SCRIPT_OP_GPO = 0x14,				/*!< <n> <n Zeichen>: nimmt den Pegel, "#gpo,<Name>:on" bzw. ":off" bei 0 */
+	 SCRIPT_OP_EMIT = 0x15				/*!< nimmt den obersten Wert und meldet ihn als "vm,v,<wert>" */
+ } SCRIPT_OpcodeTypeDef;
+
+
+ /**
+   * @brief  SCRIPT Fehler, der das Programm beendet hat
+   */
+ typedef enum
+ {
+	 SCRIPT_ERROR_NONE = 0x00,			/*!< kein Fehler */
+	 SCRIPT_ERROR_OPCODE = 0x01,		/*!< unbekannter Befehl, Operand oder Sprungziel außerhalb des Programms */
+	 SCRIPT_ERROR_STACK = 0x02,			/*!< Stack über- oder unterlaufen */
+	 SCRIPT_ERROR_NACK = 0x03,			/*!< ein Kommando wurde mit NACK beantwortet */
+	 SCRIPT_ERROR_ARGUMENT = 0x04		/*!< Parameter eines Kommandos außerhalb 0..SCRIPT_ARG_MAX bzw. kein Buchstabe/keine Ziffer */
+ } SCRIPT_ErrorTypeDef;
+
+
+ /**
+   * @brief  SCRIPT Zustand des Interpreters
+   */
+ typedef enum
+ {
+	 SCRIPT_STATE_IDLE = 0x00,			/*!< kein Programm läuft, das Programm darf geändert werden */
+	 SCRIPT_STATE_RUN = 0x01			/*!< das Programm läuft bzw. wartet */
+ } SCRIPT_StateTypeDef;
+
+
+ /**
+   * @brief  SCRIPT Konfiguration structures definition
+   */
+ typedef struct
+ {
+   LPTIM_TypeDef *Timer;              /*!< LPTIM als Takt des Interpreters (Takt PCLK1 und Interrupt bereits freigegeben) */
+ }SCRIPT_InitTypeDef;
+
+
+ /**
+   * @brief  SCRIPT handle structures definition
+   */
+ typedef struct
+ {
+   SCRIPT_InitTypeDef Init;      /*!< Konfiguration */
+
+   uint8_t Code[SCRIPT_CODE_SIZE]; /*!< Programm */
+
+   uint16_t Length;              /*!< Bytes im Programm */
+
+   uint16_t Pc;                  /*!< nächster Befehl */
+
+   int32_t Stack[SCRIPT_STACK_SIZE]; /*!< Stack */
+
+   uint8_t Sp;                   /*!< Einträge auf dem Stack */
+
+   int32_t Var[SCRIPT_VARS];     /*!< Variablen, bleiben nach dem Ende für "vmv" erhalten */
+
+   uint32_t Wait;                /*!< noch zu wartende Takte */
+
+   uint32_t Steps;               /*!< ausgeführte Befehle seit dem Start */
+
+   uint32_t Ticks;               /*!< Takte seit dem Start (Laufzeit in ms) */
+
+   uint16_t Reload;              /*!< Zähltakte des LPTIM je SCRIPT_TICK_MS */
+
+   SCRIPT_ErrorTypeDef Error;    /*!< Fehler des letzten Laufs */
+
+   volatile SCRIPT_StateTypeDef State; /*!< Zustand des Interpreters */
+
+   SERIALPROTOCOL_TypeDef *hserialprot; /*!< Instanz, die das Programm gestartet hat und die Meldungen erhält */
+
+   SERIALPROTOCOL_TypeDef Engine; /*!< eigene Instanz des Protokolls ohne Transportschicht für die Kommandos des Programms */
+ }SCRIPT_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SCRIPT_Exported_Functions SCRIPT Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_SCRIPT_Init(SCRIPT_TypeDef *hscript);
+
+/* IO operation functions *****************************************************/
+void MYLIB_SCRIPT_Clear(SCRIPT_TypeDef *hscript);
+HAL_StatusTypeDef MYLIB_SCRIPT_Append(SCRIPT_TypeDef *hscript, const uint8_t *Code, uint16_t Length);
+HAL_StatusTypeDef MYLIB_SCRIPT_Start(SCRIPT_TypeDef *hscript, int32_t Var0, int32_t Var1);
+void MYLIB_SCRIPT_Stop(SCRIPT_TypeDef *hscript);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_SCRIPT_Command(SCRIPT_TypeDef *hscript, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_SCRIPT_IRQHandler(SCRIPT_TypeDef *hscript);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SCRIPT_H_ */
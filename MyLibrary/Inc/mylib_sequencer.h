@@ -0,0 +1,111 @@
+/**
+  ******************************************************************************
+  * @file    mylib_sequencer.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SEQUENCER (Pin-Muster per Timer und DMA auf GPIOx->BSRR)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SEQUENCER_H_
+#define INC_MYLIB_SEQUENCER_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SEQUENCER_Exported_Constants SEQUENCER Exported Constants
+   * @{
+   */
+#define SEQUENCER_TABLE_SIZE 128				/*!< maximale Anzahl der Schritte eines Musters */
+#define SEQUENCER_COUNTER_CLOCK 1000000U		/*!< Zähltakt des Timers in Hz, die Schrittzeit wird in µs angegeben */
+#define SEQUENCER_STEP_MIN_US 5					/*!< kürzeste Schrittzeit (DMA-Zugriff und Buslast bei 4 MHz) */
+#define SEQUENCER_STEP_MAX_US SERIALPROT_PARAM_MAX	/*!< längste Schrittzeit, länger mit Wiederholungen in "sqa" */
+#define SEQUENCER_LOOPS_MAX SERIALPROT_PARAM_MAX	/*!< maximale Anzahl der Durchläufe, 0 = endlos */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SEQUENCER_Exported_Types SEQUENCER Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SEQUENCER Konfiguration structures definition
+   */
+ typedef struct
+ {
+   TIM_TypeDef *Timer;                /*!< Basis-Timer TIM6 oder TIM7 (Takt PCLK1), sein Update-Ereignis löst je Schritt eine DMA-Übertragung aus */
+
+   DMA_Channel_TypeDef *Channel;      /*!< DMA-Kanal mit dem Update-Request des Timers */
+
+   uint32_t DmaRequest;               /*!< DMA-Request des Timers auf dem Kanal (CSELR) */
+
+   GPIO_TypeDef *Port;                /*!< Port, dessen BSRR beschrieben wird */
+
+   uint16_t Pins;                     /*!< Pins, die das Muster schalten darf (nur Ausgänge) */
+ }SEQUENCER_InitTypeDef;
+
+
+ /**
+   * @brief  SEQUENCER handle structures definition
+   */
+ typedef struct
+ {
+   SEQUENCER_InitTypeDef Init;        /*!< Konfiguration */
+
+   uint32_t Table[SEQUENCER_TABLE_SIZE]; /*!< Muster als BSRR-Werte, je Schritt ein Wert */
+
+   uint16_t Count;                    /*!< Anzahl der Schritte im Muster */
+
+   uint16_t Loops;                    /*!< Anzahl der Durchläufe des laufenden Musters, 0 = endlos */
+
+   volatile uint16_t LoopsDone;       /*!< Anzahl der beendeten Durchläufe */
+
+   volatile uint8_t Running;          /*!< 1: das Muster wird ausgegeben */
+
+   SERIALPROTOCOL_TypeDef *hserialprot; /*!< Instanz, die das Muster gestartet hat, erhält die Meldung am Ende */
+ }SEQUENCER_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SEQUENCER_Exported_Functions SEQUENCER Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_SEQUENCER_Init(SEQUENCER_TypeDef *hsequencer);
+
+/* IO operation functions *****************************************************/
+HAL_StatusTypeDef MYLIB_SEQUENCER_Start(SEQUENCER_TypeDef *hsequencer, uint16_t StepUs, uint16_t Loops);
+void MYLIB_SEQUENCER_Stop(SEQUENCER_TypeDef *hsequencer);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_SEQUENCER_Command(SEQUENCER_TypeDef *hsequencer, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_SEQUENCER_DMA_IRQHandler(SEQUENCER_TypeDef *hsequencer);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SEQUENCER_H_ */
@@ -17,6 +17,22 @@
 
  /* Includes ------------------------------------------------------------------*/
 #include "stm32l4xx_hal.h"
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SERIALPROT_Exported_Constants SERIALPROT Exported Constants
+   * @{
+   */
+#define SERIALPROT_TxBuffer_SIZE 160			/*!< Mindestgröße des Sendepuffers/Antwortpuffers (längste Antwort: "sta") */
+#define SERIALPROT_CollectionBuffer_SIZE 20		/*!< maximale Länge einer Eingabezeile */
+#define SERIALPROT_PARAM_SIZE 4					/*!< maximale Länge eines Parameters in Zeichen */
+#define SERIALPROT_PARAM_MAX 9999				/*!< größter Zahlenwert eines Parameters (SERIALPROT_PARAM_SIZE Stellen) */
+#define SERIALPROT_TxQueue_SIZE 512				/*!< Größe jedes der beiden Sendepuffer je Instanz */
+#define SERIALPROT_Result_SIZE 96				/*!< Größe des Ergebnispuffers von SERIALPROT_Command_User_Callback() (längstes Ergebnis: "edg") */
+#define SERIALPROT_FastPath_NAME_SIZE 4			/*!< maximale Länge des Pin-Namens im schnellen "gpo"-Pfad (wie Parameter1) */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
  /* Exported macros -----------------------------------------------------------*/
  /** @defgroup TIM_Exported_Macros TIM Exported Macros
    * @{
@@ -54,6 +70,17 @@
  } SERIALPROTCOL_StatusTypeDef;
 
 
+ /**
+   * @brief  SERIALPROT Rückgabewerte der Kommando-Callbacks definition
+   */
+ typedef enum
+ {
+	 SERIALPROT_COMMAND_OK = 0x00,			/*!< Kommando ausgeführt (ACK) */
+	 SERIALPROT_COMMAND_INVALID = 0x01,		/*!< Parameter des Kommandos ungültig (NACK) */
+	 SERIALPROT_COMMAND_UNKNOWN = 0x02		/*!< Kommando nicht definiert (NACK) */
+ } SERIALPROTOCOL_CommandStatusTypeDef;
+
+
  /**
    * @brief  SERIALPROT Message Kind definition
    */
@@ -67,9 +94,126 @@
 
 
  /**
-   * @brief  SERIALPROT Status structures definition
+   * @brief  SERIALPROT Zustand des schnellen "gpo"-Pfads definition
+   */
+ typedef enum
+ {
+	 SERIALPROT_FASTPATH_PREFIX = 0x00,		/*!< vergleicht die Zeile mit "#gpo," */
+	 SERIALPROT_FASTPATH_NAME = 0x01,		/*!< sammelt den Pin-Namen bis ':' */
+	 SERIALPROT_FASTPATH_LEVEL = 0x02,		/*!< Pin aufgelöst, dekodiert "on"/"off" */
+	 SERIALPROT_FASTPATH_NONE = 0x03		/*!< keine passende "gpo"-Zeile, bis zum '\r' nur der normale Pfad */
+ } SERIALPROTOCOL_FastPathStateTypeDef;
+
+
+ /**
+   * @brief  SERIALPROT Fehlerzähler structures definition
+   */
+ typedef struct
+ {
+   uint32_t OverrunErrors;       /*!< Anzahl der Overrun-Fehler (ORE) */
+
+   uint32_t FramingErrors;       /*!< Anzahl der Framing-Fehler (FE) */
+
+   uint32_t NoiseErrors;         /*!< Anzahl der Rausch-Fehler (NE) */
+
+   uint32_t ParityErrors;        /*!< Anzahl der Paritäts-Fehler (PE) */
+
+   uint32_t TxErrors;            /*!< Anzahl der fehlgeschlagenen Sendevorgänge */
+
+   uint32_t RxRearmErrors;       /*!< Anzahl der fehlgeschlagenen Empfangs-Neustarts */
+ }SERIALPROTOCOL_ErrorCounterTypeDef;
+
+
+ /**
+   * @brief  SERIALPROT Statistik structures definition
+   * @note   Die Reihenfolge entspricht dem Datensatz des Kommandos "sta" (je Zähler 8 Hex-Stellen)
+   */
+ typedef struct
+ {
+   uint32_t RxBytes;             /*!< Anzahl der empfangenen Zeichen */
+
+   uint32_t TxBytes;             /*!< Anzahl der gesendeten Zeichen */
+
+   uint32_t FramesAccepted;      /*!< Anzahl der bestätigten Kommandos (ACK) */
+
+   uint32_t NackSyntax;          /*!< NACK: Eingabe entspricht nicht der Kommando-Syntax */
+
+   uint32_t NackCommand;         /*!< NACK: Kommando nicht definiert */
+
+   uint32_t NackParameter;       /*!< NACK: Parameter ungültig */
+
+   uint32_t Overflows;           /*!< Anzahl der Überläufe des Eingabepuffers (OV) */
+
+   uint32_t UartErrors;          /*!< Summe der UART-Fehler ORE/FE/NE/PE (beim Auslesen aktualisiert) */
+
+   uint32_t TxErrors;            /*!< fehlgeschlagene Sendevorgänge (beim Auslesen aktualisiert) */
+
+   uint32_t PeakRxDepth;         /*!< höchster Füllstand des Eingabepuffers */
+
+   uint32_t MaxReplySize;        /*!< längste erzeugte Antwort */
+
+   uint32_t PeakTxDepth;         /*!< höchster Füllstand der Sendewarteschlange */
+
+   uint32_t TxDropped;           /*!< wegen voller Sendewarteschlange verworfene Antworten */
+ }SERIALPROTOCOL_StatisticsTypeDef;
+
+
+ /**
+   * @brief  SERIALPROT schneller "gpo"-Pfad structures definition
+   * @note   Die Zeile wird schon beim Empfang Zeichen für Zeichen dekodiert, beim '\r' bleibt nur ein
+   *         vorberechneter BSRR-Zugriff. Danach läuft die Zeile wie bisher durch den normalen Pfad (Prüfung, Callback, ACK).
    */
  typedef struct
+ {
+   SERIALPROTOCOL_FastPathStateTypeDef State; /*!< Zustand der Dekodierung der laufenden Zeile */
+
+   uint8_t Index;                /*!< Position im Präfix, im Namen bzw. in "on"/"off" */
+
+   uint8_t Name[SERIALPROT_FastPath_NAME_SIZE + 1]; /*!< bisher empfangener Pin-Name */
+
+   GPIO_TypeDef *Port;           /*!< Port des aufgelösten Pins */
+
+   uint32_t BsrrOn;              /*!< BSRR-Wert für "on" (aktiver Pegel) */
+
+   uint32_t BsrrOff;             /*!< BSRR-Wert für "off" */
+
+   uint32_t Bsrr;                /*!< beim '\r' zu schreibender Wert, 0 = Zeile (noch) nicht vollständig dekodiert */
+
+   uint32_t RxStamp;             /*!< DWT-Zyklenzähler beim Eintreffen des Blocks mit dem '\r' */
+
+   uint32_t Count;               /*!< Anzahl der über den schnellen Pfad geschalteten Kommandos */
+
+   uint32_t LastCycles;          /*!< Zyklen vom Eintreffen bis zum BSRR-Zugriff, letztes Kommando */
+
+   uint32_t MaxCycles;           /*!< Zyklen vom Eintreffen bis zum BSRR-Zugriff, Maximum */
+ }SERIALPROTOCOL_FastPathTypeDef;
+
+
+ struct __SERIALPROTOCOL_TypeDef;
+
+ /**
+   * @brief  SERIALPROT Transportschicht structures definition
+   * @note   Eine Transportschicht (UART per IT/DMA, Loopback, ...) bettet diese Struktur als erstes Element
+   *         in ihren eigenen Handle ein. Sie meldet Empfangenes mit MYLIB_SERIALPROT_RxNotify() und
+   *         das Ende eines Sendevorgangs mit MYLIB_SERIALPROT_TxComplete(). Beide dürfen sich nicht
+   *         gegenseitig unterbrechen (gleiche NVIC-Priorität).
+   */
+ typedef struct __SERIALPROTOCOL_TransportTypeDef
+ {
+   HAL_StatusTypeDef (*Start)(struct __SERIALPROTOCOL_TransportTypeDef *htransport);     /*!< Empfang starten */
+
+   HAL_StatusTypeDef (*Transmit)(struct __SERIALPROTOCOL_TransportTypeDef *htransport,
+                                 uint8_t *pData, uint16_t Size);                          /*!< Puffer ohne Kopie senden, er gehört
+                                                                                               bis MYLIB_SERIALPROT_TxComplete() der Transportschicht */
+
+   struct __SERIALPROTOCOL_TypeDef *hserialprot;   /*!< gebundene Instanz des Protokolls */
+ }SERIALPROTOCOL_TransportTypeDef;
+
+
+ /**
+   * @brief  SERIALPROT Status structures definition
+   */
+ typedef struct __SERIALPROTOCOL_TypeDef
  {
    uint8_t CommandName[5];        /*!< Kommandoname */
 
@@ -78,6 +222,26 @@
    uint8_t Parameter1[15];       /*!< Parameter1 des Kommandos */
 
    uint8_t Parameter2[15];       /*!< Parameter2 des Kommandos */
+
+   SERIALPROTOCOL_ErrorCounterTypeDef ErrorCounter; /*!< Fehlerzähler der Schnittstelle */
+
+   SERIALPROTOCOL_StatisticsTypeDef Statistics; /*!< Statistikzähler der Verbindung */
+
+   SERIALPROTOCOL_TransportTypeDef *Transport; /*!< an diese Instanz gebundene Transportschicht */
+
+   uint8_t Quiet;                /*!< 1: kein Echo der Eingabe und kein "Input> " (Maschine als Gegenstelle, z.B. SPI), nach MYLIB_SERIALPROT_Init() zu setzen */
+
+   uint8_t CollectionBuffer[SERIALPROT_CollectionBuffer_SIZE + 1]; /*!< bisher gesammelte Eingabezeile */
+
+   uint8_t TxQueue[2][SERIALPROT_TxQueue_SIZE]; /*!< Sendewarteschlange: ein Puffer wird gesendet, in den anderen werden Antworten geschrieben */
+
+   uint16_t TxLength[2];         /*!< Füllstand der beiden Sendepuffer */
+
+   uint8_t TxFill;               /*!< Index des Puffers, in den geschrieben wird */
+
+   volatile uint8_t TxBusy;      /*!< 1 = Transportschicht sendet den anderen Puffer */
+
+   SERIALPROTOCOL_FastPathTypeDef FastPath; /*!< schneller Pfad für "gpo", siehe SERIALPROT_FastPath_Resolve_Callback() */
  }SERIALPROTOCOL_TypeDef;
 
  /**
@@ -91,11 +255,24 @@
    * @{
    */
 
- /* IO operation functions *****************************************************/
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_SERIALPROT_Init(SERIALPROTOCOL_TypeDef *hserialprot, SERIALPROTOCOL_TransportTypeDef *htransport);
+
+/* IO operation functions *****************************************************/
 void MYLIB_SERIALPROT_XCHANGE(SERIALPROTOCOL_TypeDef *hserialprot,uint8_t * RxBuffer, uint8_t * last );
 
+/* Transport interface functions  *********************************************/
+void MYLIB_SERIALPROT_RxNotify(SERIALPROTOCOL_TypeDef *hserialprot, const uint8_t * pData, uint16_t Size);
+void MYLIB_SERIALPROT_TxComplete(SERIALPROTOCOL_TypeDef *hserialprot);
+void MYLIB_SERIALPROT_RxAbort(SERIALPROTOCOL_TypeDef *hserialprot);
+HAL_StatusTypeDef MYLIB_SERIALPROT_Event(SERIALPROTOCOL_TypeDef *hserialprot, const uint8_t * Event);
+
 /* Callbacks Register/UnRegister functions  ***********************************/
 uint8_t SERIALPROT_Command_GPO_Callback(SERIALPROTOCOL_TypeDef *hserialprot);
+uint8_t SERIALPROT_Command_User_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+void SERIALPROT_Random_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint16_t Value);
+void SERIALPROT_RxByte_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Byte);
+uint8_t SERIALPROT_FastPath_Resolve_Callback(SERIALPROTOCOL_TypeDef *hserialprot, const uint8_t * Name, GPIO_TypeDef ** Port, uint32_t * BsrrOn, uint32_t * BsrrOff);
 
 /**
   * @}
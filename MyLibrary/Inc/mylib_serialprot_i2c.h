@@ -0,0 +1,102 @@
+/**
+  ******************************************************************************
+  * @file    mylib_serialprot_i2c.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SERIALPROT_I2C (I2C-Slave-Transportschicht mit Registerschnittstelle)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SERIALPROT_I2C_H_
+#define INC_MYLIB_SERIALPROT_I2C_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SERIALPROT_I2C_Exported_Constants SERIALPROT_I2C Exported Constants
+   * @{
+   */
+#define SERIALPROT_I2C_REG_STATUS 0x00			/*!< lesen: Anzahl der abholbereiten Antwortzeichen (2 Byte, LSB zuerst) */
+#define SERIALPROT_I2C_REG_DATA 0x01			/*!< lesen: Antwortzeichen, 0x00 wenn keine Antwort ansteht */
+#define SERIALPROT_I2C_REG_CMD 0x02				/*!< schreiben: Kommandozeichen (z.B. "#gpo,rt:on\r") */
+
+#define SERIALPROT_I2C_MAX_INSTANCES 2			/*!< maximale Anzahl gleichzeitig gebundener I2C */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SERIALPROT_I2C_Exported_Types SERIALPROT_I2C Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SERIALPROT_I2C handle structures definition
+   */
+ typedef struct
+ {
+   SERIALPROTOCOL_TransportTypeDef Transport; /*!< Transportschicht, muss das erste Element sein */
+
+   I2C_HandleTypeDef *hi2c;      /*!< verwendeter I2C (Slave-Adresse aus hi2c->Init.OwnAddress1) */
+
+   uint8_t Register;             /*!< ausgewähltes Register der laufenden Übertragung */
+
+   uint8_t RegisterPending;      /*!< 1: das nächste geschriebene Byte ist die Registeradresse */
+
+   uint8_t RxByte;               /*!< Empfangspuffer für ein Zeichen */
+
+   uint8_t *pTxData;             /*!< vom Protokoll übergebener Sendepuffer (NULL: keine Antwort) */
+
+   uint16_t TxSize;              /*!< Länge des Sendepuffers */
+
+   uint16_t TxPos;               /*!< bereits gesendete Zeichen des Sendepuffers */
+
+   uint8_t Status[2];            /*!< Abbild des Registers STATUS zu Beginn der Leseübertragung */
+
+   uint8_t StatusPos;            /*!< bereits gesendete Zeichen von Status */
+
+   uint8_t FillByte;             /*!< Füllzeichen, wenn nichts zu senden ist */
+
+   uint8_t TxQueued;             /*!< Art des zuletzt zum Senden übergebenen Zeichens */
+ }SERIALPROT_I2C_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SERIALPROT_I2C_Exported_Functions SERIALPROT_I2C Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_SERIALPROT_I2C_Init(SERIALPROT_I2C_TypeDef *hseriali2c, I2C_HandleTypeDef *hi2c);
+SERIALPROT_I2C_TypeDef * MYLIB_SERIALPROT_I2C_GetInstance(I2C_HandleTypeDef *hi2c);
+
+/* HAL-Callback dispatch functions  *******************************************/
+void MYLIB_SERIALPROT_I2C_AddrCallback(I2C_HandleTypeDef *hi2c, uint8_t TransferDirection, uint16_t AddrMatchCode);
+void MYLIB_SERIALPROT_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c);
+void MYLIB_SERIALPROT_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef *hi2c);
+void MYLIB_SERIALPROT_I2C_ListenCpltCallback(I2C_HandleTypeDef *hi2c);
+void MYLIB_SERIALPROT_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SERIALPROT_I2C_H_ */
@@ -0,0 +1,69 @@
+/**
+  ******************************************************************************
+  * @file    mylib_serialprot_loopback.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SERIALPROT_LOOPBACK (Speicher-Transportschicht ohne Hardware)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SERIALPROT_LOOPBACK_H_
+#define INC_MYLIB_SERIALPROT_LOOPBACK_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SERIALPROT_LOOPBACK_Exported_Types SERIALPROT_LOOPBACK Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SERIALPROT_LOOPBACK handle structures definition
+   */
+ typedef struct
+ {
+   SERIALPROTOCOL_TransportTypeDef Transport; /*!< Transportschicht, muss das erste Element sein */
+
+   uint8_t *pOutput;             /*!< Ausgabepuffer für die gesendeten Antworten (NULL: Antworten werden nur gezählt) */
+
+   uint32_t OutputSize;          /*!< Größe des Ausgabepuffers */
+
+   uint32_t OutputLength;        /*!< Anzahl der Zeichen im Ausgabepuffer */
+
+   uint32_t OutputDropped;       /*!< Anzahl der Zeichen, die nicht mehr in den Ausgabepuffer gepasst haben */
+ }SERIALPROT_LOOPBACK_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SERIALPROT_LOOPBACK_Exported_Functions SERIALPROT_LOOPBACK Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+void MYLIB_SERIALPROT_LOOPBACK_Init(SERIALPROT_LOOPBACK_TypeDef *hloopback, uint8_t *pOutput, uint32_t OutputSize);
+
+/* IO operation functions  ****************************************************/
+void MYLIB_SERIALPROT_LOOPBACK_Write(SERIALPROT_LOOPBACK_TypeDef *hloopback, const uint8_t *pData, uint16_t Size);
+void MYLIB_SERIALPROT_LOOPBACK_Flush(SERIALPROT_LOOPBACK_TypeDef *hloopback);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SERIALPROT_LOOPBACK_H_ */
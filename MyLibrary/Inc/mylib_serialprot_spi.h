@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file    mylib_serialprot_spi.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SERIALPROT_SPI (SPI-Slave-Transportschicht per DMA, registerbasiert)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SERIALPROT_SPI_H_
+#define INC_MYLIB_SERIALPROT_SPI_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SERIALPROT_SPI_Exported_Constants SERIALPROT_SPI Exported Constants
+   * @{
+   */
+#define SERIALPROT_SPI_RxDMA_SIZE 128			/*!< Größe des zirkulären DMA-Empfangspuffers */
+#define SERIALPROT_SPI_FILL_BYTE 0x00			/*!< Füllzeichen in beiden Richtungen, wird vom Empfänger verworfen */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SERIALPROT_SPI_Exported_Types SERIALPROT_SPI Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SERIALPROT_SPI Init structure definition
+   */
+ typedef struct
+ {
+   SPI_TypeDef *Instance;             /*!< SPI-Peripherie (Takt und Pins sind bereits konfiguriert) */
+
+   DMA_Channel_TypeDef *RxChannel;    /*!< DMA-Kanal für den Empfang */
+
+   DMA_Channel_TypeDef *TxChannel;    /*!< DMA-Kanal für das Senden */
+
+   uint32_t DmaRequest;               /*!< DMA-Request der SPI auf beiden Kanälen (CSELR) */
+
+   GPIO_TypeDef *ReadyPort;           /*!< Port der READY-Leitung zum Master */
+
+   uint16_t ReadyPin;                 /*!< Pin der READY-Leitung, High solange eine Antwort abzuholen ist */
+ }SERIALPROT_SPI_InitTypeDef;
+
+
+ /**
+   * @brief  SERIALPROT_SPI handle structures definition
+   */
+ typedef struct
+ {
+   SERIALPROTOCOL_TransportTypeDef Transport; /*!< Transportschicht, muss das erste Element sein */
+
+   SERIALPROT_SPI_InitTypeDef Init;   /*!< Konfiguration */
+
+   uint8_t RxBuffer[SERIALPROT_SPI_RxDMA_SIZE]; /*!< zirkulärer DMA-Empfangspuffer */
+
+   uint16_t RxPos;                    /*!< bereits verarbeitete Position im DMA-Empfangspuffer */
+
+   uint8_t FillByte;                  /*!< Quelle der Füllzeichen, solange keine Antwort ansteht */
+
+   volatile uint8_t TxActive;         /*!< 1: eine Antwort wird per DMA gesendet */
+ }SERIALPROT_SPI_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SERIALPROT_SPI_Exported_Functions SERIALPROT_SPI Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_SERIALPROT_SPI_Init(SERIALPROT_SPI_TypeDef *hserialspi);
+
+/* IRQ handler and callback functions  ****************************************/
+void MYLIB_SERIALPROT_SPI_RxDMA_IRQHandler(SERIALPROT_SPI_TypeDef *hserialspi);
+void MYLIB_SERIALPROT_SPI_TxDMA_IRQHandler(SERIALPROT_SPI_TypeDef *hserialspi);
+void MYLIB_SERIALPROT_SPI_NSS_Callback(SERIALPROT_SPI_TypeDef *hserialspi, GPIO_PinState NSS);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SERIALPROT_SPI_H_ */
@@ -0,0 +1,103 @@
+/**
+  ******************************************************************************
+  * @file    mylib_serialprot_uart.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SERIALPROT_UART (UART-Transportschicht per IT oder DMA)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SERIALPROT_UART_H_
+#define INC_MYLIB_SERIALPROT_UART_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SERIALPROT_UART_Exported_Constants SERIALPROT_UART Exported Constants
+   * @{
+   */
+#define SERIALPROT_UART_RxDMA_SIZE 64			/*!< Größe des zirkulären DMA-Empfangspuffers */
+#define SERIALPROT_UART_MAX_INSTANCES 3			/*!< maximale Anzahl gleichzeitig gebundener UARTs */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SERIALPROT_UART_Exported_Types SERIALPROT_UART Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SERIALPROT_UART Betriebsart definition
+   */
+ typedef enum
+ {
+	 SERIALPROT_UART_MODE_IT = 0x00,		/*!< Empfang zeichenweise und Senden per Interrupt */
+	 SERIALPROT_UART_MODE_DMA = 0x01		/*!< Empfang zirkulär per DMA mit IDLE-Erkennung, Senden per DMA */
+ } SERIALPROT_UART_ModeTypeDef;
+
+
+ /**
+   * @brief  SERIALPROT_UART handle structures definition
+   */
+ typedef struct
+ {
+   SERIALPROTOCOL_TransportTypeDef Transport; /*!< Transportschicht, muss das erste Element sein */
+
+   UART_HandleTypeDef *huart;    /*!< verwendeter UART */
+
+   SERIALPROT_UART_ModeTypeDef Mode; /*!< Betriebsart */
+
+   uint8_t RxBuffer[SERIALPROT_UART_RxDMA_SIZE]; /*!< Empfangspuffer (IT: nur das erste Zeichen) */
+
+   uint16_t RxPos;               /*!< bereits verarbeitete Position im DMA-Empfangspuffer */
+
+   uint8_t MultiDrop;            /*!< 1: Mehrpunktbetrieb (RS-485) mit Adressmarke, siehe MYLIB_SERIALPROT_UART_EnableMultiDrop() */
+
+   uint8_t LineMatch;            /*!< 1: '\r' wird über die Zeichenerkennung sofort gemeldet, siehe MYLIB_SERIALPROT_UART_EnableLineMatch() */
+ }SERIALPROT_UART_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SERIALPROT_UART_Exported_Functions SERIALPROT_UART Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_SERIALPROT_UART_Init(SERIALPROT_UART_TypeDef *hserialuart, UART_HandleTypeDef *huart, SERIALPROT_UART_ModeTypeDef Mode);
+SERIALPROT_UART_TypeDef * MYLIB_SERIALPROT_UART_GetInstance(UART_HandleTypeDef *huart);
+HAL_StatusTypeDef MYLIB_SERIALPROT_UART_EnableMultiDrop(SERIALPROT_UART_TypeDef *hserialuart, uint8_t Address);
+HAL_StatusTypeDef MYLIB_SERIALPROT_UART_EnableLineMatch(SERIALPROT_UART_TypeDef *hserialuart);
+
+/* IRQ handler functions  *****************************************************/
+void MYLIB_SERIALPROT_UART_IRQHandler(UART_HandleTypeDef *huart);
+
+/* HAL-Callback dispatch functions  *******************************************/
+void MYLIB_SERIALPROT_UART_RxCpltCallback(UART_HandleTypeDef *huart);
+void MYLIB_SERIALPROT_UART_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size);
+void MYLIB_SERIALPROT_UART_TxCpltCallback(UART_HandleTypeDef *huart);
+void MYLIB_SERIALPROT_UART_ErrorCallback(UART_HandleTypeDef *huart);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SERIALPROT_UART_H_ */
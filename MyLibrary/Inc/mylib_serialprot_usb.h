@@ -0,0 +1,96 @@
+/**
+  ******************************************************************************
+  * @file    mylib_serialprot_usb.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_SERIALPROT_USB (USB-CDC-ACM-Transportschicht)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_SERIALPROT_USB_H_
+#define INC_MYLIB_SERIALPROT_USB_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup SERIALPROT_USB_Exported_Constants SERIALPROT_USB Exported Constants
+   * @{
+   */
+#define SERIALPROT_USB_PACKET_SIZE 64			/*!< maximale Paketgröße der Bulk-Endpunkte (Full-Speed) */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup SERIALPROT_USB_Exported_Types SERIALPROT_USB Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  SERIALPROT_USB Endpunkt-Treiber definition
+   * @note   Sendet einen Block über den Bulk-IN-Endpunkt (Aufteilung in Pakete und abschließendes
+   *         Null-Paket erledigt der Endpunkt-Treiber) und meldet das Ende mit MYLIB_SERIALPROT_USB_TxCpltCallback()
+   */
+ typedef HAL_StatusTypeDef (*SERIALPROT_USB_SendTypeDef)(void *pDriver, uint8_t *pData, uint16_t Size);
+
+
+ /**
+   * @brief  SERIALPROT_USB handle structures definition
+   */
+ typedef struct
+ {
+   SERIALPROTOCOL_TransportTypeDef Transport; /*!< Transportschicht, muss das erste Element sein */
+
+   SERIALPROT_USB_SendTypeDef Send;   /*!< Endpunkt-Treiber (USB-Device-CDC am Target, pty am Host) */
+
+   void *pDriver;                     /*!< Handle des Endpunkt-Treibers (z.B. USBD_HandleTypeDef) */
+
+   uint32_t TxTransfers;              /*!< Anzahl der IN-Übertragungen (je Übertragung ein Sendepuffer des Protokolls) */
+
+   uint32_t TxPackets;                /*!< Anzahl der dafür benötigten Pakete inkl. Null-Pakete */
+
+   uint32_t RxPackets;                /*!< Anzahl der empfangenen OUT-Pakete */
+ }SERIALPROT_USB_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup SERIALPROT_USB_Exported_Functions SERIALPROT_USB Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+void MYLIB_SERIALPROT_USB_Init(SERIALPROT_USB_TypeDef *hserialusb, SERIALPROT_USB_SendTypeDef Send, void *pDriver);
+
+/* Endpoint callback functions  ***********************************************/
+void MYLIB_SERIALPROT_USB_RxCallback(SERIALPROT_USB_TypeDef *hserialusb, const uint8_t *pData, uint32_t Length);
+void MYLIB_SERIALPROT_USB_TxCpltCallback(SERIALPROT_USB_TypeDef *hserialusb);
+
+#ifdef HAL_PCD_MODULE_ENABLED
+/* USB-Device-CDC functions  **************************************************/
+HAL_StatusTypeDef MYLIB_SERIALPROT_USB_CDC_Send(void *pDriver, uint8_t *pData, uint16_t Size);
+void MYLIB_SERIALPROT_USB_CDC_Receive(SERIALPROT_USB_TypeDef *hserialusb, uint8_t *pData, uint32_t *Length);
+#endif /* HAL_PCD_MODULE_ENABLED */
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_SERIALPROT_USB_H_ */
@@ -0,0 +1,114 @@
+/**
+  ******************************************************************************
+  * @file    mylib_stats.h
+  * @author  Reiter Roman
+  * @brief   Header file MYLIB_STATS (laufende Statistik nach Welford: Anzahl, Mittelwert, Varianz, Min, Max)
+
+  ******************************************************************************
+  */
+
+/* Define to prevent recursive inclusion -------------------------------------*/
+#ifndef INC_MYLIB_STATS_H_
+#define INC_MYLIB_STATS_H_
+
+#ifdef __cplusplus
+ extern "C" {
+#endif
+
+ /* Includes ------------------------------------------------------------------*/
+#include "mylib_serialprot.h"
+
+ /* Exported constants --------------------------------------------------------*/
+ /** @defgroup STATS_Exported_Constants STATS Exported Constants
+   * @{
+   */
+#define STATS_SOURCES_MAX 8						/*!< maximale Anzahl Quellen */
+#define STATS_WINDOW_MAX SERIALPROT_PARAM_MAX	/*!< größtes Fenster in Werten */
+ /**
+   * @}
+   */
+ /* End of exported constants -------------------------------------------------*/
+
+
+ /* Exported types ------------------------------------------------------------*/
+ /** @defgroup STATS_Exported_Types STATS Exported Types
+   * @{
+   */
+
+ /**
+   * @brief  STATS Kennwerte structures definition
+   */
+ typedef struct
+ {
+   uint32_t Count;               /*!< Anzahl der Werte */
+
+   float Mean;                   /*!< laufender Mittelwert */
+
+   float M2;                     /*!< Summe der quadrierten Abweichungen vom Mittelwert (Varianz = M2 / (Count - 1)) */
+
+   int32_t Min;                  /*!< kleinster Wert */
+
+   int32_t Max;                  /*!< größter Wert */
+ }STATS_AggregateTypeDef;
+
+
+ /**
+   * @brief  STATS Quelle structures definition
+   */
+ typedef struct
+ {
+   const char *Name;             /*!< Name der Quelle in den Kommandos (max. 4 Buchstaben) */
+
+   uint32_t Window;              /*!< Fenster in Werten, 0 = ohne Fenster (bis zum Zurücksetzen) */
+
+   uint32_t Windows;             /*!< Anzahl abgeschlossener Fenster */
+
+   STATS_AggregateTypeDef Current; /*!< Kennwerte des laufenden Fensters */
+
+   STATS_AggregateTypeDef Last;  /*!< Kennwerte des letzten abgeschlossenen Fensters */
+ }STATS_SourceTypeDef;
+
+
+ /**
+   * @brief  STATS handle structures definition
+   * @note   Werte und Kommandos kommen aus Interrupts gleicher Priorität und unterbrechen sich daher nicht
+   */
+ typedef struct
+ {
+   STATS_SourceTypeDef Source[STATS_SOURCES_MAX]; /*!< Quellen, Index = Rückgabe der Namenstabelle */
+
+   uint8_t Count;                /*!< Anzahl der Quellen */
+ }STATS_TypeDef;
+
+ /**
+   * @}
+   */
+ /* End of exported types -----------------------------------------------------*/
+
+
+ /* Exported functions --------------------------------------------------------*/
+ /** @addtogroup STATS_Exported_Functions STATS Exported Functions
+   * @{
+   */
+
+/* Initialization functions  *************************************************/
+HAL_StatusTypeDef MYLIB_STATS_Init(STATS_TypeDef *hstats, const char * const *Names, uint8_t Count);
+
+/* IO operation functions *****************************************************/
+void MYLIB_STATS_Add(STATS_TypeDef *hstats, uint8_t Source, int32_t Value);
+void MYLIB_STATS_Reset(STATS_TypeDef *hstats, uint8_t Source);
+float MYLIB_STATS_Variance(const STATS_AggregateTypeDef *Aggregate);
+
+/* Command functions  *********************************************************/
+uint8_t MYLIB_STATS_Command(STATS_TypeDef *hstats, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result);
+
+/**
+  * @}
+  */
+/* End of exported functions -------------------------------------------------*/
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* INC_MYLIB_STATS_H_ */
@@ -0,0 +1,454 @@
+/**
+******************************************************************************
+* @file mylib_adcstream.c
+* @author Reiter Roman
+* @brief mylib-ADC-Stream.
+* Diese Datei tastet einen Analogeingang fortlaufend ab und streamt die gemittelten Werte:
+* + Das Update-Ereignis eines Timers (TRGO) startet je Abtastung eine Wandlung, die DMA schreibt das Ergebnis
+*   in einen zirkulären Puffer, Halb- und Vollständig-Interrupt geben je eine Hälfte frei (Doppelpuffer)
+* + Je 2^Shift Abtastwerte werden gemittelt, die Summe bildet __SMLAD aus cmsis_gcc.h mit zwei Werten je Befehl
+* + Die Mittelwerte gehen zeilenweise als asynchrone Meldung an die Instanz, die den Stream gestartet hat,
+*   deren zwei Sendepuffer entkoppeln die Abtastung von der Übertragung
+* + Wahlweise werden die Zeilen mit mylib_encode gepackt (Zig-Zag-Delta, Varint, optional LZ, Base64),
+*   dann passen etwa doppelt so viele Werte pro Sekunde über die Verbindung
+* + ADC, Timer und DMA werden direkt über die Register betrieben (der ADC-HAL-Treiber ist nicht im Projekt enthalten)
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Takt von ADC, Timer und DMA einschalten, Interrupt des DMA-Kanals freigeben (Priorität 0 wie die Transportschichten)
+		(+) Eingangspin als Analogeingang einrichten (z.B. PA5 = ADC1_IN10)
+		(+) Der ADC läuft synchron mit HCLK (CKMODE = 01), der AHB-Vorteiler muss 1 sein
+
+	(#) Konfiguration eintragen und den ADC-Stream initialisieren (kalibriert und schaltet den ADC ein)
+		(+++) z.B.: hadcstream.Init.Instance = ADC1; hadcstream.Init.AdcChannel = 10;
+		(+++) z.B.: hadcstream.Init.Timer = TIM15; hadcstream.Init.ExternalTrigger = 14;
+		(+++) z.B.: hadcstream.Init.Channel = DMA1_Channel1; hadcstream.Init.DmaRequest = 0;
+		(+++) z.B.: MYLIB_ADCSTREAM_Init(&hadcstream);
+
+	(#) Interrupt des DMA-Kanals weiterreichen
+		(+++) DMA1_Channel1_IRQHandler ()  -> MYLIB_ADCSTREAM_DMA_IRQHandler(&hadcstream)
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen (alle Werte dezimal)
+		(+++) z.B.: return MYLIB_ADCSTREAM_Command(&hadcstream, hserialprot, Result);
+		(+) "#ads,<us>:<n>"  startet den Stream mit <us> Abtastperiode (ADCSTREAM_PERIOD_MIN_US..ADCSTREAM_PERIOD_MAX_US)
+			und Mittelung über n Abtastwerte (1, 2, 4 .. 64), "=> #a,<µs je gesendetem Wert>"
+		(+) "#adq,<us>:<n>"  wie "ads", aber ohne Zeilen, die Werte gehen nur an ADCSTREAM_Value_Callback()
+		(+) "#adx,0:0"       hält den Stream an, "=> #a,<gesendete zeilen>,<verworfene zeilen>"
+		(+) "#ade,<m>:0"     Format der Zeilen: 0 Hex, 1 Delta + Varint, 2 Delta + Varint + LZ, "=> #a,<m>",
+			während des Streams mit NACK abgewiesen
+
+	(#) Jeder Mittelwert wird zusätzlich an ADCSTREAM_Value_Callback() übergeben (z.B. für mylib_stats)
+
+	(#) Meldungen
+		(+) "=> #e,ad,<nr>,<werte>"  nr 4 Hex-Stellen (laufende Nummer), je Wert 3 Hex-Stellen (12 Bit),
+			ADCSTREAM_LINE_SAMPLES Werte je Zeile (Format 0)
+		(+) "=> #e,az,<nr>,<m>,<daten>"  gepackt (Format 1 und 2), ADCSTREAM_LINE_SAMPLES_PACKED Werte je Zeile,
+			Tools/encode_decode.c macht am Host wieder "ad"-Zeilen daraus
+		(+) Kann die Verbindung eine Zeile nicht mehr abnehmen, wird sie verworfen und die Nummer zählt weiter
+
+	(#) Grenzen
+		(+) Bei 115200 Baud passen etwa 3000 Werte pro Sekunde über die Verbindung,
+			schnellere Abtastung braucht eine entsprechende Mittelung (gepackt etwa 6000 bei ruhigen Signalen)
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_adcstream.h"
+#include "mylib_dmachannel.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/** @defgroup ADCSTREAM_Private_Constants
+  * @{
+  */
+#define ADCSTREAM_CR_RS_BITS (ADC_CR_ADCAL | ADC_CR_JADSTP | ADC_CR_ADSTP | ADC_CR_JADSTART | ADC_CR_ADSTART | ADC_CR_ADDIS | ADC_CR_ADEN) /*!< Bits in CR, die nur gesetzt werden dürfen */
+#define ADCSTREAM_SMP_47CYCLES 4U				/*!< Abtastzeit 47,5 ADC-Takte */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup ADCSTREAM_Private_Functions
+  * @{
+  */
+static void ADCSTREAM_SetControl(ADC_TypeDef *adc, uint32_t Bits);
+static void ADCSTREAM_Process(ADCSTREAM_TypeDef *hadcstream, const uint16_t *Samples);
+static uint16_t ADCSTREAM_Average(const uint16_t *Samples, uint8_t Shift);
+static void ADCSTREAM_SendLine(ADCSTREAM_TypeDef *hadcstream);
+static uint32_t ADCSTREAM_TimerClock(TIM_TypeDef *timer);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	weckt, kalibriert und konfiguriert den ADC, Wandlungen startet erst MYLIB_ADCSTREAM_Start()
+  * @param  hadcstream 	ADCSTREAM handle mit ausgefüllter Konfiguration
+  * @retval HAL status (HAL_TIMEOUT, wenn Kalibrierung oder Einschalten nicht fertig werden)
+  */
+HAL_StatusTypeDef MYLIB_ADCSTREAM_Init(ADCSTREAM_TypeDef *hadcstream){
+
+	ADC_TypeDef *adc = hadcstream->Init.Instance;
+	TIM_TypeDef *timer = hadcstream->Init.Timer;
+	DMA_Channel_TypeDef *channel = hadcstream->Init.Channel;
+	uint32_t tickstart;
+
+	if(ADCSTREAM_TimerClock(timer) % ADCSTREAM_COUNTER_CLOCK != 0U || hadcstream->Init.AdcChannel > 18){
+		return HAL_ERROR;
+	}
+
+	hadcstream->Running = 0;
+	hadcstream->Encoding = ENCODE_MODE_HEX;
+	hadcstream->hserialprot = NULL;
+
+	channel->CCR &= ~DMA_CCR_EN;
+	MYLIB_DMACHANNEL_SetRequest(channel, hadcstream->Init.DmaRequest);
+
+	/* ADC-Takt = HCLK / 1, kein asynchroner Takt nötig */
+	MODIFY_REG(ADC1_COMMON->CCR, ADC_CCR_CKMODE, ADC_CCR_CKMODE_0);
+
+	/* Deep-Power-Down verlassen, Spannungsregler einschalten (T_ADCVREG_STUP 20 µs) */
+	adc->CR &= ~(ADCSTREAM_CR_RS_BITS | ADC_CR_DEEPPWD);
+	adc->CR = (adc->CR & ~ADCSTREAM_CR_RS_BITS) | ADC_CR_ADVREGEN;
+	HAL_Delay(1);
+
+	/* Kalibrierung (single ended) */
+	adc->CR &= ~(ADCSTREAM_CR_RS_BITS | ADC_CR_ADCALDIF);
+	ADCSTREAM_SetControl(adc, ADC_CR_ADCAL);
+	tickstart = HAL_GetTick();
+	while(adc->CR & ADC_CR_ADCAL){
+		if(HAL_GetTick() - tickstart > 2U){
+			return HAL_TIMEOUT;
+		}
+	}
+
+	/* einschalten */
+	adc->ISR = ADC_ISR_ADRDY;
+	ADCSTREAM_SetControl(adc, ADC_CR_ADEN);
+	tickstart = HAL_GetTick();
+	while(!(adc->ISR & ADC_ISR_ADRDY)){
+		if(HAL_GetTick() - tickstart > 2U){
+			return HAL_TIMEOUT;
+		}
+	}
+
+	/* ein Kanal, 12 Bit, Start mit steigender Flanke des Triggers, DMA zirkulär, bei Überlauf überschreiben */
+	adc->SQR1 = hadcstream->Init.AdcChannel << ADC_SQR1_SQ1_Pos;
+	if(hadcstream->Init.AdcChannel < 10){
+		MODIFY_REG(adc->SMPR1, ADC_SMPR1_SMP0 << (hadcstream->Init.AdcChannel * 3U), ADCSTREAM_SMP_47CYCLES << (hadcstream->Init.AdcChannel * 3U));
+	}else{
+		MODIFY_REG(adc->SMPR2, ADC_SMPR2_SMP10 << ((hadcstream->Init.AdcChannel - 10U) * 3U), ADCSTREAM_SMP_47CYCLES << ((hadcstream->Init.AdcChannel - 10U) * 3U));
+	}
+	adc->CFGR = ADC_CFGR_EXTEN_0 | (hadcstream->Init.ExternalTrigger << ADC_CFGR_EXTSEL_Pos) | ADC_CFGR_OVRMOD
+				| ADC_CFGR_DMACFG | ADC_CFGR_DMAEN;
+
+	/* Timer: Update als TRGO, läuft erst ab Start */
+	timer->CR1 = TIM_CR1_URS;
+	timer->CR2 = TIM_CR2_MMS_1;
+	timer->DIER = 0;
+	timer->PSC = ADCSTREAM_TimerClock(timer) / ADCSTREAM_COUNTER_CLOCK - 1U;
+	timer->EGR = TIM_EGR_UG;
+	timer->SR = 0;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	startet Timer, Wandlungen und DMA, die Zeilennummer beginnt bei 0
+  * @param  hadcstream 	ADCSTREAM handle
+  * @param  PeriodUs 	Abtastperiode in µs (ADCSTREAM_PERIOD_MIN_US..ADCSTREAM_PERIOD_MAX_US)
+  * @param  Shift 		Mittelung über 2^Shift Abtastwerte (0..ADCSTREAM_SHIFT_MAX)
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_ADCSTREAM_Start(ADCSTREAM_TypeDef *hadcstream, uint16_t PeriodUs, uint8_t Shift){
+
+	ADC_TypeDef *adc = hadcstream->Init.Instance;
+	TIM_TypeDef *timer = hadcstream->Init.Timer;
+	DMA_Channel_TypeDef *channel = hadcstream->Init.Channel;
+
+	if(PeriodUs < ADCSTREAM_PERIOD_MIN_US || PeriodUs > ADCSTREAM_PERIOD_MAX_US || Shift > ADCSTREAM_SHIFT_MAX){
+		return HAL_ERROR;
+	}
+
+	MYLIB_ADCSTREAM_Stop(hadcstream);
+
+	hadcstream->Shift = Shift;
+	hadcstream->LineCount = 0;
+	hadcstream->Sequence = 0;
+	hadcstream->LinesSent = 0;
+	hadcstream->LinesDropped = 0;
+
+	/* DR -> Speicher, 16 Bit, zirkulär mit Halb- und Vollständig-Interrupt */
+	MYLIB_DMACHANNEL_ClearFlags(channel);
+	channel->CPAR = (uint32_t)&adc->DR;
+	channel->CMAR = (uint32_t)hadcstream->Buffer;
+	channel->CNDTR = 2 * ADCSTREAM_HALF_SIZE;
+	channel->CCR = DMA_CCR_PL_0 | DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_CIRC
+					| DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_TEIE;
+	channel->CCR |= DMA_CCR_EN;
+
+	/* ADSTART wartet auf den Trigger */
+	adc->ISR = ADC_ISR_OVR | ADC_ISR_EOC | ADC_ISR_EOS;
+	ADCSTREAM_SetControl(adc, ADC_CR_ADSTART);
+
+	hadcstream->Running = 1;
+	timer->ARR = PeriodUs - 1U;
+	timer->CNT = 0;
+	timer->CR1 |= TIM_CR1_CEN;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	hält Timer, Wandlungen und DMA an, eine angefangene Zeile wird verworfen
+  * @param  hadcstream 	ADCSTREAM handle
+  * @retval none
+  */
+void MYLIB_ADCSTREAM_Stop(ADCSTREAM_TypeDef *hadcstream){
+
+	ADC_TypeDef *adc = hadcstream->Init.Instance;
+
+	hadcstream->Init.Timer->CR1 &= ~TIM_CR1_CEN;
+	if(adc->CR & ADC_CR_ADSTART){
+		ADCSTREAM_SetControl(adc, ADC_CR_ADSTP);
+		/* die laufende Wandlung endet nach höchstens 60 ADC-Takten */
+		while(adc->CR & ADC_CR_ADSTP);
+	}
+	hadcstream->Init.Channel->CCR &= ~DMA_CCR_EN;
+	hadcstream->Running = 0;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos des ADC-Streams aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hadcstream 	ADCSTREAM handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_ADCSTREAM_Command(ADCSTREAM_TypeDef *hadcstream, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"ads") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"adx")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"ade") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"adq")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos haben zwei Zahlen als Parameter */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	/* Stream starten, "adq" ohne Zeilen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"ads") || __SERIALPROT_IS_COMMANDNAME(hserialprot,"adq")){
+		uint16_t period = atoi((char *)hserialprot->Parameter1);
+		uint16_t count = atoi((char *)hserialprot->Parameter2);
+		uint8_t shift = 0;
+
+		/* nur Zweierpotenzen, die Mittelung ist ein Schieben */
+		while(shift <= ADCSTREAM_SHIFT_MAX && (1U << shift) != count){
+			shift++;
+		}
+		hadcstream->hserialprot = __SERIALPROT_IS_COMMANDNAME(hserialprot,"ads") ? hserialprot : NULL;
+		if(MYLIB_ADCSTREAM_Start(hadcstream, period, shift) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa((uint32_t)period << shift, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Format der Zeilen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"ade")){
+		uint16_t encoding = atoi((char *)hserialprot->Parameter1);
+
+		if(hadcstream->Running || encoding > ENCODE_MODE_DELTA_LZ){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hadcstream->Encoding = (ENCODE_ModeTypeDef)encoding;
+		utoa(encoding, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Stream anhalten */
+	}else{
+		MYLIB_ADCSTREAM_Stop(hadcstream);
+		utoa(hadcstream->LinesSent, (char *)Result, 10);
+		strcat((char *)Result, ",");
+		utoa(hadcstream->LinesDropped, (char *)Result + strlen((char *)Result), 10);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des DMA-Kanals aufzurufen: mittelt die jeweils fertige Pufferhälfte
+  * @param  hadcstream 	ADCSTREAM handle
+  * @retval none
+  */
+void MYLIB_ADCSTREAM_DMA_IRQHandler(ADCSTREAM_TypeDef *hadcstream){
+
+	DMA_Channel_TypeDef *channel = hadcstream->Init.Channel;
+	uint32_t flags = MYLIB_DMACHANNEL_GetFlags(channel);
+
+	if(!hadcstream->Running){
+		return;
+	}
+
+	if(flags & DMA_ISR_TEIF1){
+		/* Übertragungsfehler: der Kanal wurde von der DMA abgeschaltet */
+		MYLIB_ADCSTREAM_Stop(hadcstream);
+		if(hadcstream->hserialprot != NULL){
+			MYLIB_SERIALPROT_Event(hadcstream->hserialprot, (uint8_t *)"ad,err");
+		}
+		return;
+	}
+
+	if(flags & DMA_ISR_HTIF1){
+		ADCSTREAM_Process(hadcstream, &hadcstream->Buffer[0]);
+	}
+	if(flags & DMA_ISR_TCIF1){
+		ADCSTREAM_Process(hadcstream, &hadcstream->Buffer[ADCSTREAM_HALF_SIZE]);
+	}
+}
+
+/**
+  * @brief  Funktion 	Callback für jeden gemittelten Wert, wird im Interrupt des DMA-Kanals aufgerufen
+  * @param  hadcstream 	ADCSTREAM handle
+  * @param  Value 		Mittelwert (12 Bit)
+  * @retval none
+  */
+__weak void ADCSTREAM_Value_Callback(ADCSTREAM_TypeDef *hadcstream, uint16_t Value)
+{
+	/* Prevent unused argument(s) compilation warning */
+	UNUSED(hadcstream);
+	UNUSED(Value);
+
+	/* NOTE : This function should not be modified, when the callback is needed,
+            	the ADCSTREAM_Value_Callback could be implemented in the user file
+	 */
+}
+
+/**
+  * @brief  Funktion 	setzt Bits in ADC->CR, ohne die übrigen nur setzbaren Bits erneut zu schreiben
+  * @param  adc 		ADC
+  * @param  Bits 		zu setzende Bits
+  * @retval none
+  */
+static void ADCSTREAM_SetControl(ADC_TypeDef *adc, uint32_t Bits){
+
+	adc->CR = (adc->CR & ~ADCSTREAM_CR_RS_BITS) | Bits;
+}
+
+/**
+  * @brief  Funktion 	mittelt eine Pufferhälfte und hängt die Mittelwerte an die Zeile an, volle Zeilen werden gesendet
+  * @param  hadcstream 	ADCSTREAM handle
+  * @param  Samples 	ADCSTREAM_HALF_SIZE Abtastwerte
+  * @retval none
+  */
+static void ADCSTREAM_Process(ADCSTREAM_TypeDef *hadcstream, const uint16_t *Samples){
+
+	uint8_t step = 1U << hadcstream->Shift;
+	uint8_t samples = (hadcstream->Encoding == ENCODE_MODE_HEX) ? ADCSTREAM_LINE_SAMPLES : ADCSTREAM_LINE_SAMPLES_PACKED;
+
+	for(uint8_t i=0; i<ADCSTREAM_HALF_SIZE; i+=step){
+		uint16_t value = ADCSTREAM_Average(&Samples[i], hadcstream->Shift);
+
+		ADCSTREAM_Value_Callback(hadcstream, value);
+		hadcstream->Line[hadcstream->LineCount++] = value;
+		if(hadcstream->LineCount == samples){
+			ADCSTREAM_SendLine(hadcstream);
+			hadcstream->LineCount = 0;
+		}
+	}
+}
+
+/**
+  * @brief  Funktion 	mittelt 2^Shift Abtastwerte, je Befehl werden zwei 16-Bit-Werte eines Worts addiert (SIMD)
+  * @param  Samples 	Abtastwerte, an 4 Byte ausgerichtet
+  * @param  Shift 		Mittelung über 2^Shift Abtastwerte
+  * @retval Mittelwert
+  */
+static uint16_t ADCSTREAM_Average(const uint16_t *Samples, uint8_t Shift){
+
+	const uint32_t *pair = (const uint32_t *)Samples;
+	uint32_t sum = 0;
+
+	if(Shift == 0){
+		return Samples[0];
+	}
+
+	/* __SMLAD: sum + unteres * 1 + oberes * 1, 12-Bit-Werte bleiben als vorzeichenbehaftete Halbworte positiv */
+	for(uint8_t i=0; i<(1U << (Shift - 1U)); i++){
+		sum = __SMLAD(pair[i], 0x00010001U, sum);
+	}
+	return sum >> Shift;
+}
+
+/**
+  * @brief  Funktion 	sendet die Zeile als Meldung "=> #e,ad,<nr>,<werte>" bzw. gepackt "=> #e,az,<nr>,<m>,<daten>"
+  * @param  hadcstream 	ADCSTREAM handle
+  * @retval none
+  */
+static void ADCSTREAM_SendLine(ADCSTREAM_TypeDef *hadcstream){
+
+	static const char digits[] = "0123456789ABCDEF";
+	uint8_t event[12 + ENCODE_TEXT_MAX] = "ad,";
+	uint8_t *pos = event + 3;
+	uint16_t sequence = hadcstream->Sequence++;
+
+	if(hadcstream->hserialprot == NULL){
+		return;
+	}
+
+	if(hadcstream->Encoding != ENCODE_MODE_HEX){
+		event[1] = 'z';
+	}
+	for(int8_t d=3; d>=0; d--){
+		pos[d] = digits[sequence & 0x0F];
+		sequence >>= 4;
+	}
+	pos += 4;
+	*pos++ = ',';
+
+	if(hadcstream->Encoding == ENCODE_MODE_HEX){
+		/* je Wert 3 Hex-Stellen */
+		for(uint8_t i=0; i<ADCSTREAM_LINE_SAMPLES; i++){
+			uint16_t value = hadcstream->Line[i];
+			pos[0] = digits[(value >> 8) & 0x0F];
+			pos[1] = digits[(value >> 4) & 0x0F];
+			pos[2] = digits[value & 0x0F];
+			pos += 3;
+		}
+		*pos = 0;
+	}else{
+		ENCODE_TypeDef encode;
+
+		/* 12-Bit-Werte: jede Differenz passt in 2 Varint-Bytes, die Zeile in ENCODE_BYTES_MAX */
+		MYLIB_ENCODE_Begin(&encode, hadcstream->Encoding, 1);
+		for(uint8_t i=0; i<ADCSTREAM_LINE_SAMPLES_PACKED; i++){
+			MYLIB_ENCODE_Put(&encode, hadcstream->Line[i]);
+		}
+		*pos++ = digits[hadcstream->Encoding];
+		*pos++ = ',';
+		MYLIB_ENCODE_End(&encode, (char *)pos);
+	}
+
+	if(MYLIB_SERIALPROT_Event(hadcstream->hserialprot, event) == HAL_OK){
+		hadcstream->LinesSent++;
+	}else{
+		hadcstream->LinesDropped++;
+	}
+}
+
+/**
+  * @brief  Funktion 	liefert den Takt eines Timers (APB1 oder APB2, Vorteiler 1)
+  * @param  timer 		Timer
+  * @retval Takt in Hz
+  */
+static uint32_t ADCSTREAM_TimerClock(TIM_TypeDef *timer){
+
+	return ((uint32_t)timer >= APB2PERIPH_BASE) ? HAL_RCC_GetPCLK2Freq() : HAL_RCC_GetPCLK1Freq();
+}
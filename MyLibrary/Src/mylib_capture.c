@@ -0,0 +1,489 @@
+/**
+******************************************************************************
+* @file mylib_capture.c
+* @author Reiter Roman
+* @brief mylib-Ringaufzeichnung.
+* Diese Datei zeichnet eine Quelle fortlaufend in einen Ring im RAM auf und lädt nur das Fenster um ein Ereignis hoch:
+* + Quellen: Eingangsregister eines Ports (je CAPTURE_TICK_US abgetastet), Mittelwerte des ADC-Streams
+*   oder die empfangenen Zeichen des seriellen Protokolls, wahlweise nur jeder n-te Wert
+* + Scharf geschaltet läuft der Ring ohne Übertragung, bis die Triggerbedingung erfüllt ist (Schwelle steigend
+*   oder fallend, gleicher Wert, Bitwechsel) oder der Trigger per Kommando ausgelöst wird
+* + Nach dem Nachlauf wird der Ring eingefroren und das Fenster (Vorlauf + Nachlauf) Zeile für Zeile hochgeladen,
+*   eine volle Sendewarteschlange verzögert das Hochladen nur, es gehen keine Werte verloren
+* + Takt der GPIO-Abtastung und des Hochladens ist Kanal 3 des Timers der Gerätezeit (Vergleich, kein Pin)
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Der Timer läuft bereits als Gerätezeit mit 1 MHz (mylib_scheduler), Kanal 3 ist frei,
+			sein Interrupt ist freigegeben (Priorität 0 wie die Transportschichten)
+
+	(#) Konfiguration eintragen und die Aufzeichnung initialisieren (nach MYLIB_SCHEDULER_Init())
+		(+++) z.B.: hcapture.Init.Timer = TIM2; hcapture.Init.Port = GPIOA;
+		(+++) z.B.: MYLIB_CAPTURE_Init(&hcapture);
+
+	(#) Interrupt des Timers weiterreichen (neben dem Scheduler, jeder prüft nur seinen Kanal)
+		(+++) TIM2_IRQHandler ()  -> MYLIB_CAPTURE_IRQHandler(&hcapture)
+
+	(#) Werte der übrigen Quellen aus deren Callbacks übergeben
+		(+++) z.B.: void ADCSTREAM_Value_Callback(ADCSTREAM_TypeDef *hadcstream, uint16_t Value)
+		(+++)       { MYLIB_CAPTURE_Add(&hcapture, CAPTURE_SOURCE_ADC, Value); }
+		(+++) z.B.: void SERIALPROT_RxByte_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Byte)
+		(+++)       { if(hserialprot->Transport != NULL) MYLIB_CAPTURE_Add(&hcapture, CAPTURE_SOURCE_RX, Byte); }
+		(+) Instanzen ohne Transportschicht (intern bei Modbus, Skript und Makro) werden nicht aufgezeichnet
+		(+) Werte anderer als der gewählten Quelle werden ignoriert
+		(+) MYLIB_CAPTURE_Add() darf nur aus Interrupts mit der Priorität der Transportschichten aufgerufen werden,
+			es sendet selbst nichts (auch nicht mitten in der Antwort einer Instanz), das Hochladen beginnt im nächsten Takt
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen (alle Werte dezimal)
+		(+++) z.B.: return MYLIB_CAPTURE_Command(&hcapture, hserialprot, Result);
+		(+) "#cps,<quelle>:<n>"     Quelle 0 GPIO, 1 ADC, 2 empfangene Zeichen, nur jeder n-te Wert (1..CAPTURE_DIVIDER_MAX),
+			"=> #a,<quelle>,<n>"
+		(+) "#cpt,<art>:<level>"    Trigger: 0 steigend über level, 1 fallend unter level, 2 gleich level,
+			3 Bit level wechselt (0..15), 4 nur per "cpf", "=> #a,<art>,<level>"
+		(+) "#cpe,<m>:0"            Format der Zeilen: 0 Hex, 1 Delta + Varint, 2 Delta + Varint + LZ, "=> #a,<m>"
+		(+) "#cpa,<vor>:<nach>"     schaltet scharf, vor + nach <= CAPTURE_SIZE, nach >= 1, "=> #a,<vor + nach>"
+		(+) "#cpf,0:0"              löst den Trigger sofort aus, der nächste Wert ist der erste des Nachlaufs
+		(+) "#cpx,0:0"              bricht ab, "=> #a,<zustand>,<werte im ring>" (Zustand vor dem Abbruch:
+			0 aus, 1 scharf, 2 Nachlauf, 3 Hochladen)
+		(+) "cps", "cpt" und "cpe" nur ohne laufende Aufzeichnung, sonst NACK
+		(+) Bei der Quelle ADC muss der ADC-Stream laufen, "#adq,<us>:<n>" startet ihn ohne eigene Zeilen
+
+	(#) Meldungen an die Instanz von "cpa", Werte je 4 Hex-Stellen, nr = Index des ersten Werts im Fenster (4 Hex-Stellen)
+		(+) "=> #e,cp,h,<quelle>,<vor>,<nach>,<zeit>"  Kopf: tatsächliche Werte vor dem Trigger,
+			Werte ab dem Trigger (der Trigger ist Index <vor>), Gerätezeit des Triggers in µs
+		(+) "=> #e,cp,d,<nr>,<werte>"        CAPTURE_LINE_VALUES Werte je Zeile (Format 0)
+		(+) "=> #e,cp,z,<nr>,<m>,<daten>"    CAPTURE_LINE_VALUES_PACKED Werte je Zeile gepackt (Format 1 und 2),
+			Tools/encode_decode.c macht am Host wieder "cp,d"-Zeilen daraus
+		(+) "=> #e,cp,end,<n>"               Fenster vollständig hochgeladen, danach ist die Aufzeichnung aus
+
+	(#) Grenzen
+		(+) Die Quelle GPIO wird nur alle CAPTURE_TICK_US abgetastet, schnellere Signale mit mylib_logic
+		(+) Wird der Interrupt länger als einen Takt blockiert, entfallen die verpassten Abtastungen, der Takt läuft danach weiter
+		(+) Es wird je Takt eine Zeile gesendet, ein volles Fenster im Hex-Format braucht bei 115200 Baud etwa 0,5 s
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_capture.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/** @defgroup CAPTURE_Private_Constants
+  * @{
+  */
+#define CAPTURE_MASK (CAPTURE_SIZE - 1U)		/*!< Index im Ring */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup CAPTURE_Private_Functions
+  * @{
+  */
+static uint8_t CAPTURE_IsTrigger(CAPTURE_TypeDef *hcapture, uint16_t Value);
+static void CAPTURE_Fire(CAPTURE_TypeDef *hcapture);
+static void CAPTURE_Freeze(CAPTURE_TypeDef *hcapture);
+static void CAPTURE_Upload(CAPTURE_TypeDef *hcapture);
+static HAL_StatusTypeDef CAPTURE_SendLine(CAPTURE_TypeDef *hcapture, uint16_t Index, uint16_t Count);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet Kanal 3 des Timers als Vergleich ein, Quelle GPIO ohne Teiler, Trigger nur per Kommando
+  * @param  hcapture 	CAPTURE handle mit ausgefüllter Konfiguration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_CAPTURE_Init(CAPTURE_TypeDef *hcapture){
+
+	TIM_TypeDef *timer = hcapture->Init.Timer;
+
+	if(!IS_TIM_32B_COUNTER_INSTANCE(timer)){
+		return HAL_ERROR;
+	}
+
+	hcapture->State = CAPTURE_STATE_IDLE;
+	hcapture->Source = CAPTURE_SOURCE_GPIO;
+	hcapture->Divider = 1;
+	hcapture->Trigger = CAPTURE_TRIGGER_MANUAL;
+	hcapture->Level = 0;
+	hcapture->Encoding = ENCODE_MODE_HEX;
+	hcapture->Count = 0;
+	hcapture->hserialprot = NULL;
+
+	/* Kanal 3 als reiner Vergleich (Frozen, kein Pin), der Interrupt läuft nur während einer Aufzeichnung */
+	timer->DIER &= ~TIM_DIER_CC3IE;
+	timer->CCMR2 &= ~(TIM_CCMR2_CC3S | TIM_CCMR2_OC3M | TIM_CCMR2_OC3PE);
+	timer->SR = ~TIM_SR_CC3IF;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	leert den Ring und schaltet die Aufzeichnung scharf
+  * @param  hcapture 	CAPTURE handle
+  * @param  Pre 		gewünschte Werte vor dem Trigger
+  * @param  Post 		Werte ab dem Trigger (mindestens 1, Pre + Post <= CAPTURE_SIZE)
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_CAPTURE_Arm(CAPTURE_TypeDef *hcapture, uint16_t Pre, uint16_t Post){
+
+	TIM_TypeDef *timer = hcapture->Init.Timer;
+
+	if(Post == 0 || (uint32_t)Pre + Post > CAPTURE_SIZE){
+		return HAL_ERROR;
+	}
+
+	MYLIB_CAPTURE_Stop(hcapture);
+
+	hcapture->Pre = Pre;
+	hcapture->Post = Post;
+	hcapture->Head = 0;
+	hcapture->Count = 0;
+	hcapture->DividerCount = 0;
+	hcapture->Sent = 0;
+	hcapture->HeaderSent = 0;
+	hcapture->State = CAPTURE_STATE_ARMED;
+
+	/* Takt für GPIO-Abtastung und Hochladen */
+	timer->CCR3 = timer->CNT + CAPTURE_TICK_US;
+	timer->SR = ~TIM_SR_CC3IF;
+	timer->DIER |= TIM_DIER_CC3IE;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	löst den Trigger sofort aus, der nächste Wert der Quelle ist der erste des Nachlaufs
+  * @param  hcapture 	CAPTURE handle
+  * @retval HAL status (HAL_ERROR, wenn die Aufzeichnung nicht scharf ist)
+  */
+HAL_StatusTypeDef MYLIB_CAPTURE_Force(CAPTURE_TypeDef *hcapture){
+
+	if(hcapture->State != CAPTURE_STATE_ARMED){
+		return HAL_ERROR;
+	}
+	CAPTURE_Fire(hcapture);
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	beendet Aufzeichnung bzw. Hochladen sofort, der Ring bleibt erhalten
+  * @param  hcapture 	CAPTURE handle
+  * @retval none
+  */
+void MYLIB_CAPTURE_Stop(CAPTURE_TypeDef *hcapture){
+
+	hcapture->Init.Timer->DIER &= ~TIM_DIER_CC3IE;
+	hcapture->State = CAPTURE_STATE_IDLE;
+}
+
+/**
+  * @brief  Funktion 	nimmt einen Wert einer Quelle auf, prüft den Trigger und friert den Ring nach dem Nachlauf ein
+  * @param  hcapture 	CAPTURE handle
+  * @param  Source 		Quelle des Werts, Werte anderer Quellen werden ignoriert
+  * @param  Value 		Wert
+  * @retval none
+  */
+void MYLIB_CAPTURE_Add(CAPTURE_TypeDef *hcapture, CAPTURE_SourceTypeDef Source, uint16_t Value){
+
+	if(Source != hcapture->Source
+			|| (hcapture->State != CAPTURE_STATE_ARMED && hcapture->State != CAPTURE_STATE_TRIGGERED)){
+		return;
+	}
+
+	if(++hcapture->DividerCount < hcapture->Divider){
+		return;
+	}
+	hcapture->DividerCount = 0;
+
+	/* der auslösende Wert ist der erste des Nachlaufs */
+	if(hcapture->State == CAPTURE_STATE_ARMED && CAPTURE_IsTrigger(hcapture, Value)){
+		CAPTURE_Fire(hcapture);
+	}
+
+	hcapture->Previous = Value;
+	hcapture->Ring[hcapture->Head] = Value;
+	hcapture->Head = (hcapture->Head + 1U) & CAPTURE_MASK;
+	if(hcapture->Count < CAPTURE_SIZE){
+		hcapture->Count++;
+	}
+
+	if(hcapture->State == CAPTURE_STATE_TRIGGERED && --hcapture->PostRemaining == 0){
+		CAPTURE_Freeze(hcapture);
+	}
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos der Ringaufzeichnung aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hcapture 	CAPTURE handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_CAPTURE_Command(CAPTURE_TypeDef *hcapture, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"cps") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpt")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpe") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpa")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpf") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpx")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos der Ringaufzeichnung haben zwei Zahlen als Parameter */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	uint16_t param1 = atoi((char *)hserialprot->Parameter1);
+	uint16_t param2 = atoi((char *)hserialprot->Parameter2);
+	uint8_t idle = (hcapture->State == CAPTURE_STATE_IDLE);
+
+	/* Quelle */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"cps")){
+		if(!idle || param1 > CAPTURE_SOURCE_RX || param2 == 0 || param2 > CAPTURE_DIVIDER_MAX){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hcapture->Source = (CAPTURE_SourceTypeDef)param1;
+		hcapture->Divider = param2;
+		utoa(param1, (char *)Result, 10);
+		strcat((char *)Result, ",");
+		utoa(param2, (char *)Result + strlen((char *)Result), 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Triggerbedingung */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpt")){
+		if(!idle || param1 > CAPTURE_TRIGGER_MANUAL || (param1 == CAPTURE_TRIGGER_BIT && param2 > 15)){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hcapture->Trigger = (CAPTURE_TriggerTypeDef)param1;
+		hcapture->Level = param2;
+		utoa(param1, (char *)Result, 10);
+		strcat((char *)Result, ",");
+		utoa(param2, (char *)Result + strlen((char *)Result), 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Format der Zeilen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpe")){
+		if(!idle || param1 > ENCODE_MODE_DELTA_LZ){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hcapture->Encoding = (ENCODE_ModeTypeDef)param1;
+		utoa(param1, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* scharf schalten */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpa")){
+		hcapture->hserialprot = hserialprot;
+		if(MYLIB_CAPTURE_Arm(hcapture, param1, param2) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa((uint32_t)param1 + param2, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Trigger auslösen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"cpf")){
+		return (MYLIB_CAPTURE_Force(hcapture) == HAL_OK) ? SERIALPROT_COMMAND_OK : SERIALPROT_COMMAND_INVALID;
+
+	/* abbrechen */
+	}else{
+		utoa(hcapture->State, (char *)Result, 10);
+		strcat((char *)Result, ",");
+		utoa(hcapture->Count, (char *)Result + strlen((char *)Result), 10);
+		MYLIB_CAPTURE_Stop(hcapture);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des Timers aufzurufen: tastet den Port ab bzw. lädt die nächste Zeile hoch
+  * @param  hcapture 	CAPTURE handle
+  * @retval none
+  */
+void MYLIB_CAPTURE_IRQHandler(CAPTURE_TypeDef *hcapture){
+
+	TIM_TypeDef *timer = hcapture->Init.Timer;
+
+	if(!(timer->SR & TIM_SR_CC3IF) || !(timer->DIER & TIM_DIER_CC3IE)){
+		return;
+	}
+	timer->SR = ~TIM_SR_CC3IF;
+	timer->CCR3 += CAPTURE_TICK_US;
+	/* mehr als einen Takt zu spät (z.B. während "mcs" die Flash-Seite löscht): der neue Vergleich läge schon
+	   zurück und käme erst nach dem Überlauf des Timers, darum ab jetzt neu takten, die verpassten Takte entfallen */
+	if((int32_t)(timer->CCR3 - timer->CNT) <= 0){
+		timer->CCR3 = timer->CNT + CAPTURE_TICK_US;
+	}
+
+	if(hcapture->State == CAPTURE_STATE_UPLOAD){
+		CAPTURE_Upload(hcapture);
+	}else{
+		MYLIB_CAPTURE_Add(hcapture, CAPTURE_SOURCE_GPIO, hcapture->Init.Port->IDR);
+	}
+}
+
+/**
+  * @brief  Funktion 	prüft die Triggerbedingung mit dem vorherigen und dem neuen Wert
+  * @param  hcapture 	CAPTURE handle
+  * @param  Value 		neuer Wert
+  * @retval 1 wenn der Trigger auslöst, sonst 0
+  */
+static uint8_t CAPTURE_IsTrigger(CAPTURE_TypeDef *hcapture, uint16_t Value){
+
+	/* Flanken brauchen einen Vorgänger */
+	if(hcapture->Count == 0 && hcapture->Trigger != CAPTURE_TRIGGER_EQUAL){
+		return 0;
+	}
+
+	switch(hcapture->Trigger){
+	case CAPTURE_TRIGGER_RISING:
+		return hcapture->Previous < hcapture->Level && Value >= hcapture->Level;
+	case CAPTURE_TRIGGER_FALLING:
+		return hcapture->Previous >= hcapture->Level && Value < hcapture->Level;
+	case CAPTURE_TRIGGER_EQUAL:
+		return Value == hcapture->Level;
+	case CAPTURE_TRIGGER_BIT:
+		return ((hcapture->Previous ^ Value) >> hcapture->Level) & 1U;
+	default:
+		return 0;
+	}
+}
+
+/**
+  * @brief  Funktion 	merkt Vorlauf und Zeitpunkt des Triggers, ab jetzt wird der Nachlauf gezählt
+  * @param  hcapture 	CAPTURE handle
+  * @retval none
+  */
+static void CAPTURE_Fire(CAPTURE_TypeDef *hcapture){
+
+	hcapture->PreCaptured = (hcapture->Count < hcapture->Pre) ? hcapture->Count : hcapture->Pre;
+	hcapture->PostRemaining = hcapture->Post;
+	hcapture->TriggerTime = hcapture->Init.Timer->CNT;
+	hcapture->State = CAPTURE_STATE_TRIGGERED;
+}
+
+/**
+  * @brief  Funktion 	friert das Fenster ein, das Hochladen beginnt im nächsten Takt von Kanal 3
+  * @note   Wird aus MYLIB_CAPTURE_Add() und damit auch aus SERIALPROT_RxByte_Callback() aufgerufen, während die
+  *         Instanz gerade eine Antwort in ihre Sendewarteschlange schreibt, darum hier keine Meldung senden
+  * @param  hcapture 	CAPTURE handle
+  * @retval none
+  */
+static void CAPTURE_Freeze(CAPTURE_TypeDef *hcapture){
+
+	hcapture->Length = hcapture->PreCaptured + hcapture->Post;
+	hcapture->Start = (hcapture->Head - hcapture->Length) & CAPTURE_MASK;
+	hcapture->Sent = 0;
+	hcapture->HeaderSent = 0;
+	hcapture->State = CAPTURE_STATE_UPLOAD;
+}
+
+/**
+  * @brief  Funktion 	sendet die nächste Zeile des Fensters (Kopf, Werte, Ende), bei voller Warteschlange im nächsten Takt erneut
+  * @param  hcapture 	CAPTURE handle
+  * @retval none
+  */
+static void CAPTURE_Upload(CAPTURE_TypeDef *hcapture){
+
+	uint8_t event[40];
+	uint16_t count;
+
+	if(hcapture->hserialprot == NULL){
+		MYLIB_CAPTURE_Stop(hcapture);
+		return;
+	}
+
+	/* Kopf */
+	if(!hcapture->HeaderSent){
+		strcpy((char *)event, "cp,h,");
+		utoa(hcapture->Source, (char *)event + strlen((char *)event), 10);
+		strcat((char *)event, ",");
+		utoa(hcapture->PreCaptured, (char *)event + strlen((char *)event), 10);
+		strcat((char *)event, ",");
+		utoa(hcapture->Post, (char *)event + strlen((char *)event), 10);
+		strcat((char *)event, ",");
+		utoa(hcapture->TriggerTime, (char *)event + strlen((char *)event), 10);
+		if(MYLIB_SERIALPROT_Event(hcapture->hserialprot, event) == HAL_OK){
+			hcapture->HeaderSent = 1;
+		}
+		return;
+	}
+
+	/* Werte */
+	if(hcapture->Sent < hcapture->Length){
+		count = (hcapture->Encoding == ENCODE_MODE_HEX) ? CAPTURE_LINE_VALUES : CAPTURE_LINE_VALUES_PACKED;
+		if(count > hcapture->Length - hcapture->Sent){
+			count = hcapture->Length - hcapture->Sent;
+		}
+		if(CAPTURE_SendLine(hcapture, hcapture->Sent, count) == HAL_OK){
+			hcapture->Sent += count;
+		}
+		return;
+	}
+
+	/* Ende */
+	strcpy((char *)event, "cp,end,");
+	utoa(hcapture->Length, (char *)event + strlen((char *)event), 10);
+	if(MYLIB_SERIALPROT_Event(hcapture->hserialprot, event) == HAL_OK){
+		MYLIB_CAPTURE_Stop(hcapture);
+	}
+}
+
+/**
+  * @brief  Funktion 	sendet Werte des Fensters als Meldung "=> #e,cp,d,<nr>,<werte>" bzw. gepackt "=> #e,cp,z,<nr>,<m>,<daten>"
+  * @param  hcapture 	CAPTURE handle
+  * @param  Index 		Index des ersten Werts im Fenster
+  * @param  Count 		Anzahl der Werte (max. CAPTURE_LINE_VALUES bzw. CAPTURE_LINE_VALUES_PACKED)
+  * @retval HAL status (HAL_BUSY, wenn die Sendewarteschlange voll ist)
+  */
+static HAL_StatusTypeDef CAPTURE_SendLine(CAPTURE_TypeDef *hcapture, uint16_t Index, uint16_t Count){
+
+	static const char digits[] = "0123456789ABCDEF";
+	uint8_t event[16 + ENCODE_TEXT_MAX] = "cp,d,";
+	uint8_t *pos = event + 5;
+	uint16_t number = Index;
+
+	if(hcapture->Encoding != ENCODE_MODE_HEX){
+		event[3] = 'z';
+	}
+	for(int8_t d=3; d>=0; d--){
+		pos[d] = digits[number & 0x0F];
+		number >>= 4;
+	}
+	pos += 4;
+	*pos++ = ',';
+
+	if(hcapture->Encoding == ENCODE_MODE_HEX){
+		/* je Wert 4 Hex-Stellen */
+		for(uint16_t i=0; i<Count; i++){
+			uint16_t value = hcapture->Ring[(hcapture->Start + Index + i) & CAPTURE_MASK];
+			for(int8_t d=3; d>=0; d--){
+				pos[d] = digits[value & 0x0F];
+				value >>= 4;
+			}
+			pos += 4;
+		}
+		*pos = 0;
+	}else{
+		ENCODE_TypeDef encode;
+
+		/* 16-Bit-Werte: jede Differenz passt in 3 Varint-Bytes, die Zeile in ENCODE_BYTES_MAX */
+		MYLIB_ENCODE_Begin(&encode, hcapture->Encoding, 1);
+		for(uint16_t i=0; i<Count; i++){
+			MYLIB_ENCODE_Put(&encode, hcapture->Ring[(hcapture->Start + Index + i) & CAPTURE_MASK]);
+		}
+		*pos++ = digits[hcapture->Encoding];
+		*pos++ = ',';
+		MYLIB_ENCODE_End(&encode, (char *)pos);
+	}
+
+	return MYLIB_SERIALPROT_Event(hcapture->hserialprot, event);
+}
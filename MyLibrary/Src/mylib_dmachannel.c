@@ -0,0 +1,113 @@
+/**
+******************************************************************************
+* @file mylib_dmachannel.c
+* @author Reiter Roman
+* @brief mylib-DMA-Kanal.
+* Diese Datei fasst die Zugriffe auf die gemeinsamen Register des DMA-Controllers für die Module zusammen,
+* die ihre DMA-Kanäle ohne den HAL-DMA-Treiber direkt über CCR/CNDTR/CPAR/CMAR betreiben:
+* + Request eines Kanals in CSELR auswählen
+* + Flags eines Kanals in ISR/IFCR lesen und löschen (4 Bit je Kanal: GIF, TCIF, HTIF, TEIF)
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Request einmal bei der Initialisierung auswählen (Kanal abgeschaltet)
+		(+++) z.B.: MYLIB_DMACHANNEL_SetRequest(DMA2_Channel4, 3);
+
+	(#) Vor dem Einschalten des Kanals alte Flags löschen
+		(+++) z.B.: MYLIB_DMACHANNEL_ClearFlags(channel);
+
+	(#) Im Interrupt des Kanals die Flags lesen und löschen, das Ergebnis liegt an der Position von Kanal 1
+		(+++) z.B.: uint32_t flags = MYLIB_DMACHANNEL_GetFlags(channel);
+		(+++) z.B.: if(flags & DMA_ISR_TCIF1){ ... }
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_dmachannel.h"
+
+/* Private define ------------------------------------------------------------*/
+/** @addtogroup DMACHANNEL_Private_Define
+  * @{
+  */
+#define DMACHANNEL_FLAGS 0xFUL					/*!< GIF, TCIF, HTIF, TEIF eines Kanals im ISR/IFCR, Feldbreite in CSELR */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup DMACHANNEL_Private_Functions
+  * @{
+  */
+static DMA_TypeDef * DMACHANNEL_Base(DMA_Channel_TypeDef *Channel);
+static uint32_t DMACHANNEL_Shift(DMA_Channel_TypeDef *Channel);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	wählt den DMA-Request eines Kanals in CSELR aus (nur bei abgeschaltetem Kanal)
+  * @param  Channel 	DMA-Kanal
+  * @param  Request 	Nummer des Requests laut Referenzhandbuch (0..7)
+  * @retval none
+  */
+void MYLIB_DMACHANNEL_SetRequest(DMA_Channel_TypeDef *Channel, uint32_t Request){
+
+	DMA_Request_TypeDef *cselr = (DMACHANNEL_Base(Channel) == DMA1) ? DMA1_CSELR : DMA2_CSELR;
+	uint32_t shift = DMACHANNEL_Shift(Channel);
+
+	MODIFY_REG(cselr->CSELR, DMACHANNEL_FLAGS << shift, Request << shift);
+}
+
+/**
+  * @brief  Funktion 	löscht alle Flags eines Kanals
+  * @param  Channel 	DMA-Kanal
+  * @retval none
+  */
+void MYLIB_DMACHANNEL_ClearFlags(DMA_Channel_TypeDef *Channel){
+
+	DMACHANNEL_Base(Channel)->IFCR = DMACHANNEL_FLAGS << DMACHANNEL_Shift(Channel);
+}
+
+/**
+  * @brief  Funktion 	liest und löscht die gesetzten Flags eines Kanals
+  * @param  Channel 	DMA-Kanal
+  * @retval Flags an der Position von Kanal 1 (DMA_ISR_GIF1, DMA_ISR_TCIF1, DMA_ISR_HTIF1, DMA_ISR_TEIF1)
+  */
+uint32_t MYLIB_DMACHANNEL_GetFlags(DMA_Channel_TypeDef *Channel){
+
+	DMA_TypeDef *dma = DMACHANNEL_Base(Channel);
+	uint32_t shift = DMACHANNEL_Shift(Channel);
+	uint32_t flags = (dma->ISR >> shift) & DMACHANNEL_FLAGS;
+
+	/* nur die gelesenen Flags löschen, später gesetzte lösen den Interrupt erneut aus */
+	dma->IFCR = flags << shift;
+	return flags;
+}
+
+/**
+  * @brief  Funktion 	liefert den DMA-Controller eines Kanals
+  * @param  Channel 	DMA-Kanal
+  * @retval DMA-Controller
+  */
+static DMA_TypeDef * DMACHANNEL_Base(DMA_Channel_TypeDef *Channel){
+
+	return ((uint32_t)Channel < (uint32_t)DMA2_Channel1) ? DMA1 : DMA2;
+}
+
+/**
+  * @brief  Funktion 	liefert die Bitposition eines Kanals in ISR/IFCR/CSELR (4 Bit je Kanal)
+  * @param  Channel 	DMA-Kanal
+  * @retval Bitposition
+  */
+static uint32_t DMACHANNEL_Shift(DMA_Channel_TypeDef *Channel){
+
+	uint32_t first = (DMACHANNEL_Base(Channel) == DMA1) ? (uint32_t)DMA1_Channel1 : (uint32_t)DMA2_Channel1;
+
+	return (((uint32_t)Channel - first) / ((uint32_t)DMA1_Channel2 - (uint32_t)DMA1_Channel1)) * 4U;
+}
@@ -0,0 +1,264 @@
+/**
+******************************************************************************
+* @file mylib_edgecapture.c
+* @author Reiter Roman
+* @brief mylib-Flankenerfassung.
+* Diese Datei zeichnet Flanken schneller digitaler Eingänge auf, ohne dass der Host jeden Pin einzeln abfragen muss:
+* + Die Eingänge einer konstanten Tabelle lösen bei jeder Flanke einen EXTI-Interrupt aus
+* + Der Interrupt liest als Erstes den DWT-Zyklenzähler und legt Zeitstempel, Eingang und Pegel in einen Ring
+* + Der Ring hat genau einen Schreiber (Interrupt) und einen Leser (Kommando) und kommt ohne Sperre aus
+* + Ein Kommando leert bis zu EDGECAPTURE_DRAIN_MAX Ereignisse in einer gepackten Antwort, ein weiteres liest GPIOA und GPIOB auf einmal
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Takt der Ports eingeschaltet, EXTI-Interrupts der verwendeten Leitungen mit der Priorität der
+			Transportschichten (0) freigeben, damit Kommandos und Flanken sich nicht unterbrechen
+		(+) Je EXTI-Leitung nur ein Pin (PA5 und PB5 teilen sich EXTI5), Leitung 0 gehört der SPI-NSS
+
+	(#) Tabelle der Eingänge als const anlegen (liegt im Flash), z.B.:
+		(+++) static const EDGECAPTURE_InputTypeDef EdgeTable[] = {
+		(+++)     {"ea", GPIOA, GPIO_PIN_3, GPIO_PULLDOWN},
+		(+++) };
+
+	(#) Eingänge initialisieren, ab jetzt wird jede Flanke aufgezeichnet
+		(+++) z.B.: MYLIB_EDGECAPTURE_Init(&hedgecapture, EdgeTable, sizeof(EdgeTable)/sizeof(EdgeTable[0]));
+
+	(#) Interrupts weiterreichen (statt HAL_GPIO_EXTI_IRQHandler(), der Zeitstempel wird vor allem anderen gelesen)
+		(+++) z.B.: EXTI3_IRQHandler ()   -> MYLIB_EDGECAPTURE_IRQHandler(&hedgecapture)
+		(+++) z.B.: EXTI9_5_IRQHandler () -> MYLIB_EDGECAPTURE_IRQHandler(&hedgecapture)
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen
+		(+++) z.B.: return MYLIB_EDGECAPTURE_Command(&hedgecapture, hserialprot, Result);
+		(+) "#prd,0:0"   liest GPIOA und GPIOB mit einem Zugriff je Port, "=> #a,<zyklen>,<IDR A>,<IDR B>" (Hex 8/4/4 Stellen)
+		(+) "#edg,<n>:0" liest bis zu n Ereignisse (0 = EDGECAPTURE_DRAIN_MAX) aus dem Ring,
+			"=> #a,<anzahl>,<rest>,<verloren>[,<ereignisse>]"
+			(++) je Ereignis 9 Hex-Stellen ohne Trennzeichen: 8 Stellen Zyklenzähler, 1 Stelle Index * 2 + Pegel
+			(++) Zeitstempel in Takten von SystemCoreClock, der Zähler läuft nach 2^32 Takten über (4 MHz: ca. 18 Minuten)
+		(+) "#edg,0:1"   verwirft alle Ereignisse und den Zähler der verlorenen Flanken, "=> #a,<verworfen>"
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_edgecapture.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup EDGECAPTURE_Private_Functions
+  * @{
+  */
+static void EDGECAPTURE_Hex(uint32_t Value, uint8_t Digits, char *Result);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet alle Eingänge der Tabelle als EXTI-Quelle (beide Flanken) ein, der Ring ist leer
+  * @param  hedgecapture EDGECAPTURE handle
+  * @param  Table 		konstante Tabelle der Eingänge
+  * @param  Count 		Anzahl der Einträge
+  * @retval HAL status (HAL_ERROR bei zu vielen Einträgen oder doppelter EXTI-Leitung)
+  */
+HAL_StatusTypeDef MYLIB_EDGECAPTURE_Init(EDGECAPTURE_TypeDef *hedgecapture, const EDGECAPTURE_InputTypeDef *Table, uint8_t Count){
+
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+	uint32_t lines = 0;
+
+	if(Count > EDGECAPTURE_MAX_INPUTS){
+		return HAL_ERROR;
+	}
+	for(uint8_t i=0; i<Count; i++){
+		if(lines & Table[i].Pin){
+			return HAL_ERROR;
+		}
+		lines |= Table[i].Pin;
+	}
+
+	memset(hedgecapture,0,sizeof(EDGECAPTURE_TypeDef));
+	hedgecapture->Table = Table;
+	hedgecapture->Count = Count;
+	hedgecapture->Lines = lines;
+
+	/* Zeitbasis der Zeitstempel */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+
+	for(uint8_t i=0; i<Count; i++){
+		GPIO_InitStruct.Pin = Table[i].Pin;
+		GPIO_InitStruct.Mode = GPIO_MODE_IT_RISING_FALLING;
+		GPIO_InitStruct.Pull = Table[i].Pull;
+		HAL_GPIO_Init(Table[i].Port, &GPIO_InitStruct);
+	}
+
+	/* Flanken aus der Zeit vor der Initialisierung verwerfen */
+	EXTI->PR1 = lines;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	liest das älteste Ereignis aus dem Ring
+  * @param  hedgecapture EDGECAPTURE handle
+  * @param  Event 		Rückgabe: Ereignis
+  * @retval HAL status (HAL_ERROR bei leerem Ring)
+  */
+HAL_StatusTypeDef MYLIB_EDGECAPTURE_Read(EDGECAPTURE_TypeDef *hedgecapture, EDGECAPTURE_EventTypeDef *Event){
+
+	uint16_t tail = hedgecapture->Tail;
+
+	if(tail == hedgecapture->Head){
+		return HAL_ERROR;
+	}
+	*Event = hedgecapture->Ring[tail];
+
+	/* Platz erst nach dem Kopieren für den Interrupt freigeben */
+	__DMB();
+	hedgecapture->Tail = (tail + 1U) & (EDGECAPTURE_RING_SIZE - 1U);
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	liefert die Anzahl der ungelesenen Ereignisse
+  * @param  hedgecapture EDGECAPTURE handle
+  * @retval Anzahl der Ereignisse im Ring
+  */
+uint16_t MYLIB_EDGECAPTURE_Pending(EDGECAPTURE_TypeDef *hedgecapture){
+
+	return (hedgecapture->Head - hedgecapture->Tail) & (EDGECAPTURE_RING_SIZE - 1U);
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos der Flankenerfassung aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hedgecapture EDGECAPTURE handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_EDGECAPTURE_Command(EDGECAPTURE_TypeDef *hedgecapture, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	char *result = (char *)Result;
+
+	/* Ports lesen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"prd")){
+		if(!__SERIALPROT_IS_COMMAND(hserialprot,"prd","0","0")){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		uint32_t cycles = DWT->CYCCNT;
+		uint32_t porta = GPIOA->IDR;
+		uint32_t portb = GPIOB->IDR;
+
+		EDGECAPTURE_Hex(cycles, 8, result);
+		strcat(result, ",");
+		EDGECAPTURE_Hex(porta, 4, result + strlen(result));
+		strcat(result, ",");
+		EDGECAPTURE_Hex(portb, 4, result + strlen(result));
+		return SERIALPROT_COMMAND_OK;
+
+	/* Ereignisse lesen bzw. verwerfen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"edg")){
+		uint32_t count = atoi((char *)hserialprot->Parameter1);
+		uint32_t mode = atoi((char *)hserialprot->Parameter2);
+		EDGECAPTURE_EventTypeDef event;
+		char events[EDGECAPTURE_DRAIN_MAX * 9 + 1] = {0};
+		uint8_t drained = 0;
+
+		if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER || count > EDGECAPTURE_DRAIN_MAX || mode > 1 || (mode == 1 && count != 0)){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+
+		if(mode == 1){
+			/* der Leser darf nur Tail ändern: bis zum aktuellen Head verwerfen */
+			uint16_t discarded = MYLIB_EDGECAPTURE_Pending(hedgecapture);
+			hedgecapture->Tail = (hedgecapture->Tail + discarded) & (EDGECAPTURE_RING_SIZE - 1U);
+			hedgecapture->Overruns = 0;
+			utoa(discarded, result, 10);
+			return SERIALPROT_COMMAND_OK;
+		}
+
+		if(count == 0){
+			count = EDGECAPTURE_DRAIN_MAX;
+		}
+		while(drained < count && MYLIB_EDGECAPTURE_Read(hedgecapture, &event) == HAL_OK){
+			EDGECAPTURE_Hex(event.Cycles, 8, &events[drained * 9]);
+			EDGECAPTURE_Hex((event.Input << 1) | event.Level, 1, &events[drained * 9 + 8]);
+			drained++;
+		}
+
+		utoa(drained, result, 10);
+		strcat(result, ",");
+		utoa(MYLIB_EDGECAPTURE_Pending(hedgecapture), result + strlen(result), 10);
+		strcat(result, ",");
+		utoa(hedgecapture->Overruns, result + strlen(result), 10);
+		if(drained > 0){
+			strcat(result, ",");
+			strcat(result, events);
+		}
+		return SERIALPROT_COMMAND_OK;
+	}
+
+	return SERIALPROT_COMMAND_UNKNOWN;
+}
+
+/**
+  * @brief  Funktion 	aus den EXTI-Interrupts der Eingänge aufzurufen: zeichnet jede anstehende Flanke mit Zeitstempel auf
+  * @param  hedgecapture EDGECAPTURE handle
+  * @retval none
+  */
+void MYLIB_EDGECAPTURE_IRQHandler(EDGECAPTURE_TypeDef *hedgecapture){
+
+	/* Zeitstempel zuerst, alles Weitere verlängert nur die Latenz */
+	uint32_t cycles = DWT->CYCCNT;
+	uint32_t pending = EXTI->PR1 & hedgecapture->Lines;
+
+	if(pending == 0){
+		return;
+	}
+	EXTI->PR1 = pending;
+
+	for(uint8_t i=0; i<hedgecapture->Count; i++){
+		const EDGECAPTURE_InputTypeDef *input = &hedgecapture->Table[i];
+
+		if(!(pending & input->Pin)){
+			continue;
+		}
+
+		uint16_t head = hedgecapture->Head;
+		uint16_t next = (head + 1U) & (EDGECAPTURE_RING_SIZE - 1U);
+
+		if(next == hedgecapture->Tail){
+			hedgecapture->Overruns++;
+			continue;
+		}
+		hedgecapture->Ring[head].Cycles = cycles;
+		hedgecapture->Ring[head].Input = i;
+		hedgecapture->Ring[head].Level = (input->Port->IDR & input->Pin) ? 1 : 0;
+
+		/* Ereignis erst nach dem Schreiben für den Leser sichtbar machen */
+		__DMB();
+		hedgecapture->Head = next;
+	}
+}
+
+/**
+  * @brief  Funktion 	wandelt "Value" in "Digits" Hex-Stellen mit Nullterminierung um
+  * @param  Value 		umzuwandelnder Wert
+  * @param  Digits 		Anzahl der Stellen (1..8)
+  * @param  Result 		Zielpuffer für Digits + 1 Zeichen
+  * @retval none
+  */
+static void EDGECAPTURE_Hex(uint32_t Value, uint8_t Digits, char *Result){
+
+	static const char digits[] = "0123456789ABCDEF";
+
+	Result[Digits] = 0;
+	while(Digits > 0){
+		Result[--Digits] = digits[Value & 0x0F];
+		Value >>= 4;
+	}
+}
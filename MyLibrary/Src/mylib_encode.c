@@ -0,0 +1,264 @@
+/**
+******************************************************************************
+* @file mylib_encode.c
+* @author Reiter Roman
+* @brief mylib-Kodierung.
+* Diese Datei packt Folgen von Messwerten für die Streams in möglichst wenige Zeichen:
+* + Je Wert wird die Differenz zum Vorgänger desselben Felds gebildet und Zig-Zag-kodiert
+*   (0, -1, 1, -2, 2 .. -> 0, 1, 2, 3, 4 ..), kleine Änderungen ergeben kleine Zahlen
+* + Die Zahlen werden als Varint geschrieben (7 Bit je Byte, Bit 7 = es folgt ein weiteres Byte),
+*   Werte unter 128 brauchen ein Byte statt 3 bzw. 4 Hex-Stellen
+* + Optional ersetzt eine LZ-Stufe Wiederholungen in den Varint-Bytes durch Verweise (periodische Signale)
+* + Das Ergebnis wird Base64-kodiert, damit es als Text in eine Meldung passt
+* + Jede Zeile beginnt mit dem Vorgänger 0, eine verworfene Zeile stört das Dekodieren der folgenden nicht
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Je Zeile die Kodierung beginnen, die Werte übergeben und den Text abholen
+		(+++) z.B.: ENCODE_TypeDef encode;
+		(+++) z.B.: MYLIB_ENCODE_Begin(&encode, ENCODE_MODE_DELTA_LZ, 1);
+		(+++) z.B.: for(i=0; i<n; i++){ MYLIB_ENCODE_Put(&encode, values[i]); }
+		(+++) z.B.: MYLIB_ENCODE_End(&encode, text);  (text mit ENCODE_TEXT_MAX Zeichen)
+		(+) Mit Fields = 2 werden abwechselnd zwei Größen übergeben (z.B. Pegel und Länge eines Laufs),
+			jede wird gegen ihren eigenen Vorgänger differenziert
+		(+) MYLIB_ENCODE_Put() liefert HAL_ERROR, wenn der Wert nicht mehr in ENCODE_BYTES_MAX passt,
+			die Zeile ist dann bis zum letzten angenommenen Wert vollständig
+
+	(#) Format der Bytes vor Base64 (Dekoder am Host: Tools/encode_decode.c)
+		(+) ENCODE_MODE_DELTA:    Varints, je Wert: z = (d << 1) ^ (d >> 31), d = Wert - Vorgänger im Feld
+		(+) ENCODE_MODE_DELTA_LZ: Token-Folge über den Varint-Bytes
+			(+++) 0LLLLLLL           L + 1 Bytes folgen unverändert
+			(+++) 1LLLLLLL OOOOOOOO  L + ENCODE_LZ_MATCH_MIN Bytes ab O Bytes vor der aktuellen Position kopieren
+			     (Überlappung erlaubt, O = 1 wiederholt das letzte Byte)
+
+	(#) Grenzen
+		(+) Rauschende Signale profitieren von der Differenz und dem Varint, kaum von der LZ-Stufe,
+			periodische Signale (Logikanalysator, konstante Spannung) vor allem von der LZ-Stufe
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_encode.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/** @defgroup ENCODE_Private_Constants
+  * @{
+  */
+#define ENCODE_LZ_HASH_SIZE 64					/*!< Einträge der Hash-Tabelle der LZ-Stufe (Zweierpotenz) */
+#define ENCODE_LZ_NONE 0xFFU					/*!< leerer Eintrag der Hash-Tabelle */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup ENCODE_Private_Functions
+  * @{
+  */
+static uint16_t ENCODE_Lz(const uint8_t *In, uint16_t Length, uint8_t *Out);
+static uint16_t ENCODE_LzLiterals(const uint8_t *In, uint16_t Count, uint8_t *Out);
+static uint8_t ENCODE_LzHash(const uint8_t *Bytes);
+static uint16_t ENCODE_Base64(const uint8_t *In, uint16_t Length, char *Text);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	beginnt eine neue Zeile, alle Vorgänger sind 0
+  * @param  hencode 	ENCODE handle
+  * @param  Mode 		ENCODE_MODE_DELTA oder ENCODE_MODE_DELTA_LZ
+  * @param  Fields 		Anzahl verschränkter Felder (1..ENCODE_FIELDS_MAX)
+  * @retval none
+  */
+void MYLIB_ENCODE_Begin(ENCODE_TypeDef *hencode, ENCODE_ModeTypeDef Mode, uint8_t Fields){
+
+	hencode->Mode = Mode;
+	hencode->Length = 0;
+	hencode->Fields = (Fields == 0 || Fields > ENCODE_FIELDS_MAX) ? 1 : Fields;
+	hencode->Field = 0;
+	memset(hencode->Previous, 0, sizeof(hencode->Previous));
+}
+
+/**
+  * @brief  Funktion 	hängt einen Wert als Zig-Zag-Differenz im Varint-Format an
+  * @param  hencode 	ENCODE handle
+  * @param  Value 		Wert des nächsten Felds
+  * @retval HAL status (HAL_ERROR, wenn der Wert nicht mehr in die Zeile passt, die Zeile bleibt unverändert)
+  */
+HAL_StatusTypeDef MYLIB_ENCODE_Put(ENCODE_TypeDef *hencode, int32_t Value){
+
+	int32_t delta = (int32_t)((uint32_t)Value - (uint32_t)hencode->Previous[hencode->Field]);
+	uint32_t zigzag = ((uint32_t)delta << 1) ^ (uint32_t)(delta >> 31);
+	uint8_t bytes[5];
+	uint8_t count = 0;
+
+	/* 7 Bit je Byte, niederwertige zuerst */
+	do{
+		bytes[count] = zigzag & 0x7FU;
+		zigzag >>= 7;
+		if(zigzag != 0){
+			bytes[count] |= 0x80U;
+		}
+		count++;
+	}while(zigzag != 0);
+
+	if(hencode->Length + count > ENCODE_BYTES_MAX){
+		return HAL_ERROR;
+	}
+	memcpy(&hencode->Bytes[hencode->Length], bytes, count);
+	hencode->Length += count;
+
+	hencode->Previous[hencode->Field] = Value;
+	if(++hencode->Field >= hencode->Fields){
+		hencode->Field = 0;
+	}
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	schließt die Zeile ab: optional LZ-Stufe, danach Base64
+  * @param  hencode 	ENCODE handle
+  * @param  Text 		Zielpuffer (ENCODE_TEXT_MAX Zeichen), nullterminiert
+  * @retval Anzahl der geschriebenen Zeichen ohne Nullterminierung
+  */
+uint16_t MYLIB_ENCODE_End(ENCODE_TypeDef *hencode, char *Text){
+
+	uint8_t packed[ENCODE_LZ_BYTES_MAX];
+
+	if(hencode->Mode == ENCODE_MODE_DELTA_LZ){
+		uint16_t length = ENCODE_Lz(hencode->Bytes, hencode->Length, packed);
+		return ENCODE_Base64(packed, length, Text);
+	}
+	return ENCODE_Base64(hencode->Bytes, hencode->Length, Text);
+}
+
+/**
+  * @brief  Funktion 	LZ-Stufe: ersetzt Wiederholungen durch Verweise auf frühere Bytes,
+  *                     Kandidaten liefert eine Hash-Tabelle über je 3 Bytes (ein Vergleich je Position)
+  * @param  In 			Varint-Bytes
+  * @param  Length 		Anzahl der Bytes (max. ENCODE_BYTES_MAX)
+  * @param  Out 		Zielpuffer (ENCODE_LZ_BYTES_MAX Bytes)
+  * @retval Anzahl der geschriebenen Bytes
+  */
+static uint16_t ENCODE_Lz(const uint8_t *In, uint16_t Length, uint8_t *Out){
+
+	uint8_t head[ENCODE_LZ_HASH_SIZE];
+	uint16_t out = 0;
+	uint16_t literal = 0;			/* Beginn der noch nicht geschriebenen unveränderten Bytes */
+	uint16_t pos = 0;
+
+	memset(head, ENCODE_LZ_NONE, sizeof(head));
+
+	while(pos < Length){
+		uint16_t match = 0;
+
+		if(pos + ENCODE_LZ_MATCH_MIN <= Length){
+			uint8_t hash = ENCODE_LzHash(&In[pos]);
+			uint8_t candidate = head[hash];
+
+			head[hash] = pos;
+			if(candidate != ENCODE_LZ_NONE){
+				/* Überlappung mit der aktuellen Position ist erlaubt (der Dekoder kopiert Byte für Byte) */
+				while(pos + match < Length && match < ENCODE_LZ_MATCH_MAX && In[candidate + match] == In[pos + match]){
+					match++;
+				}
+				if(match < ENCODE_LZ_MATCH_MIN){
+					match = 0;
+				}
+			}
+			if(match != 0){
+				/* offene unveränderte Bytes zuerst */
+				out += ENCODE_LzLiterals(&In[literal], pos - literal, &Out[out]);
+				Out[out++] = 0x80U | (match - ENCODE_LZ_MATCH_MIN);
+				Out[out++] = pos - candidate;
+
+				/* übersprungene Positionen in die Tabelle aufnehmen, spätere Verweise finden sie */
+				for(uint16_t i=pos+1; i<pos+match && i + ENCODE_LZ_MATCH_MIN <= Length; i++){
+					head[ENCODE_LzHash(&In[i])] = i;
+				}
+				pos += match;
+				literal = pos;
+				continue;
+			}
+		}
+		pos++;
+	}
+
+	/* Rest unverändert */
+	out += ENCODE_LzLiterals(&In[literal], Length - literal, &Out[out]);
+	return out;
+}
+
+/**
+  * @brief  Funktion 	schreibt unveränderte Bytes als Literal-Token (je Token max. ENCODE_LZ_LITERAL_MAX Bytes)
+  * @param  In 			erstes unverändertes Byte
+  * @param  Count 		Anzahl der Bytes (0 = nichts zu schreiben)
+  * @param  Out 		Zielposition
+  * @retval Anzahl der geschriebenen Bytes
+  */
+static uint16_t ENCODE_LzLiterals(const uint8_t *In, uint16_t Count, uint8_t *Out){
+
+	uint16_t out = 0;
+
+	while(Count > 0){
+		uint16_t count = (Count > ENCODE_LZ_LITERAL_MAX) ? ENCODE_LZ_LITERAL_MAX : Count;
+
+		Out[out++] = count - 1U;
+		memcpy(&Out[out], In, count);
+		out += count;
+		In += count;
+		Count -= count;
+	}
+	return out;
+}
+
+/**
+  * @brief  Funktion 	Hash über 3 Bytes für die LZ-Stufe
+  * @param  Bytes 		erstes der 3 Bytes
+  * @retval Index in die Hash-Tabelle
+  */
+static uint8_t ENCODE_LzHash(const uint8_t *Bytes){
+
+	uint32_t value = Bytes[0] | ((uint32_t)Bytes[1] << 8) | ((uint32_t)Bytes[2] << 16);
+
+	return (value * 2654435761U) >> 26;
+}
+
+/**
+  * @brief  Funktion 	Base64 (RFC 4648, ohne Füllzeichen '=')
+  * @param  In 			Bytes
+  * @param  Length 		Anzahl der Bytes
+  * @param  Text 		Zielpuffer, nullterminiert
+  * @retval Anzahl der geschriebenen Zeichen ohne Nullterminierung
+  */
+static uint16_t ENCODE_Base64(const uint8_t *In, uint16_t Length, char *Text){
+
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	uint16_t count = 0;
+
+	for(uint16_t i=0; i<Length; i+=3){
+		uint32_t group = (uint32_t)In[i] << 16;
+		uint8_t chars = 2;
+
+		if(i + 1 < Length){
+			group |= (uint32_t)In[i + 1] << 8;
+			chars++;
+		}
+		if(i + 2 < Length){
+			group |= In[i + 2];
+			chars++;
+		}
+		for(uint8_t c=0; c<chars; c++){
+			Text[count++] = alphabet[(group >> (18 - 6 * c)) & 0x3FU];
+		}
+	}
+	Text[count] = 0;
+	return count;
+}
@@ -0,0 +1,419 @@
+/**
+******************************************************************************
+* @file mylib_freqmeter.c
+* @author Reiter Roman
+* @brief mylib-Frequenzmesser.
+* Diese Datei misst Periode und Pulsbreite eines Rechtecksignals am Eingang von Kanal 1 eines 32-Bit-Timers:
+* + Kanal 1 fängt die steigenden, Kanal 2 (indirekt am selben Eingang TI1) die fallenden Flanken
+* + Jede steigende Flanke fordert eine DMA-Übertragung an, die per DMA-Burst (DCR/DMAR) CCR1 und CCR2
+*   in den Speicher schreibt, die CPU wird je Flanke nicht unterbrochen
+* + Nach n Perioden endet die DMA von selbst, erst das Kommando wertet die Zeitstempel aus (min/max/Mittelwert)
+* + Der Timer ist die Gerätezeit des Schedulers (1 µs), er wird weder angehalten noch umkonfiguriert
+* + Timer und DMA werden direkt über die Register betrieben (wie Scheduler und Sequencer)
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Der Timer läuft bereits frei mit FREQMETER_COUNTER_CLOCK (MYLIB_SCHEDULER_Init), Kanal 1 und 2 sind frei
+		(+) Eingangspin als Alternate Function von Kanal 1 einrichten (z.B. PA0 AF1 = TIM2_CH1)
+		(+) Takt der DMA einschalten, Interrupt des DMA-Kanals freigeben (Priorität 0 wie die Transportschichten)
+
+	(#) Konfiguration eintragen und den Frequenzmesser initialisieren
+		(+++) z.B.: hfreqmeter.Init.Timer = TIM2;
+		(+++) z.B.: hfreqmeter.Init.Channel = DMA1_Channel5; hfreqmeter.Init.DmaRequest = 4;
+		(+++) z.B.: MYLIB_FREQMETER_Init(&hfreqmeter);
+
+	(#) Interrupt des DMA-Kanals weiterreichen
+		(+++) DMA1_Channel5_IRQHandler ()  -> MYLIB_FREQMETER_DMA_IRQHandler(&hfreqmeter)
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen (alle Werte dezimal)
+		(+++) z.B.: return MYLIB_FREQMETER_Command(&hfreqmeter, hserialprot, Result);
+		(+) "#fqs,<n>:0"  startet eine Messung über n Perioden (1..FREQMETER_PERIODS_MAX), "=> #a,<n>"
+		(+) "#fqr,0:0"    wertet die bisher aufgenommenen Perioden aus, die Messung läuft weiter
+			"=> #a,<perioden>,<T min>,<T max>,<T mittel>,<H min>,<H max>,<H mittel>,<f mHz>,<tastgrad promille>"
+			(T = Periode, H = High-Zeit, alle in µs, Mittelwerte mit drei Nachkommastellen "<µs>.<ns>"), NACK solange keine ganze Periode aufgenommen ist
+		(+) "#fqx,0:0"    bricht die Messung ab, "=> #a,<aufgenommene perioden>"
+		(+) Nach n Perioden folgt die Zeile "=> #e,fq,done,<n>", bei einem DMA-Fehler "=> #e,fq,err,<perioden>"
+
+	(#) Am Ende einer vollständigen Messung wird jede Periode an FREQMETER_Period_Callback() übergeben (z.B. für mylib_stats)
+
+	(#) Grenzen
+		(+) Auflösung eines Zeitstempels 1 µs, die mittlere Periode (Summe der Perioden durch n) auf 1/n µs
+		(+) Zwischen zwei steigenden Flanken muss der DMA-Burst fertig sein (einige µs), sonst fehlen Perioden
+		(+) Endet ein Puls schneller als der DMA-Burst startet, wird seine High-Zeit nicht ausgewertet
+		(+) Perioden über 71 Minuten (Überlauf des 32-Bit-Timers) sind nicht messbar
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_freqmeter.h"
+#include "mylib_dmachannel.h"
+#include "stdlib.h"
+#include "string.h"
+#include "stddef.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/** @defgroup FREQMETER_Private_Constants
+  * @{
+  */
+#define FREQMETER_BURST_WORDS 2U				/*!< Wörter je Flanke: CCR1, CCR2 */
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup FREQMETER_Private_Functions
+  * @{
+  */
+static uint16_t FREQMETER_Captured(FREQMETER_TypeDef *hfreqmeter);
+static uint8_t FREQMETER_Period(const FREQMETER_CaptureTypeDef *Capture, uint32_t *Period, uint32_t *High);
+static void FREQMETER_Finish(FREQMETER_TypeDef *hfreqmeter, const char * Status);
+static void FREQMETER_AppendMean(uint8_t * Result, uint64_t MeanNs);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet den DMA-Request ein, Kanal 1 und 2 des Timers bleiben bis zum Start abgeschaltet
+  * @param  hfreqmeter 	FREQMETER handle mit ausgefüllter Konfiguration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_FREQMETER_Init(FREQMETER_TypeDef *hfreqmeter){
+
+	TIM_TypeDef *timer = hfreqmeter->Init.Timer;
+	DMA_Channel_TypeDef *channel = hfreqmeter->Init.Channel;
+
+	if(!IS_TIM_32B_COUNTER_INSTANCE(timer) || !IS_TIM_DMABURST_INSTANCE(timer)){
+		return HAL_ERROR;
+	}
+
+	hfreqmeter->Periods = 0;
+	hfreqmeter->Running = 0;
+	hfreqmeter->hserialprot = NULL;
+
+	channel->CCR &= ~DMA_CCR_EN;
+	channel->CNDTR = 0;
+	MYLIB_DMACHANNEL_SetRequest(channel, hfreqmeter->Init.DmaRequest);
+
+	timer->DIER &= ~TIM_DIER_CC1DE;
+	timer->CCER &= ~(TIM_CCER_CC1E | TIM_CCER_CC2E);
+
+	/* Kanal 1: TI1 steigend, Kanal 2: TI1 (indirekt) fallend, ohne Filter und Vorteiler */
+	MODIFY_REG(timer->CCMR1,
+			TIM_CCMR1_CC1S | TIM_CCMR1_IC1PSC | TIM_CCMR1_IC1F | TIM_CCMR1_CC2S | TIM_CCMR1_IC2PSC | TIM_CCMR1_IC2F,
+			TIM_CCMR1_CC1S_0 | TIM_CCMR1_CC2S_1);
+	MODIFY_REG(timer->CCER,
+			TIM_CCER_CC1P | TIM_CCER_CC1NP | TIM_CCER_CC2P | TIM_CCER_CC2NP,
+			TIM_CCER_CC2P);
+
+	/* DMA-Burst: je CC1-Request zwei Zugriffe auf DMAR, beginnend bei CCR1 */
+	timer->DCR = ((FREQMETER_BURST_WORDS - 1U) << TIM_DCR_DBL_Pos)
+				| ((offsetof(TIM_TypeDef, CCR1) / sizeof(uint32_t)) << TIM_DCR_DBA_Pos);
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	startet eine Messung, die DMA endet nach Periods + 1 steigenden Flanken
+  * @param  hfreqmeter 	FREQMETER handle
+  * @param  Periods 	Anzahl Perioden (1..FREQMETER_PERIODS_MAX)
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_FREQMETER_Start(FREQMETER_TypeDef *hfreqmeter, uint16_t Periods){
+
+	TIM_TypeDef *timer = hfreqmeter->Init.Timer;
+	DMA_Channel_TypeDef *channel = hfreqmeter->Init.Channel;
+
+	if(Periods == 0 || Periods > FREQMETER_PERIODS_MAX){
+		return HAL_ERROR;
+	}
+
+	MYLIB_FREQMETER_Stop(hfreqmeter);
+	hfreqmeter->Periods = Periods;
+
+	/* DMAR -> Speicher, 32 Bit, einmalig */
+	MYLIB_DMACHANNEL_ClearFlags(channel);
+	channel->CPAR = (uint32_t)&timer->DMAR;
+	channel->CMAR = (uint32_t)hfreqmeter->Capture;
+	channel->CNDTR = (Periods + 1U) * FREQMETER_BURST_WORDS;
+	channel->CCR = DMA_CCR_PL_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE;
+	channel->CCR |= DMA_CCR_EN;
+
+	/* eine vor dem Start gefangene Flanke darf keinen Request auslösen */
+	timer->SR = ~(TIM_SR_CC1IF | TIM_SR_CC2IF | TIM_SR_CC1OF | TIM_SR_CC2OF);
+	hfreqmeter->Running = 1;
+	timer->CCER |= TIM_CCER_CC1E | TIM_CCER_CC2E;
+	timer->DIER |= TIM_DIER_CC1DE;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	beendet die Aufnahme, die bisher aufgenommenen Flanken bleiben auswertbar
+  * @param  hfreqmeter 	FREQMETER handle
+  * @retval none
+  */
+void MYLIB_FREQMETER_Stop(FREQMETER_TypeDef *hfreqmeter){
+
+	hfreqmeter->Init.Timer->DIER &= ~TIM_DIER_CC1DE;
+	hfreqmeter->Init.Timer->CCER &= ~(TIM_CCER_CC1E | TIM_CCER_CC2E);
+	hfreqmeter->Init.Channel->CCR &= ~DMA_CCR_EN;
+	hfreqmeter->Running = 0;
+}
+
+/**
+  * @brief  Funktion 	wertet die bisher aufgenommenen Perioden aus
+  * @note   Die mittlere Periode wird aus der Summe aller Perioden berechnet, die High-Zeit einer Periode nur,
+  *         wenn die fallende Flanke zwischen ihren beiden steigenden Flanken liegt
+  * @param  hfreqmeter 	FREQMETER handle
+  * @param  Result 		Ergebnis
+  * @retval HAL status (HAL_ERROR, solange keine ganze Periode aufgenommen ist)
+  */
+HAL_StatusTypeDef MYLIB_FREQMETER_Evaluate(FREQMETER_TypeDef *hfreqmeter, FREQMETER_ResultTypeDef *Result){
+
+	const FREQMETER_CaptureTypeDef *capture = hfreqmeter->Capture;
+	uint16_t count = FREQMETER_Captured(hfreqmeter);
+	uint64_t highSum = 0;
+	uint64_t highPeriodSum = 0;
+	uint16_t highCount = 0;
+	uint64_t span = 0;
+
+	if(count < 2){
+		return HAL_ERROR;
+	}
+
+	memset(Result, 0, sizeof(FREQMETER_ResultTypeDef));
+	Result->Periods = count - 1U;
+	Result->PeriodMin = 0xFFFFFFFFU;
+	Result->HighMin = 0xFFFFFFFFU;
+
+	for(uint16_t i=1; i<count; i++){
+		uint32_t period, high;
+		uint8_t valid = FREQMETER_Period(&capture[i], &period, &high);
+
+		if(period < Result->PeriodMin){
+			Result->PeriodMin = period;
+		}
+		if(period > Result->PeriodMax){
+			Result->PeriodMax = period;
+		}
+		if(valid){
+			if(high < Result->HighMin){
+				Result->HighMin = high;
+			}
+			if(high > Result->HighMax){
+				Result->HighMax = high;
+			}
+			highSum += high;
+			highPeriodSum += period;
+			highCount++;
+		}
+		span += period;
+	}
+
+	Result->PeriodMeanNs = span * 1000U / Result->Periods;
+	Result->FrequencyMilliHz = (span != 0) ? (uint32_t)((uint64_t)Result->Periods * FREQMETER_COUNTER_CLOCK * 1000U / span) : 0;
+
+	if(highCount != 0){
+		Result->HighMeanNs = highSum * 1000U / highCount;
+		Result->DutyPermille = (uint16_t)(highSum * 1000U / highPeriodSum);
+	}else{
+		Result->HighMin = 0;
+	}
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos des Frequenzmessers aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hfreqmeter 	FREQMETER handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_FREQMETER_Command(FREQMETER_TypeDef *hfreqmeter, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"fqs") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"fqr")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"fqx")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos des Frequenzmessers haben zwei Zahlen als Parameter */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	/* Messung starten */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"fqs")){
+		hfreqmeter->hserialprot = hserialprot;
+		if(MYLIB_FREQMETER_Start(hfreqmeter, atoi((char *)hserialprot->Parameter1)) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa(hfreqmeter->Periods, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Ergebnis */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"fqr")){
+		FREQMETER_ResultTypeDef result;
+
+		if(MYLIB_FREQMETER_Evaluate(hfreqmeter, &result) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+
+		/* Reihenfolge wie in der Antwort, die Mittelwerte (Index 3 und 6) als µs mit Nachkommastellen */
+		const uint32_t values[] = {result.Periods, result.PeriodMin, result.PeriodMax, 0,
+				result.HighMin, result.HighMax, 0, result.FrequencyMilliHz, result.DutyPermille};
+
+		Result[0] = 0;
+		for(uint8_t i=0; i<sizeof(values)/sizeof(values[0]); i++){
+			if(i != 0){
+				strcat((char *)Result, ",");
+			}
+			if(i == 3 || i == 6){
+				FREQMETER_AppendMean(Result, (i == 3) ? result.PeriodMeanNs : result.HighMeanNs);
+			}else{
+				utoa(values[i], (char *)Result + strlen((char *)Result), 10);
+			}
+		}
+		return SERIALPROT_COMMAND_OK;
+
+	/* Messung abbrechen */
+	}else{
+		MYLIB_FREQMETER_Stop(hfreqmeter);
+		utoa(FREQMETER_Captured(hfreqmeter) ? FREQMETER_Captured(hfreqmeter) - 1U : 0U, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des DMA-Kanals aufzurufen: meldet das Ende der Messung
+  * @param  hfreqmeter 	FREQMETER handle
+  * @retval none
+  */
+void MYLIB_FREQMETER_DMA_IRQHandler(FREQMETER_TypeDef *hfreqmeter){
+
+	DMA_Channel_TypeDef *channel = hfreqmeter->Init.Channel;
+	uint32_t flags = MYLIB_DMACHANNEL_GetFlags(channel);
+
+	if(!hfreqmeter->Running){
+		return;
+	}
+
+	if(flags & DMA_ISR_TEIF1){
+		/* Übertragungsfehler: der Kanal wurde von der DMA abgeschaltet */
+		MYLIB_FREQMETER_Stop(hfreqmeter);
+		FREQMETER_Finish(hfreqmeter, "err");
+	}else if(flags & DMA_ISR_TCIF1){
+		MYLIB_FREQMETER_Stop(hfreqmeter);
+		for(uint16_t i=1; i<=hfreqmeter->Periods; i++){
+			uint32_t period, high;
+
+			if(!FREQMETER_Period(&hfreqmeter->Capture[i], &period, &high)){
+				high = 0;
+			}
+			FREQMETER_Period_Callback(hfreqmeter, period, high);
+		}
+		FREQMETER_Finish(hfreqmeter, "done");
+	}
+}
+
+/**
+  * @brief  Funktion 	Callback für jede Periode einer vollständigen Messung, wird im Interrupt des DMA-Kanals aufgerufen
+  * @param  hfreqmeter 	FREQMETER handle
+  * @param  Period 		Periode in µs
+  * @param  High 		High-Zeit in µs, 0 wenn sie für diese Periode nicht bestimmt werden konnte
+  * @retval none
+  */
+__weak void FREQMETER_Period_Callback(FREQMETER_TypeDef *hfreqmeter, uint32_t Period, uint32_t High)
+{
+	/* Prevent unused argument(s) compilation warning */
+	UNUSED(hfreqmeter);
+	UNUSED(Period);
+	UNUSED(High);
+
+	/* NOTE : This function should not be modified, when the callback is needed,
+            	the FREQMETER_Period_Callback could be implemented in the user file
+	 */
+}
+
+/**
+  * @brief  Funktion 	berechnet Periode und High-Zeit aus einer Aufzeichnung und ihrer Vorgängerin
+  * @param  Capture 	Aufzeichnung am Ende der Periode (Capture[-1] ist ihr Anfang)
+  * @param  Period 		Rückgabe: Periode in µs
+  * @param  High 		Rückgabe: High-Zeit in µs
+  * @retval 1 = High-Zeit gültig (fallende Flanke innerhalb der Periode), 0 = nur die Periode ist gültig
+  */
+static uint8_t FREQMETER_Period(const FREQMETER_CaptureTypeDef *Capture, uint32_t *Period, uint32_t *High){
+
+	/* Differenzen ohne Vorzeichen bleiben über den Überlauf des Timers richtig */
+	*Period = Capture[0].Rising - Capture[-1].Rising;
+	*High = Capture[0].Falling - Capture[-1].Rising;
+
+	return (*High != 0 && *High <= *Period);
+}
+
+/**
+  * @brief  Funktion 	liefert die Anzahl vollständig aufgenommener steigender Flanken
+  * @param  hfreqmeter 	FREQMETER handle
+  * @retval Anzahl Flanken (0..Periods + 1)
+  */
+static uint16_t FREQMETER_Captured(FREQMETER_TypeDef *hfreqmeter){
+
+	uint32_t words = (hfreqmeter->Periods + 1U) * FREQMETER_BURST_WORDS;
+	uint32_t remaining = hfreqmeter->Init.Channel->CNDTR;
+
+	if(hfreqmeter->Periods == 0 || remaining > words){
+		return 0;
+	}
+	/* ein gerade laufender Burst zählt erst mit beiden Wörtern */
+	return (words - remaining) / FREQMETER_BURST_WORDS;
+}
+
+/**
+  * @brief  Funktion 	meldet das Ende der Messung an die Instanz, die sie gestartet hat
+  * @param  hfreqmeter 	FREQMETER handle
+  * @param  Status 		"done" oder "err"
+  * @retval none
+  */
+static void FREQMETER_Finish(FREQMETER_TypeDef *hfreqmeter, const char * Status){
+
+	uint8_t event[20] = "fq,";
+	uint16_t captured = FREQMETER_Captured(hfreqmeter);
+
+	if(hfreqmeter->hserialprot == NULL){
+		return;
+	}
+
+	strcat((char *)event, Status);
+	strcat((char *)event, ",");
+	utoa(captured ? captured - 1U : 0U, (char *)event + strlen((char *)event), 10);
+	MYLIB_SERIALPROT_Event(hfreqmeter->hserialprot, event);
+}
+
+/**
+  * @brief  Funktion 	hängt einen Mittelwert als "<µs>.<ns>" (drei Nachkommastellen) an das Ergebnis an
+  * @note   Der Mittelwert ist nie größer als die längste Periode (32-Bit-Timer), der µs-Teil passt in 32 Bit
+  * @param  Result 		Ergebnispuffer
+  * @param  MeanNs 		Mittelwert in ns
+  * @retval none
+  */
+static void FREQMETER_AppendMean(uint8_t * Result, uint64_t MeanNs){
+
+	uint16_t fraction = (uint16_t)(MeanNs % 1000U);
+	uint8_t * end;
+
+	utoa((uint32_t)(MeanNs / 1000U), (char *)Result + strlen((char *)Result), 10);
+	end = Result + strlen((char *)Result);
+	end[0] = '.';
+	end[1] = '0' + fraction / 100U;
+	end[2] = '0' + (fraction / 10U) % 10U;
+	end[3] = '0' + fraction % 10U;
+	end[4] = 0;
+}
@@ -0,0 +1,196 @@
+/**
+******************************************************************************
+* @file mylib_gpiotable.c
+* @author Reiter Roman
+* @brief mylib-GPIO-Tabelle.
+* Diese Datei verwaltet die GPIOs der Anwendung über eine konstante Pin-Tabelle (Name, Port, Pin, aktiver Pegel, Modus):
+* + Initialisierung aller Pins aus der Tabelle (Takt, Ruhepegel vor dem Umschalten auf Ausgang, Modus)
+* + Suche eines Pins über den Namen mit einer bei der Initialisierung berechneten Hash-Tabelle
+* + Kommando "gpo" für alle Ausgänge der Tabelle, ohne eigene Abfrage je Pin
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Pin-Tabelle als const anlegen (liegt im Flash), z.B.:
+		(+++) static const GPIOTABLE_DescriptorTypeDef GpioTable[] = {
+		(+++)     {"rt", RGB_RT_GPIO_Port, RGB_RT_Pin, GPIO_PIN_RESET, GPIO_MODE_OUTPUT_PP, GPIO_NOPULL},
+		(+++) };
+		(+) Ein neuer Pin braucht nur eine neue Zeile, MX_GPIO_Init() und die Callbacks bleiben unverändert
+
+	(#) Tabelle initialisieren, dabei werden die Pins eingerichtet, Ausgänge starten inaktiv
+		(+++) z.B.: MYLIB_GPIOTABLE_Init(&hgpiotable, GpioTable, sizeof(GpioTable)/sizeof(GpioTable[0]));
+
+	(#) Kommando "gpo" in SERIALPROT_Command_GPO_Callback() weiterreichen
+		(+++) z.B.: return MYLIB_GPIOTABLE_Command(&hgpiotable, hserialprot);
+		(+) "#gpo,<name>:on\r" schaltet den Pin auf den aktiven Pegel, "#gpo,<name>:off\r" auf den inaktiven
+		(+) Je Kommando wird der Name einmal gehasht und mit genau einem Eintrag verglichen
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_gpiotable.h"
+#include "string.h"
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup GPIOTABLE_Private_Functions
+  * @{
+  */
+static uint32_t GPIOTABLE_Hash(const char *Name);
+static void GPIOTABLE_EnableClock(GPIO_TypeDef *Port);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet alle Pins der Tabelle ein und berechnet die Hash-Tabelle der Namen
+  * @param  hgpiotable 	GPIOTABLE handle
+  * @param  Table 		konstante Pin-Tabelle
+  * @param  Count 		Anzahl der Einträge
+  * @retval HAL status (HAL_ERROR bei zu vielen Einträgen oder doppelten Namen)
+  */
+HAL_StatusTypeDef MYLIB_GPIOTABLE_Init(GPIOTABLE_TypeDef *hgpiotable, const GPIOTABLE_DescriptorTypeDef *Table, uint8_t Count){
+
+	GPIO_InitTypeDef GPIO_InitStruct = {0};
+
+	if(Count > GPIOTABLE_MAX_PINS){
+		return HAL_ERROR;
+	}
+
+	memset(hgpiotable,0,sizeof(GPIOTABLE_TypeDef));
+	hgpiotable->Table = Table;
+	hgpiotable->Count = Count;
+
+	for(uint8_t i=0; i<Count; i++){
+
+		/* Namen eintragen, offene Adressierung mit linearer Suche */
+		uint32_t slot = GPIOTABLE_Hash(Table[i].Name) & (GPIOTABLE_HASH_SIZE - 1);
+		while(hgpiotable->Index[slot] != 0){
+			if(!strcmp(Table[hgpiotable->Index[slot] - 1].Name, Table[i].Name)){
+				return HAL_ERROR;
+			}
+			slot = (slot + 1) & (GPIOTABLE_HASH_SIZE - 1);
+		}
+		hgpiotable->Index[slot] = i + 1;
+
+		/* Ausgänge vor dem Umschalten auf den inaktiven Pegel setzen, damit sie beim Start nicht kurz aktiv sind */
+		GPIOTABLE_EnableClock(Table[i].Port);
+		if(Table[i].Mode != GPIO_MODE_INPUT){
+			HAL_GPIO_WritePin(Table[i].Port, Table[i].Pin, (Table[i].ActiveLevel == GPIO_PIN_SET) ? GPIO_PIN_RESET : GPIO_PIN_SET);
+		}
+
+		GPIO_InitStruct.Pin = Table[i].Pin;
+		GPIO_InitStruct.Mode = Table[i].Mode;
+		GPIO_InitStruct.Pull = Table[i].Pull;
+		GPIO_InitStruct.Speed = GPIO_SPEED_FREQ_LOW;
+		HAL_GPIO_Init(Table[i].Port, &GPIO_InitStruct);
+	}
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	sucht einen Pin über seinen Namen
+  * @param  hgpiotable 	GPIOTABLE handle
+  * @param  Name 		Name des Pins
+  * @retval Eintrag der Tabelle oder NULL, falls der Name nicht vorkommt
+  */
+const GPIOTABLE_DescriptorTypeDef * MYLIB_GPIOTABLE_Find(GPIOTABLE_TypeDef *hgpiotable, const char *Name){
+
+	uint32_t slot = GPIOTABLE_Hash(Name) & (GPIOTABLE_HASH_SIZE - 1);
+
+	/* die Tabelle ist höchstens halb voll, ein freier Platz beendet die Suche */
+	while(hgpiotable->Index[slot] != 0){
+		const GPIOTABLE_DescriptorTypeDef *descriptor = &hgpiotable->Table[hgpiotable->Index[slot] - 1];
+		if(!strcmp(descriptor->Name, Name)){
+			return descriptor;
+		}
+		slot = (slot + 1) & (GPIOTABLE_HASH_SIZE - 1);
+	}
+	return NULL;
+}
+
+/**
+  * @brief  Funktion 	schaltet einen Ausgang auf den aktiven oder inaktiven Pegel
+  * @param  Descriptor 	Eintrag der Tabelle
+  * @param  On 			1: aktiver Pegel, 0: inaktiver Pegel
+  * @retval HAL status (HAL_ERROR bei einem Eingang)
+  */
+HAL_StatusTypeDef MYLIB_GPIOTABLE_Write(const GPIOTABLE_DescriptorTypeDef *Descriptor, uint8_t On){
+
+	if(Descriptor->Mode == GPIO_MODE_INPUT){
+		return HAL_ERROR;
+	}
+
+	/* ein BSRR-Zugriff, aktiver Pegel bei On, sonst der andere */
+	if((On != 0) == (Descriptor->ActiveLevel == GPIO_PIN_SET)){
+		Descriptor->Port->BSRR = Descriptor->Pin;
+	}else{
+		Descriptor->Port->BSRR = (uint32_t)Descriptor->Pin << 16;
+	}
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	führt das Kommando "#gpo,<name>:on|off" für einen Ausgang der Tabelle aus,
+  * 					aus SERIALPROT_Command_GPO_Callback() aufzurufen
+  * @param  hgpiotable 	GPIOTABLE handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @retval 0: ausgeführt, 1: Name oder Zustand ungültig (wie SERIALPROT_Command_GPO_Callback())
+  */
+uint8_t MYLIB_GPIOTABLE_Command(GPIOTABLE_TypeDef *hgpiotable, SERIALPROTOCOL_TypeDef *hserialprot){
+
+	uint8_t on;
+
+	if(!strcmp((char *)hserialprot->Parameter2, "on")){
+		on = 1;
+	}else if(!strcmp((char *)hserialprot->Parameter2, "off")){
+		on = 0;
+	}else{
+		return 1;
+	}
+
+	const GPIOTABLE_DescriptorTypeDef *descriptor = MYLIB_GPIOTABLE_Find(hgpiotable, (char *)hserialprot->Parameter1);
+	if(descriptor == NULL || MYLIB_GPIOTABLE_Write(descriptor, on) != HAL_OK){
+		return 1;
+	}
+	return 0;
+}
+
+/**
+  * @brief  Funktion 	berechnet den Hash eines Namens (FNV-1a, 32 Bit)
+  * @param  Name 		nullterminierter Name
+  * @retval Hash
+  */
+static uint32_t GPIOTABLE_Hash(const char *Name){
+
+	uint32_t hash = 2166136261U;
+
+	while(*Name != 0){
+		hash ^= (uint8_t)*Name++;
+		hash *= 16777619U;
+	}
+	return hash;
+}
+
+/**
+  * @brief  Funktion 	schaltet den Takt des GPIO-Ports ein
+  * @param  Port 		GPIO-Port
+  * @retval none
+  */
+static void GPIOTABLE_EnableClock(GPIO_TypeDef *Port){
+
+	if(Port == GPIOA){
+		__HAL_RCC_GPIOA_CLK_ENABLE();
+	}else if(Port == GPIOB){
+		__HAL_RCC_GPIOB_CLK_ENABLE();
+	}else if(Port == GPIOC){
+		__HAL_RCC_GPIOC_CLK_ENABLE();
+	}else if(Port == GPIOH){
+		__HAL_RCC_GPIOH_CLK_ENABLE();
+	}
+}
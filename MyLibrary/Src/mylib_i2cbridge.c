@@ -0,0 +1,379 @@
+/**
+******************************************************************************
+* @file mylib_i2cbridge.c
+* @author Reiter Roman
+* @brief mylib-I2C-Bridge.
+* Diese Datei stellt Protokoll-Kommandos für den Zugriff auf I2C-Slaves (Sensoren der Prüfvorrichtung) bereit:
+* + Warteschlange für Register-Lese- und Schreibübertragungen
+* + Ausführung im Interrupt-Betrieb des I2C (stm32l4xx_hal_i2c.c), die Kommandos blockieren nie
+* + Meldung der Ergebnisse als asynchrone Zeile an die Instanz, die das Kommando gesendet hat
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) I2C im Master-Betrieb initialisieren (z.B. I2C1 auf PB6/PB7), EV- und ER-Interrupt mit der NVIC-Priorität der
+		Transportschichten (0), danach die Bridge daran binden
+		(+++) z.B.: MYLIB_I2CBRIDGE_Init(&hi2cbridge1, &hi2c1);
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen
+		(+++) z.B.: return MYLIB_I2CBRIDGE_Command(&hi2cbridge1, hserialprot, Result);
+
+	(#) HAL-Callbacks und den ER-Interrupt weiterreichen
+		(+) HAL_I2C_MasterTxCpltCallback(), HAL_I2C_MasterRxCpltCallback(), HAL_I2C_ErrorCallback()
+			(++) Die Funktionen ignorieren Aufrufe für andere I2C, sie können also neben der I2C-Slave-Transportschicht aufgerufen werden
+		(+) MYLIB_I2CBRIDGE_ER_IRQHandler() im I2Cx_ER_IRQHandler() vor HAL_I2C_ER_IRQHandler() aufrufen (SCL-Timeout, siehe unten)
+
+	(#) Kommandos (alle Werte dezimal)
+		(+) "#isl,<adr>:0"  wählt die 7-Bit-Adresse des Slaves (0..127) für die folgenden Kommandos
+		(+) "#ird,<reg>:<n>" liest n Bytes (1..16) ab Register reg
+		(+) "#iwr,<reg>:<val>" schreibt das Byte val in das Register reg
+		(+) "#ibf,<val>:0"  hängt das Byte val an den Burst-Puffer an, "=> #a,<n>" meldet den Füllstand
+		(+) "#ibw,<reg>:0"  schreibt den Burst-Puffer ab Register reg und leert ihn
+		(+) "ird", "iwr" und "ibw" werden sofort mit "=> #a,<id>" bestätigt, sobald die Übertragung in der Warteschlange steht,
+			bei voller Warteschlange folgt ein NACK
+		(+) Nach der Übertragung folgt die Zeile "=> #e,i2c,<id>,<status>[,<daten>]"
+			(++) status: ok, nak (Slave antwortet nicht), err (Busfehler/Arbitrierung), tmo (SCL-Timeout)
+			(++) daten: beim Lesen die Bytes als Hex-Stellen, z.B. "=> #e,i2c,7,ok,1AFF"
+
+	(#) Timeout
+		(+) Der I2C überwacht mit der Timeout-Erkennung (TIMEOUTR), ob SCL länger als I2CBRIDGE_TIMEOUT_MS Low gehalten wird.
+			In diesem Fall wird der I2C neu initialisiert und die laufende Übertragung mit "tmo" beendet.
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_i2cbridge.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/** @defgroup I2CBRIDGE_Private_Constants
+  * @{
+  */
+#define I2CBRIDGE_PHASE_REGISTER 0
+#define I2CBRIDGE_PHASE_DATA 1
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup I2CBRIDGE_Private_Functions
+  * @{
+  */
+static void I2CBRIDGE_ConfigTimeout(I2CBRIDGE_TypeDef *hbridge);
+static uint8_t I2CBRIDGE_Enqueue(I2CBRIDGE_TypeDef *hbridge, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Read,
+								 uint8_t Register, const uint8_t * pData, uint8_t Length, uint8_t * Result);
+static void I2CBRIDGE_StartNext(I2CBRIDGE_TypeDef *hbridge);
+static void I2CBRIDGE_Complete(I2CBRIDGE_TypeDef *hbridge, const char * Status);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	bindet die Bridge an einen initialisierten I2C im Master-Betrieb und aktiviert die SCL-Timeout-Erkennung
+  * @param  hbridge 	I2CBRIDGE handle
+  * @param  hi2c 		I2C handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_I2CBRIDGE_Init(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c){
+
+	memset(hbridge,0,sizeof(I2CBRIDGE_TypeDef));
+	hbridge->hi2c = hi2c;
+	I2CBRIDGE_ConfigTimeout(hbridge);
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos der Bridge aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hbridge 	I2CBRIDGE handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_I2CBRIDGE_Command(I2CBRIDGE_TypeDef *hbridge, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"isl") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"ird")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"iwr") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"ibf")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"ibw")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos der Bridge haben zwei Zahlen als Parameter */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	uint16_t param1 = atoi((char *)hserialprot->Parameter1);
+	uint16_t param2 = atoi((char *)hserialprot->Parameter2);
+
+	/* Slave-Adresse wählen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"isl")){
+		if(param1 > 127 || param2 != 0){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hbridge->Address = param1;
+		return SERIALPROT_COMMAND_OK;
+
+	/* Register lesen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"ird")){
+		if(param1 > 255 || param2 == 0 || param2 > I2CBRIDGE_DATA_SIZE){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		return I2CBRIDGE_Enqueue(hbridge, hserialprot, 1, param1, NULL, param2, Result);
+
+	/* ein Byte schreiben */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"iwr")){
+		if(param1 > 255 || param2 > 255){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		uint8_t value = param2;
+		return I2CBRIDGE_Enqueue(hbridge, hserialprot, 0, param1, &value, 1, Result);
+
+	/* Byte an den Burst-Puffer anhängen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"ibf")){
+		if(param1 > 255 || param2 != 0 || hbridge->BurstLength >= I2CBRIDGE_DATA_SIZE){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hbridge->Burst[hbridge->BurstLength++] = param1;
+		itoa(hbridge->BurstLength, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Burst-Puffer schreiben */
+	}else{
+		if(param1 > 255 || param2 != 0 || hbridge->BurstLength == 0){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		uint8_t status = I2CBRIDGE_Enqueue(hbridge, hserialprot, 0, param1, hbridge->Burst, hbridge->BurstLength, Result);
+		if(status == SERIALPROT_COMMAND_OK){
+			hbridge->BurstLength = 0;
+		}
+		return status;
+	}
+}
+
+/**
+  * @brief  Funktion 	im I2Cx_ER_IRQHandler() vor HAL_I2C_ER_IRQHandler() aufzurufen: behandelt den SCL-Timeout, den der HAL-Treiber nicht kennt
+  * @param  hbridge 	I2CBRIDGE handle
+  * @retval none
+  */
+void MYLIB_I2CBRIDGE_ER_IRQHandler(I2CBRIDGE_TypeDef *hbridge){
+
+	I2C_HandleTypeDef *hi2c = hbridge->hi2c;
+
+	if(hi2c == NULL || __HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_TIMEOUT) == RESET){
+		return;
+	}
+
+	/* Ein Slave hält SCL fest: I2C zurücksetzen, damit die Warteschlange weiterläuft */
+	__HAL_I2C_CLEAR_FLAG(hi2c, I2C_FLAG_TIMEOUT);
+	HAL_I2C_DeInit(hi2c);
+	HAL_I2C_Init(hi2c);
+	I2CBRIDGE_ConfigTimeout(hbridge);
+
+	if(hbridge->Busy){
+		I2CBRIDGE_Complete(hbridge, "tmo");
+	}
+	I2CBRIDGE_StartNext(hbridge);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_MasterTxCpltCallback() aufzurufen: Registeradresse bzw. Daten gesendet
+  * @param  hbridge 	I2CBRIDGE handle
+  * @param  hi2c 		I2C handle des Callbacks
+  * @retval none
+  */
+void MYLIB_I2CBRIDGE_MasterTxCpltCallback(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c){
+
+	if(hi2c != hbridge->hi2c || !hbridge->Busy){
+		return;
+	}
+
+	I2CBRIDGE_TransactionTypeDef *transaction = &hbridge->Queue[hbridge->QueueTail];
+
+	if(transaction->Read && hbridge->Phase == I2CBRIDGE_PHASE_REGISTER){
+		/* Registeradresse gesendet: mit wiederholter Startbedingung lesen */
+		hbridge->Phase = I2CBRIDGE_PHASE_DATA;
+		if(HAL_I2C_Master_Seq_Receive_IT(hi2c, transaction->Address << 1, &transaction->Data[1],
+										 transaction->Length, I2C_LAST_FRAME) == HAL_OK){
+			return;
+		}
+		I2CBRIDGE_Complete(hbridge, "err");
+	}else{
+		I2CBRIDGE_Complete(hbridge, "ok");
+	}
+	I2CBRIDGE_StartNext(hbridge);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_MasterRxCpltCallback() aufzurufen: Daten empfangen
+  * @param  hbridge 	I2CBRIDGE handle
+  * @param  hi2c 		I2C handle des Callbacks
+  * @retval none
+  */
+void MYLIB_I2CBRIDGE_MasterRxCpltCallback(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c){
+
+	if(hi2c != hbridge->hi2c || !hbridge->Busy){
+		return;
+	}
+
+	I2CBRIDGE_Complete(hbridge, "ok");
+	I2CBRIDGE_StartNext(hbridge);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_ErrorCallback() aufzurufen: Slave antwortet nicht (NACK) oder Busfehler
+  * @param  hbridge 	I2CBRIDGE handle
+  * @param  hi2c 		I2C handle des Callbacks
+  * @retval none
+  */
+void MYLIB_I2CBRIDGE_ErrorCallback(I2CBRIDGE_TypeDef *hbridge, I2C_HandleTypeDef *hi2c){
+
+	if(hi2c != hbridge->hi2c || !hbridge->Busy){
+		return;
+	}
+
+	if(HAL_I2C_GetError(hi2c) == HAL_I2C_ERROR_AF){
+		I2CBRIDGE_Complete(hbridge, "nak");
+	}else{
+		I2CBRIDGE_Complete(hbridge, "err");
+	}
+	I2CBRIDGE_StartNext(hbridge);
+}
+
+/**
+  * @brief  Funktion 	aktiviert die Erkennung "SCL länger als I2CBRIDGE_TIMEOUT_MS Low" (TIMEOUTA in Schritten von 2048 I2C-Takten)
+  * @param  hbridge 	I2CBRIDGE handle
+  * @retval none
+  */
+static void I2CBRIDGE_ConfigTimeout(I2CBRIDGE_TypeDef *hbridge){
+
+	uint32_t timeouta = (HAL_RCC_GetPCLK1Freq() / 1000U) * I2CBRIDGE_TIMEOUT_MS / 2048U;
+
+	if(timeouta > 0){
+		timeouta--;
+	}
+	if(timeouta > I2C_TIMEOUTR_TIMEOUTA){
+		timeouta = I2C_TIMEOUTR_TIMEOUTA;
+	}
+
+	/* TIMEOUTA darf nur bei gesperrter Erkennung geändert werden */
+	hbridge->hi2c->Instance->TIMEOUTR &= ~I2C_TIMEOUTR_TIMOUTEN;
+	hbridge->hi2c->Instance->TIMEOUTR = timeouta;
+	hbridge->hi2c->Instance->TIMEOUTR |= I2C_TIMEOUTR_TIMOUTEN;
+}
+
+/**
+  * @brief  Funktion 	stellt eine Übertragung in die Warteschlange und startet sie, falls der I2C frei ist
+  * @param  hbridge 	I2CBRIDGE handle
+  * @param  hserialprot Instanz, an die das Ergebnis gemeldet wird
+  * @param  Read 		1: lesen, 0: schreiben
+  * @param  Register 	Registeradresse im Slave
+  * @param  pData 		zu schreibende Bytes (NULL beim Lesen)
+  * @param  Length 		Anzahl der Datenbytes
+  * @param  Result 		Ergebnispuffer, erhält die Kennung der Übertragung
+  * @retval SERIALPROT_COMMAND_OK oder SERIALPROT_COMMAND_INVALID (Warteschlange voll)
+  */
+static uint8_t I2CBRIDGE_Enqueue(I2CBRIDGE_TypeDef *hbridge, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Read,
+								 uint8_t Register, const uint8_t * pData, uint8_t Length, uint8_t * Result){
+
+	if(hbridge->QueueCount >= I2CBRIDGE_QUEUE_SIZE){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	I2CBRIDGE_TransactionTypeDef *transaction = &hbridge->Queue[hbridge->QueueHead];
+
+	transaction->Id = hbridge->NextId++;
+	transaction->Address = hbridge->Address;
+	transaction->Read = Read;
+	transaction->Length = Length;
+	transaction->Data[0] = Register;
+	if(pData != NULL){
+		memcpy(&transaction->Data[1], pData, Length);
+	}
+	transaction->hserialprot = hserialprot;
+
+	hbridge->QueueHead = (hbridge->QueueHead + 1) % I2CBRIDGE_QUEUE_SIZE;
+	hbridge->QueueCount++;
+
+	itoa(transaction->Id, (char *)Result, 10);
+
+	I2CBRIDGE_StartNext(hbridge);
+	return SERIALPROT_COMMAND_OK;
+}
+
+/**
+  * @brief  Funktion 	startet die nächste Übertragung der Warteschlange, falls der I2C frei ist
+  * @param  hbridge 	I2CBRIDGE handle
+  * @retval none
+  */
+static void I2CBRIDGE_StartNext(I2CBRIDGE_TypeDef *hbridge){
+
+	while(!hbridge->Busy && hbridge->QueueCount > 0){
+
+		I2CBRIDGE_TransactionTypeDef *transaction = &hbridge->Queue[hbridge->QueueTail];
+		HAL_StatusTypeDef status;
+
+		hbridge->Busy = 1;
+		if(transaction->Read){
+			/* zuerst nur die Registeradresse, ohne Stoppbedingung */
+			hbridge->Phase = I2CBRIDGE_PHASE_REGISTER;
+			status = HAL_I2C_Master_Seq_Transmit_IT(hbridge->hi2c, transaction->Address << 1, transaction->Data, 1, I2C_FIRST_FRAME);
+		}else{
+			/* Registeradresse und Daten in einem Rahmen */
+			hbridge->Phase = I2CBRIDGE_PHASE_DATA;
+			status = HAL_I2C_Master_Seq_Transmit_IT(hbridge->hi2c, transaction->Address << 1, transaction->Data,
+													transaction->Length + 1, I2C_FIRST_AND_LAST_FRAME);
+		}
+
+		if(status != HAL_OK){
+			I2CBRIDGE_Complete(hbridge, "err");
+		}
+	}
+}
+
+/**
+  * @brief  Funktion 	meldet das Ergebnis der laufenden Übertragung an ihre Instanz und entfernt sie aus der Warteschlange
+  * @param  hbridge 	I2CBRIDGE handle
+  * @param  Status 		"ok", "nak", "err" oder "tmo"
+  * @retval none
+  */
+static void I2CBRIDGE_Complete(I2CBRIDGE_TypeDef *hbridge, const char * Status){
+
+	static const char digits[] = "0123456789ABCDEF";
+	I2CBRIDGE_TransactionTypeDef *transaction = &hbridge->Queue[hbridge->QueueTail];
+	uint8_t event[16 + 2 * I2CBRIDGE_DATA_SIZE] = "i2c,";
+
+	itoa(transaction->Id, (char *)event + strlen((char *)event), 10);
+	strcat((char *)event, ",");
+	strcat((char *)event, Status);
+
+	if(!strcmp(Status, "ok")){
+		hbridge->Completed++;
+		/* gelesene Bytes als Hex-Stellen anhängen */
+		if(transaction->Read){
+			uint8_t * result;
+			strcat((char *)event, ",");
+			result = event + strlen((char *)event);
+			for(uint8_t i=0; i<transaction->Length; i++){
+				*result++ = digits[transaction->Data[1 + i] >> 4];
+				*result++ = digits[transaction->Data[1 + i] & 0x0F];
+			}
+			*result = 0;
+		}
+	}else{
+		hbridge->Failed++;
+	}
+
+	MYLIB_SERIALPROT_Event(transaction->hserialprot, event);
+
+	hbridge->QueueTail = (hbridge->QueueTail + 1) % I2CBRIDGE_QUEUE_SIZE;
+	hbridge->QueueCount--;
+	hbridge->Busy = 0;
+}
@@ -0,0 +1,487 @@
+/**
+******************************************************************************
+* @file mylib_logic.c
+* @author Reiter Roman
+* @brief mylib-Logikanalysator.
+* Diese Datei macht aus dem Board einen einfachen Logikanalysator für die Pins eines Ports:
+* + Das Update-Ereignis eines Basis-Timers fordert je Abtastung eine DMA-Übertragung GPIOx->IDR -> RAM an,
+*   der Puffer ist zirkulär, Halb- und Vollständig-Interrupt der DMA geben je eine Hälfte zur Kodierung frei
+* + Die Abtastwerte werden sofort lauflängenkodiert (Pegel der Kanäle, Anzahl gleicher Abtastwerte)
+* + Vor dem Trigger füllen die Läufe einen Ring, nach dem Trigger wird er zuerst gesendet, danach die folgenden Läufe
+* + Gesendet wird als asynchrone Meldung über die Instanz, die die Aufzeichnung gestartet hat, Kommandos bleiben möglich
+* + Wahlweise werden die Läufe mit mylib_encode gepackt (Pegel und Länge je als Zig-Zag-Delta, optional LZ),
+*   periodische Signale brauchen dann nur einen Bruchteil der Zeichen
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Takt des Timers und der DMA einschalten, Interrupt des DMA-Kanals freigeben (Priorität 0 wie die Transportschichten)
+		(+) Die aufgezeichneten Pins werden nicht verändert, sie können Ein- oder Ausgänge sein
+
+	(#) Konfiguration eintragen und den Logikanalysator initialisieren
+		(+++) z.B.: hlogic.Init.Timer = TIM7;
+		(+++) z.B.: hlogic.Init.Channel = DMA2_Channel5; hlogic.Init.DmaRequest = 3;
+		(+++) z.B.: hlogic.Init.Port = GPIOA;
+		(+++) z.B.: MYLIB_LOGIC_Init(&hlogic);
+
+	(#) Interrupt des DMA-Kanals weiterreichen
+		(+++) DMA2_Channel5_IRQHandler ()  -> MYLIB_LOGIC_DMA_IRQHandler(&hlogic)
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen (alle Werte dezimal)
+		(+++) z.B.: return MYLIB_LOGIC_Command(&hlogic, hserialprot, Result);
+		(+) "#lch,<pin>:<0|1>"    nimmt Pin 0..15 des Ports als Kanal auf bzw. heraus, "=> #a,<maske>"
+		(+) "#ltg,<pin>:<flanke>" Trigger an Pin 0..15: 0 fallend, 1 steigend, 2 beide, 3 ohne Trigger (Pin beliebig),
+			der Pin wird als Kanal aufgenommen
+		(+) "#lar,<us>:<ms>"      startet die Abtastung mit <us> Periode (LOGIC_PERIOD_MIN_US..LOGIC_PERIOD_MAX_US),
+			nach dem Trigger wird <ms> lang (1..9999) aufgezeichnet, "=> #a,<abtastwerte nach dem trigger>"
+		(+) "#las,0:0"            bricht die Aufzeichnung ab, "=> #a,<gesendete läufe>"
+		(+) "#lae,<m>:0"          Format der Läufe: 0 Hex, 1 Delta + Varint, 2 Delta + Varint + LZ, "=> #a,<m>"
+		(+) Während der Aufzeichnung werden "lch", "ltg" und "lae" mit NACK abgewiesen
+
+	(#) Meldungen, je Lauf 8 Hex-Stellen ohne Trennzeichen: 4 Stellen Pegel (IDR & maske), 4 Stellen Anzahl Abtastwerte
+		(+) "=> #e,la,p,<läufe>"  Läufe vor dem Trigger (bis LOGIC_PRE_RUNS, der letzte endet mit dem Trigger)
+		(+) "=> #e,la,d,<läufe>"  Läufe ab dem Trigger
+		(+) "=> #e,lz,<p|d>,<m>,<daten>"  dieselben Läufe gepackt (Format 1 und 2, abwechselnd Pegel und Länge),
+			Tools/encode_decode.c macht am Host wieder "la"-Zeilen daraus
+		(+) "=> #e,la,end,<n>"    Aufzeichnung vollständig, n gesendete Läufe
+		(+) "=> #e,la,ovf,<n>"    Abbruch, weil die Verbindung die Läufe nicht mehr abnehmen konnte
+		(+) "=> #e,la,err,<n>"    Abbruch wegen eines DMA-Fehlers
+
+	(#) Grenzen
+		(+) Die Verbindung begrenzt die Anzahl der Flanken je Sekunde, nicht die Abtastrate:
+			bei 115200 Baud etwa 1000 Läufe pro Sekunde, schnellere Signale führen zu "ovf"
+		(+) Zeitauflösung ist die Abtastperiode, kürzere Pulse können verloren gehen
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_logic.h"
+#include "mylib_dmachannel.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup LOGIC_Private_Functions
+  * @{
+  */
+static void LOGIC_Encode(LOGIC_TypeDef *hlogic, const uint16_t *Samples, uint16_t Count);
+static uint8_t LOGIC_IsTrigger(LOGIC_TypeDef *hlogic, uint16_t Old, uint16_t New);
+static void LOGIC_Emit(LOGIC_TypeDef *hlogic, const LOGIC_RunTypeDef *Run);
+static void LOGIC_Trigger(LOGIC_TypeDef *hlogic);
+static HAL_StatusTypeDef LOGIC_SendLine(LOGIC_TypeDef *hlogic, const char *Kind, const LOGIC_RunTypeDef *Runs, uint8_t Count);
+static void LOGIC_Finish(LOGIC_TypeDef *hlogic, const char *Status);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet Timer und DMA-Request ein, ohne Kanäle und ohne Trigger
+  * @param  hlogic 		LOGIC handle mit ausgefüllter Konfiguration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_LOGIC_Init(LOGIC_TypeDef *hlogic){
+
+	TIM_TypeDef *timer = hlogic->Init.Timer;
+	DMA_Channel_TypeDef *channel = hlogic->Init.Channel;
+
+	if(HAL_RCC_GetPCLK1Freq() % LOGIC_COUNTER_CLOCK != 0U){
+		return HAL_ERROR;
+	}
+
+	hlogic->Mask = 0;
+	hlogic->TriggerPin = 0;
+	hlogic->TriggerEdge = LOGIC_EDGE_NONE;
+	hlogic->Encoding = ENCODE_MODE_HEX;
+	hlogic->State = LOGIC_STATE_IDLE;
+	hlogic->RunsSent = 0;
+	hlogic->hserialprot = NULL;
+
+	channel->CCR &= ~DMA_CCR_EN;
+	MYLIB_DMACHANNEL_SetRequest(channel, hlogic->Init.DmaRequest);
+
+	/* URS: nur der Überlauf erzeugt einen DMA-Request, nicht das Laden des Vorteilers mit UG */
+	timer->CR1 = TIM_CR1_URS;
+	timer->DIER = 0;
+	timer->PSC = HAL_RCC_GetPCLK1Freq() / LOGIC_COUNTER_CLOCK - 1U;
+	timer->EGR = TIM_EGR_UG;
+	timer->SR = 0;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	startet die Abtastung, ohne Trigger beginnt die Aufzeichnung sofort
+  * @param  hlogic 		LOGIC handle
+  * @param  PeriodUs 	Abtastperiode in µs (LOGIC_PERIOD_MIN_US..LOGIC_PERIOD_MAX_US)
+  * @param  PostSamples Anzahl der Abtastwerte ab dem Trigger
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_LOGIC_Start(LOGIC_TypeDef *hlogic, uint16_t PeriodUs, uint32_t PostSamples){
+
+	TIM_TypeDef *timer = hlogic->Init.Timer;
+	DMA_Channel_TypeDef *channel = hlogic->Init.Channel;
+
+	if(hlogic->Mask == 0 || PostSamples == 0 || PeriodUs < LOGIC_PERIOD_MIN_US || PeriodUs > LOGIC_PERIOD_MAX_US){
+		return HAL_ERROR;
+	}
+
+	MYLIB_LOGIC_Stop(hlogic);
+
+	hlogic->PostRemaining = PostSamples;
+	hlogic->Run.Length = 0;
+	hlogic->PreHead = 0;
+	hlogic->PreCount = 0;
+	hlogic->LineCount = 0;
+	hlogic->RunsSent = 0;
+
+	/* IDR -> Speicher, 16 Bit, zirkulär mit Halb- und Vollständig-Interrupt */
+	MYLIB_DMACHANNEL_ClearFlags(channel);
+	channel->CPAR = (uint32_t)&hlogic->Init.Port->IDR;
+	channel->CMAR = (uint32_t)hlogic->Buffer;
+	channel->CNDTR = LOGIC_BUFFER_SIZE;
+	channel->CCR = DMA_CCR_PL_0 | DMA_CCR_MSIZE_0 | DMA_CCR_PSIZE_0 | DMA_CCR_MINC | DMA_CCR_CIRC
+					| DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_TEIE;
+	channel->CCR |= DMA_CCR_EN;
+
+	hlogic->State = (hlogic->TriggerEdge == LOGIC_EDGE_NONE) ? LOGIC_STATE_TRIGGERED : LOGIC_STATE_ARMED;
+
+	/* die erste Abtastung folgt nach einem Zähltakt, danach je Periode */
+	timer->ARR = PeriodUs - 1U;
+	timer->CNT = PeriodUs - 1U;
+	timer->SR = 0;
+	timer->DIER = TIM_DIER_UDE;
+	timer->CR1 |= TIM_CR1_CEN;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	hält die Abtastung sofort an, noch nicht gesendete Läufe werden verworfen
+  * @param  hlogic 		LOGIC handle
+  * @retval none
+  */
+void MYLIB_LOGIC_Stop(LOGIC_TypeDef *hlogic){
+
+	hlogic->Init.Timer->CR1 &= ~TIM_CR1_CEN;
+	hlogic->Init.Timer->DIER = 0;
+	hlogic->Init.Channel->CCR &= ~DMA_CCR_EN;
+	hlogic->State = LOGIC_STATE_IDLE;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos des Logikanalysators aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hlogic 		LOGIC handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_LOGIC_Command(LOGIC_TypeDef *hlogic, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"lch") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"ltg")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"lar") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"las")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"lae")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos des Logikanalysators haben zwei Zahlen als Parameter */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	uint16_t param1 = atoi((char *)hserialprot->Parameter1);
+	uint16_t param2 = atoi((char *)hserialprot->Parameter2);
+
+	/* Kanal aufnehmen bzw. herausnehmen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"lch")){
+		if(hlogic->State != LOGIC_STATE_IDLE || param1 > 15 || param2 > 1){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		if(param2){
+			hlogic->Mask |= 1U << param1;
+		}else{
+			hlogic->Mask &= ~(1U << param1);
+		}
+		utoa(hlogic->Mask, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Trigger */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"ltg")){
+		if(hlogic->State != LOGIC_STATE_IDLE || param1 > 15 || param2 > LOGIC_EDGE_NONE){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hlogic->TriggerEdge = (LOGIC_EdgeTypeDef)param2;
+		hlogic->TriggerPin = (param2 == LOGIC_EDGE_NONE) ? 0U : (1U << param1);
+		hlogic->Mask |= hlogic->TriggerPin;
+		utoa(hlogic->Mask, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Format der Läufe */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"lae")){
+		if(hlogic->State != LOGIC_STATE_IDLE || param1 > ENCODE_MODE_DELTA_LZ){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hlogic->Encoding = (ENCODE_ModeTypeDef)param1;
+		utoa(param1, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Abtastung starten */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"lar")){
+		uint32_t samples = (param1 != 0) ? (uint32_t)param2 * 1000U / param1 : 0U;
+
+		hlogic->hserialprot = hserialprot;
+		if(MYLIB_LOGIC_Start(hlogic, param1, samples) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa(samples, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Aufzeichnung abbrechen */
+	}else{
+		MYLIB_LOGIC_Stop(hlogic);
+		utoa(hlogic->RunsSent, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des DMA-Kanals aufzurufen: kodiert die jeweils fertige Pufferhälfte
+  * @param  hlogic 		LOGIC handle
+  * @retval none
+  */
+void MYLIB_LOGIC_DMA_IRQHandler(LOGIC_TypeDef *hlogic){
+
+	DMA_Channel_TypeDef *channel = hlogic->Init.Channel;
+	uint32_t flags = MYLIB_DMACHANNEL_GetFlags(channel);
+
+	if(hlogic->State == LOGIC_STATE_IDLE){
+		return;
+	}
+
+	if(flags & DMA_ISR_TEIF1){
+		/* Übertragungsfehler: der Kanal wurde von der DMA abgeschaltet */
+		MYLIB_LOGIC_Stop(hlogic);
+		LOGIC_Finish(hlogic, "err");
+		return;
+	}
+
+	if(flags & DMA_ISR_HTIF1){
+		LOGIC_Encode(hlogic, &hlogic->Buffer[0], LOGIC_BUFFER_SIZE / 2);
+	}
+	if((flags & DMA_ISR_TCIF1) && hlogic->State != LOGIC_STATE_IDLE){
+		LOGIC_Encode(hlogic, &hlogic->Buffer[LOGIC_BUFFER_SIZE / 2], LOGIC_BUFFER_SIZE / 2);
+	}
+}
+
+/**
+  * @brief  Funktion 	kodiert Abtastwerte in Läufe, erkennt den Trigger und beendet die Aufzeichnung nach PostRemaining Werten
+  * @param  hlogic 		LOGIC handle
+  * @param  Samples 	Abtastwerte (IDR)
+  * @param  Count 		Anzahl der Abtastwerte
+  * @retval none
+  */
+static void LOGIC_Encode(LOGIC_TypeDef *hlogic, const uint16_t *Samples, uint16_t Count){
+
+	LOGIC_RunTypeDef *run = &hlogic->Run;
+
+	for(uint16_t i=0; i<Count && hlogic->State != LOGIC_STATE_IDLE; i++){
+		uint16_t value = Samples[i] & hlogic->Mask;
+
+		if(run->Length == 0){
+			run->Value = value;
+			run->Length = 1;
+		}else if(value == run->Value && run->Length < LOGIC_RUN_MAX){
+			run->Length++;
+		}else{
+			uint8_t trigger = (hlogic->State == LOGIC_STATE_ARMED) && LOGIC_IsTrigger(hlogic, run->Value, value);
+
+			LOGIC_Emit(hlogic, run);
+			run->Value = value;
+			run->Length = 1;
+			if(trigger){
+				LOGIC_Trigger(hlogic);
+			}
+		}
+
+		/* der Wert mit dem Trigger ist der erste aufgezeichnete */
+		if(hlogic->State == LOGIC_STATE_TRIGGERED && --hlogic->PostRemaining == 0){
+			LOGIC_Emit(hlogic, run);
+			run->Length = 0;
+			if(hlogic->State == LOGIC_STATE_TRIGGERED){
+				MYLIB_LOGIC_Stop(hlogic);
+				if(hlogic->LineCount > 0 && LOGIC_SendLine(hlogic, "d", hlogic->Line, hlogic->LineCount) != HAL_OK){
+					LOGIC_Finish(hlogic, "ovf");
+					return;
+				}
+				LOGIC_Finish(hlogic, "end");
+			}
+		}
+	}
+}
+
+/**
+  * @brief  Funktion 	prüft, ob der Wechsel zwischen zwei Abtastwerten die Triggerbedingung erfüllt
+  * @param  hlogic 		LOGIC handle
+  * @param  Old 		bisheriger Pegel der Kanäle
+  * @param  New 		neuer Pegel der Kanäle
+  * @retval 1 = Trigger, 0 = kein Trigger
+  */
+static uint8_t LOGIC_IsTrigger(LOGIC_TypeDef *hlogic, uint16_t Old, uint16_t New){
+
+	uint16_t pin = hlogic->TriggerPin;
+
+	if(((Old ^ New) & pin) == 0){
+		return 0;
+	}
+	switch(hlogic->TriggerEdge){
+	case LOGIC_EDGE_FALLING:
+		return (New & pin) == 0;
+	case LOGIC_EDGE_RISING:
+		return (New & pin) != 0;
+	case LOGIC_EDGE_BOTH:
+		return 1;
+	default:
+		return 0;
+	}
+}
+
+/**
+  * @brief  Funktion 	legt einen abgeschlossenen Lauf ab: vor dem Trigger im Vortrigger-Ring, danach in der nächsten Zeile
+  * @param  hlogic 		LOGIC handle
+  * @param  Run 		abgeschlossener Lauf
+  * @retval none
+  */
+static void LOGIC_Emit(LOGIC_TypeDef *hlogic, const LOGIC_RunTypeDef *Run){
+
+	if(hlogic->State == LOGIC_STATE_ARMED){
+		/* ältesten Lauf überschreiben */
+		hlogic->Pre[hlogic->PreHead] = *Run;
+		hlogic->PreHead = (hlogic->PreHead + 1U) % LOGIC_PRE_RUNS;
+		if(hlogic->PreCount < LOGIC_PRE_RUNS){
+			hlogic->PreCount++;
+		}
+		return;
+	}
+
+	hlogic->Line[hlogic->LineCount++] = *Run;
+	if(hlogic->LineCount == LOGIC_LINE_RUNS){
+		hlogic->LineCount = 0;
+		if(LOGIC_SendLine(hlogic, "d", hlogic->Line, LOGIC_LINE_RUNS) != HAL_OK){
+			MYLIB_LOGIC_Stop(hlogic);
+			LOGIC_Finish(hlogic, "ovf");
+		}
+	}
+}
+
+/**
+  * @brief  Funktion 	Trigger erkannt: sendet den Vortrigger-Ring (ältester Lauf zuerst), danach werden die Läufe gestreamt
+  * @param  hlogic 		LOGIC handle
+  * @retval none
+  */
+static void LOGIC_Trigger(LOGIC_TypeDef *hlogic){
+
+	LOGIC_RunTypeDef runs[LOGIC_LINE_RUNS];
+	uint8_t index = (hlogic->PreHead + LOGIC_PRE_RUNS - hlogic->PreCount) % LOGIC_PRE_RUNS;
+	uint8_t count = 0;
+
+	hlogic->State = LOGIC_STATE_TRIGGERED;
+
+	while(hlogic->PreCount > 0){
+		runs[count++] = hlogic->Pre[index];
+		index = (index + 1U) % LOGIC_PRE_RUNS;
+		hlogic->PreCount--;
+
+		if(count == LOGIC_LINE_RUNS || hlogic->PreCount == 0){
+			if(LOGIC_SendLine(hlogic, "p", runs, count) != HAL_OK){
+				MYLIB_LOGIC_Stop(hlogic);
+				LOGIC_Finish(hlogic, "ovf");
+				return;
+			}
+			count = 0;
+		}
+	}
+}
+
+/**
+  * @brief  Funktion 	sendet Läufe als Meldung "=> #e,la,<Kind>,<läufe>" bzw. gepackt "=> #e,lz,<Kind>,<m>,<daten>"
+  * @param  hlogic 		LOGIC handle
+  * @param  Kind 		"p" vor dem Trigger, "d" ab dem Trigger
+  * @param  Runs 		Läufe
+  * @param  Count 		Anzahl der Läufe (max. LOGIC_LINE_RUNS)
+  * @retval HAL status (HAL_BUSY, wenn die Sendewarteschlange voll ist)
+  */
+static HAL_StatusTypeDef LOGIC_SendLine(LOGIC_TypeDef *hlogic, const char *Kind, const LOGIC_RunTypeDef *Runs, uint8_t Count){
+
+	static const char digits[] = "0123456789ABCDEF";
+	uint8_t event[10 + LOGIC_LINE_RUNS * 8] = "la,";	/* gepackt bis 66 Zeichen Base64 bei 8 Läufen */
+	uint8_t *pos;
+
+	if(hlogic->hserialprot == NULL){
+		return HAL_OK;
+	}
+
+	if(hlogic->Encoding != ENCODE_MODE_HEX){
+		event[1] = 'z';
+	}
+	strcat((char *)event, Kind);
+	strcat((char *)event, ",");
+	pos = event + strlen((char *)event);
+
+	if(hlogic->Encoding == ENCODE_MODE_HEX){
+		/* je Lauf 4 Hex-Stellen Pegel und 4 Hex-Stellen Länge */
+		for(uint8_t i=0; i<Count; i++){
+			uint32_t word = ((uint32_t)Runs[i].Value << 16) | Runs[i].Length;
+			for(int8_t d=7; d>=0; d--){
+				pos[d] = digits[word & 0x0F];
+				word >>= 4;
+			}
+			pos += 8;
+		}
+		*pos = 0;
+	}else{
+		ENCODE_TypeDef encode;
+
+		/* je Lauf max. 2 x 3 Varint-Bytes (16-Bit-Differenzen), 8 Läufe passen in ENCODE_BYTES_MAX */
+		MYLIB_ENCODE_Begin(&encode, hlogic->Encoding, 2);
+		for(uint8_t i=0; i<Count; i++){
+			MYLIB_ENCODE_Put(&encode, Runs[i].Value);
+			MYLIB_ENCODE_Put(&encode, Runs[i].Length);
+		}
+		*pos++ = digits[hlogic->Encoding];
+		*pos++ = ',';
+		MYLIB_ENCODE_End(&encode, (char *)pos);
+	}
+
+	if(MYLIB_SERIALPROT_Event(hlogic->hserialprot, event) != HAL_OK){
+		return HAL_BUSY;
+	}
+	hlogic->RunsSent += Count;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	meldet das Ende der Aufzeichnung an die Instanz, die sie gestartet hat
+  * @param  hlogic 		LOGIC handle
+  * @param  Status 		"end", "ovf" oder "err"
+  * @retval none
+  */
+static void LOGIC_Finish(LOGIC_TypeDef *hlogic, const char *Status){
+
+	uint8_t event[24] = "la,";
+
+	if(hlogic->hserialprot == NULL){
+		return;
+	}
+
+	strcat((char *)event, Status);
+	strcat((char *)event, ",");
+	utoa(hlogic->RunsSent, (char *)event + strlen((char *)event), 10);
+	MYLIB_SERIALPROT_Event(hlogic->hserialprot, event);
+}
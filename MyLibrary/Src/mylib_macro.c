@@ -0,0 +1,572 @@
+/**
+******************************************************************************
+* @file mylib_macro.c
+* @author Reiter Roman
+* @brief mylib-Makros.
+* Diese Datei verwaltet benannte Folgen von Kommandozeilen in einer reservierten Flash-Seite:
+* + Ein Makro wird aufgezeichnet, indem die Zeilen wie gewohnt eingegeben werden (sie werden dabei auch ausgeführt)
+* + Ein einziges Kommando führt alle Zeilen eines Makros direkt hintereinander am Gerät aus,
+*   eine Einrichtung aus 20 Kommandos kostet so eine Runde über die Schnittstelle statt zwanzig
+* + Die Zeilen laufen über eine eigene Instanz des Protokolls ohne Transportschicht, wie eine empfangene Zeile
+* + Die Makros werden im RAM bearbeitet und mit einem Kommando in die Flash-Seite geschrieben
+*   (HAL_FLASHEx_Erase(), HAL_FLASH_Program()), nach dem Reset führt MYLIB_MACRO_Boot() das Makro "boot" aus
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Eine Flash-Seite (FLASH_PAGE_SIZE) ist im Linker-Skript vom Bereich FLASH ausgenommen
+		(+) Die Kommandos laufen mit der Priorität der Transportschichten, "mcs" hält die CPU für das Löschen
+			der Seite an (etwa 25 ms, siehe "mcs")
+
+	(#) Konfiguration eintragen und die Makros aus der Flash-Seite laden (nach allen Modulen, deren Kommandos verwendet werden)
+		(+++) z.B.: hmacro.Init.Page = 127;
+		(+++) z.B.: MYLIB_MACRO_Init(&hmacro);
+		(+++) z.B.: MYLIB_MACRO_Boot(&hmacro);
+
+	(#) Empfangene Zeichen für die Aufzeichnung übergeben
+		(+++) z.B.: void SERIALPROT_RxByte_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Byte)
+		(+++)       { MYLIB_MACRO_RxByte(&hmacro, hserialprot, Byte); }
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen
+		(+++) z.B.: return MYLIB_MACRO_Command(&hmacro, hserialprot, Result);
+		(+) "#mcb,<name>:0"      beginnt die Aufzeichnung des Makros name (1..4 Buchstaben, ersetzt ein gleichnamiges),
+			jede weitere Zeile "#..." dieser Schnittstelle wird ausgeführt und angehängt, "=> #a,<freie zeichen>"
+		(+) "#mcu,0:0"           entfernt die zuletzt aufgezeichnete Zeile (z.B. nach einem NACK), "=> #a,<zeilen>"
+		(+) "#mce,0:0"           beendet die Aufzeichnung, "=> #a,<zeilen>,<voll>,<abgewiesen>" (voll = 1: Zeilen passten
+			nicht mehr, abgewiesen: Zeilen mit Kommandos, die Meldungen senden)
+		(+) "#mcr,<name>:0"      führt das Makro aus, "=> #a,<ausgeführt>,<zeilen>", die Ausführung endet bei der ersten
+			Zeile mit NACK (ausgeführt < zeilen), Ergebnisse der Zeilen werden nicht gesendet
+		(+) "#mcd,<name>:0"      löscht das Makro, "=> #a,<freie zeichen>"
+		(+) "#mcl,<nr>:0"        Name des Makros nr (ab 0), "=> #a,<name>,<zeilen>"
+		(+) "#mcl,<name>:<z>"    Zeile z (ab 1) des Makros ohne '\r', "=> #a,<zeile>", z = 0 liefert die Anzahl der Zeilen
+		(+) "#mcs,0:0"           schreibt alle Makros in die Flash-Seite, "=> #a,<zeichen>"
+			(++) Beim Löschen der Seite (etwa 25 ms) hält jeder Zugriff auf den Flash an, auch aus anderen Interrupts
+				(das Verschieben in die Hauptschleife hilft nicht, der Code liegt in derselben Flash-Bank):
+				(+++) per DMA empfangene Zeichen bleiben erhalten, UART im IT-Betrieb verliert Zeichen (Overrun)
+				(+++) Scheduler und Ringaufzeichnung (Vergleiche von TIM2) kommen so lange zu spät,
+					Aktionen des Schedulers laufen danach sofort, der Ringaufzeichnung fehlen die Abtastungen
+				(+++) "mcs" daher nur ohne laufende Übertragungen bzw. Messungen senden
+		(+) Während der Aufzeichnung werden "mcb", "mcr", "mcd" und "mcs" mit NACK abgewiesen,
+			die "mc"-Kommandos selbst werden nicht aufgezeichnet, Makros dürfen keine Makros aufrufen
+		(+) Kommandos, die später Meldungen an ihre Instanz senden ("lar", "ads", "fqs", "cpa", "sqr", "vmr", "ird", "iwr", "ibw"),
+			werden bei der Aufzeichnung ausgeführt, aber nicht angehängt, und beim Ausführen wie ein NACK behandelt:
+			die eigene Instanz der Makros hat keine Transportschicht, die Meldungen hätten kein Ziel
+
+	(#) Beispiel
+		(+++) #mcb,boot:0  #pwm,rt:200  #adq,1000:1  #cps,1:1  #cpt,0:3000  #mce,0:0  #mcs,0:0
+		(+++) nach jedem Reset laufen die vier Zeilen ohne Eingabe, "#mcr,boot:0" wiederholt sie
+
+	(#) Grenzen
+		(+) Alle Makros zusammen haben MACRO_TEXT_SIZE Zeichen (je Zeile ihre Länge + 1, je Makro Name + 2)
+		(+) Änderungen gehen ohne "mcs" beim Reset verloren
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_macro.h"
+#include "stdlib.h"
+#include "string.h"
+#include "ctype.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/** @defgroup MACRO_Private_Constants
+  * @{
+  */
+#define MACRO_NONE 0xFFFFU						/*!< kein Makro gefunden */
+#define MACRO_ADDRESS(__PAGE__) (FLASH_BASE + (__PAGE__) * FLASH_PAGE_SIZE) /*!< Adresse einer Flash-Seite */
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/** @addtogroup MACRO_Private_Variables
+  * @{
+  */
+
+/* Kommandos, die ihre Instanz für spätere Meldungen behalten, in Makros nicht erlaubt */
+static const char * const MACRO_EventNames[] = {"lar", "ads", "fqs", "cpa", "sqr", "vmr", "ird", "iwr", "ibw"};
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup MACRO_Private_Functions
+  * @{
+  */
+static uint16_t MACRO_Find(MACRO_TypeDef *hmacro, const char * Name);
+static uint16_t MACRO_End(MACRO_TypeDef *hmacro, uint16_t Start);
+static uint16_t MACRO_Lines(MACRO_TypeDef *hmacro, uint16_t Start);
+static void MACRO_Delete(MACRO_TypeDef *hmacro, uint16_t Start);
+static uint8_t MACRO_IsName(const char * Name);
+static uint8_t MACRO_IsAllowed(const char * Line);
+static uint8_t MACRO_Execute(MACRO_TypeDef *hmacro, const char * Line);
+static uint16_t MACRO_Checksum(const MACRO_StoreTypeDef * Store);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	lädt die Makros aus der Flash-Seite, eine leere oder ungültige Seite ergibt keine Makros
+  * @param  hmacro 		MACRO handle mit ausgefüllter Konfiguration
+  * @retval HAL status (HAL_ERROR bei ungültiger Seitennummer)
+  */
+HAL_StatusTypeDef MYLIB_MACRO_Init(MACRO_TypeDef *hmacro){
+
+	const MACRO_StoreTypeDef *flash = (const MACRO_StoreTypeDef *)MACRO_ADDRESS(hmacro->Init.Page);
+
+	if(!IS_FLASH_PAGE(hmacro->Init.Page)){
+		return HAL_ERROR;
+	}
+
+	hmacro->hrecord = NULL;
+	hmacro->Modified = 0;
+
+	/* Instanz des Protokolls nur für die Zeilen, ohne Transportschicht, Echo und Eingabeaufforderung */
+	memset(&hmacro->Engine, 0, sizeof(SERIALPROTOCOL_TypeDef));
+	hmacro->Engine.Quiet = 1;
+
+	memset(&hmacro->Store, 0, sizeof(MACRO_StoreTypeDef));
+	if(flash->Magic == MACRO_MAGIC && flash->Length < MACRO_TEXT_SIZE && flash->Text[flash->Length] == 0
+			&& MACRO_Checksum(flash) == flash->Checksum){
+		memcpy(&hmacro->Store, flash, sizeof(MACRO_StoreTypeDef));
+	}else{
+		hmacro->Store.Magic = MACRO_MAGIC;
+	}
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	führt die Zeilen eines Makros hintereinander aus, bis zur ersten Zeile mit NACK
+  * @param  hmacro 		MACRO handle
+  * @param  Name 		Name des Makros
+  * @param  Executed 	Anzahl der mit ACK ausgeführten Zeilen, NULL wenn nicht benötigt
+  * @param  Lines 		Anzahl der Zeilen des Makros, NULL wenn nicht benötigt
+  * @retval HAL status (HAL_ERROR, wenn das Makro fehlt bzw. gerade aufgezeichnet wird oder eine Zeile NACK ergibt)
+  */
+HAL_StatusTypeDef MYLIB_MACRO_Run(MACRO_TypeDef *hmacro, const char * Name, uint16_t * Executed, uint16_t * Lines){
+
+	uint16_t start = MACRO_Find(hmacro, Name);
+	uint16_t executed = 0;
+	char *text = hmacro->Store.Text;
+
+	if(start == MACRO_NONE || hmacro->hrecord != NULL){
+		return HAL_ERROR;
+	}
+	if(Lines != NULL){
+		*Lines = MACRO_Lines(hmacro, start);
+	}
+
+	/* Zeilen "#...\r" nach "<name>:" bis zum '\n' */
+	for(uint16_t pos = start + strlen(Name) + 1U; text[pos] == '#'; ){
+		char line[SERIALPROT_CollectionBuffer_SIZE + 2] = {0};
+		uint16_t length = strchr(&text[pos], '\r') - &text[pos] + 1U;
+
+		memcpy(line, &text[pos], length);
+		if(MACRO_Execute(hmacro, line)){
+			break;
+		}
+		executed++;
+		pos += length;
+	}
+
+	if(Executed != NULL){
+		*Executed = executed;
+	}
+	return (executed == MACRO_Lines(hmacro, start)) ? HAL_OK : HAL_ERROR;
+}
+
+/**
+  * @brief  Funktion 	führt nach dem Reset das Makro MACRO_BOOT aus, falls vorhanden
+  * @param  hmacro 		MACRO handle
+  * @retval HAL status (HAL_OK auch ohne das Makro)
+  */
+HAL_StatusTypeDef MYLIB_MACRO_Boot(MACRO_TypeDef *hmacro){
+
+	if(MACRO_Find(hmacro, MACRO_BOOT) == MACRO_NONE){
+		return HAL_OK;
+	}
+	return MYLIB_MACRO_Run(hmacro, MACRO_BOOT, NULL, NULL);
+}
+
+/**
+  * @brief  Funktion 	schreibt die Arbeitskopie in die Flash-Seite (Seite löschen, doppelwortweise programmieren),
+  *                     ohne Änderung seit dem Laden bzw. letzten Speichern wird die Seite nicht neu geschrieben
+  * @note   Das Löschen hält etwa 25 ms jeden Zugriff auf den Flash und damit auch alle Interrupts an (siehe "mcs")
+  * @param  hmacro 		MACRO handle
+  * @retval HAL status (HAL_ERROR während der Aufzeichnung oder bei einem Fehler des Flash)
+  */
+HAL_StatusTypeDef MYLIB_MACRO_Save(MACRO_TypeDef *hmacro){
+
+	FLASH_EraseInitTypeDef erase = {0};
+	uint32_t address = MACRO_ADDRESS(hmacro->Init.Page);
+	const uint8_t *data = (const uint8_t *)&hmacro->Store;
+	uint32_t doublewords = (MACRO_HEADER_SIZE + hmacro->Store.Length + 1U + 7U) / 8U;
+	uint32_t error = 0;
+	HAL_StatusTypeDef status;
+
+	if(hmacro->hrecord != NULL){
+		return HAL_ERROR;
+	}
+	if(!hmacro->Modified){
+		return HAL_OK;
+	}
+
+	hmacro->Store.Magic = MACRO_MAGIC;
+	hmacro->Store.Checksum = MACRO_Checksum(&hmacro->Store);
+
+	erase.TypeErase = FLASH_TYPEERASE_PAGES;
+	erase.Banks = FLASH_BANK_1;
+	erase.Page = hmacro->Init.Page;
+	erase.NbPages = 1;
+
+	HAL_FLASH_Unlock();
+	status = HAL_FLASHEx_Erase(&erase, &error);
+
+	/* nur der belegte Teil, der Rest der Seite bleibt gelöscht */
+	for(uint32_t i=0; i<doublewords && status == HAL_OK; i++){
+		uint64_t doubleword;
+		memcpy(&doubleword, &data[i * 8U], 8U);		/* Store liegt nur auf 4 Bytes ausgerichtet im Handle */
+		status = HAL_FLASH_Program(FLASH_TYPEPROGRAM_DOUBLEWORD, address + i * 8U, doubleword);
+	}
+	HAL_FLASH_Lock();
+
+	if(status == HAL_OK){
+		hmacro->Modified = 0;
+	}
+	return status;
+}
+
+/**
+  * @brief  Funktion 	aus SERIALPROT_RxByte_Callback() aufzurufen: hängt bei der Aufzeichnung jede mit '\r' abgeschlossene
+  *                     Zeile "#..." der aufzeichnenden Instanz an das Makro an ("mc"-Kommandos ausgenommen)
+  * @param  hmacro 		MACRO handle
+  * @param  hserialprot SERIALPROT handle, das das Zeichen empfangen hat
+  * @param  Byte 		empfangenes Zeichen
+  * @retval none
+  */
+void MYLIB_MACRO_RxByte(MACRO_TypeDef *hmacro, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Byte){
+
+	/* das Zeichen ist noch nicht verarbeitet, der Eingabepuffer enthält die Zeile ohne '\r' */
+	const char *line = (const char *)hserialprot->CollectionBuffer;
+	uint16_t length = strlen(line);
+
+	if(Byte != '\r' || hserialprot != hmacro->hrecord){
+		return;
+	}
+	/* leere Zeilen, Überlauf (-> OV) und die Kommandos der Makros selbst */
+	if(line[0] != '#' || length >= SERIALPROT_CollectionBuffer_SIZE || !strncmp(line, "#mc", 3)){
+		return;
+	}
+	if(!MACRO_IsAllowed(line)){
+		hmacro->RecordRejected++;
+		return;
+	}
+
+	/* Zeile, '\r', '\n' am Ende des Makros und Nullterminierung */
+	if(hmacro->Store.Length + length + 3U > MACRO_TEXT_SIZE){
+		hmacro->RecordFull = 1;
+		return;
+	}
+	memcpy(&hmacro->Store.Text[hmacro->Store.Length], line, length);
+	hmacro->Store.Length += length;
+	hmacro->Store.Text[hmacro->Store.Length++] = '\r';
+	hmacro->Store.Text[hmacro->Store.Length] = 0;
+	hmacro->RecordLines++;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos der Makros aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hmacro 		MACRO handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_MACRO_Command(MACRO_TypeDef *hmacro, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcb") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"mce")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcu") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcr")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcd") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcl")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcs")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* Makros dürfen keine Makros aufrufen oder verändern */
+	if(hserialprot == &hmacro->Engine){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	char *name = (char *)hserialprot->Parameter1;
+	uint16_t param1 = atoi((char *)hserialprot->Parameter1);
+	uint16_t param2 = atoi((char *)hserialprot->Parameter2);
+	uint8_t named = (hserialprot->MessageKind == MESSAGEKIND_TEXT_NUMBER && MACRO_IsName(name));
+	uint8_t recording = (hmacro->hrecord != NULL);
+	uint16_t start;
+
+	/* Auflisten: Name und Zeilen des Makros nr bzw. eine Zeile des Makros name */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcl")){
+		if(hserialprot->MessageKind == MESSAGEKIND_NUMBER_NUMBER){
+			start = 0;
+			for(uint16_t i=0; i<param1 && start < hmacro->Store.Length; i++){
+				start = MACRO_End(hmacro, start);
+			}
+			if(start >= hmacro->Store.Length){
+				return SERIALPROT_COMMAND_INVALID;
+			}
+			strncat((char *)Result, &hmacro->Store.Text[start], strcspn(&hmacro->Store.Text[start], ":") + 1U);
+			Result[strlen((char *)Result) - 1] = ',';
+			utoa(MACRO_Lines(hmacro, start), (char *)Result + strlen((char *)Result), 10);
+			return SERIALPROT_COMMAND_OK;
+		}
+		start = named ? MACRO_Find(hmacro, name) : MACRO_NONE;
+		if(start == MACRO_NONE || param2 > MACRO_Lines(hmacro, start)){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		if(param2 == 0){
+			utoa(MACRO_Lines(hmacro, start), (char *)Result, 10);
+			return SERIALPROT_COMMAND_OK;
+		}
+		start += strlen(name) + 1U;
+		for(uint16_t i=1; i<param2; i++){
+			start += strcspn(&hmacro->Store.Text[start], "\r") + 1U;
+		}
+		strncat((char *)Result, &hmacro->Store.Text[start], strcspn(&hmacro->Store.Text[start], "\r"));
+		return SERIALPROT_COMMAND_OK;
+	}
+
+	/* Kommandos mit Namen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcb") || __SERIALPROT_IS_COMMANDNAME(hserialprot,"mcr")
+			|| __SERIALPROT_IS_COMMANDNAME(hserialprot,"mcd")){
+		if(!named || param2 != 0 || recording){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		start = MACRO_Find(hmacro, name);
+
+		/* Aufzeichnung beginnen: ein gleichnamiges Makro wird ersetzt, das neue steht am Ende des Texts */
+		if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcb")){
+			if(start != MACRO_NONE){
+				MACRO_Delete(hmacro, start);
+			}
+			if(hmacro->Store.Length + strlen(name) + 3U > MACRO_TEXT_SIZE){
+				return SERIALPROT_COMMAND_INVALID;
+			}
+			hmacro->RecordStart = hmacro->Store.Length;
+			hmacro->RecordLines = 0;
+			hmacro->RecordFull = 0;
+			hmacro->RecordRejected = 0;
+			strcat(hmacro->Store.Text, name);
+			strcat(hmacro->Store.Text, ":");
+			hmacro->Store.Length += strlen(name) + 1U;
+			hmacro->Modified = 1;
+			hmacro->hrecord = hserialprot;
+			utoa(MACRO_TEXT_SIZE - 2U - hmacro->Store.Length, (char *)Result, 10);
+			return SERIALPROT_COMMAND_OK;
+		}
+		if(start == MACRO_NONE){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+
+		/* ausführen */
+		if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcr")){
+			uint16_t executed, lines;
+			MYLIB_MACRO_Run(hmacro, name, &executed, &lines);
+			utoa(executed, (char *)Result, 10);
+			strcat((char *)Result, ",");
+			utoa(lines, (char *)Result + strlen((char *)Result), 10);
+			return SERIALPROT_COMMAND_OK;
+		}
+
+		/* löschen */
+		MACRO_Delete(hmacro, start);
+		utoa(MACRO_TEXT_SIZE - 1U - hmacro->Store.Length, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+	}
+
+	/* die übrigen Kommandos haben zwei Zahlen als Parameter */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER || param1 != 0 || param2 != 0){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	/* letzte Zeile entfernen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"mcu")){
+		if(hserialprot != hmacro->hrecord || hmacro->RecordLines == 0){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		/* zurück bis zum '\r' der vorletzten Zeile bzw. bis hinter "<name>:" */
+		uint16_t first = hmacro->RecordStart + strcspn(&hmacro->Store.Text[hmacro->RecordStart], ":") + 1U;
+		hmacro->Store.Length--;
+		while(hmacro->Store.Length > first && hmacro->Store.Text[hmacro->Store.Length - 1] != '\r'){
+			hmacro->Store.Length--;
+		}
+		hmacro->Store.Text[hmacro->Store.Length] = 0;
+		hmacro->RecordLines--;
+		utoa(hmacro->RecordLines, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Aufzeichnung beenden */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"mce")){
+		if(hserialprot != hmacro->hrecord){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hmacro->Store.Text[hmacro->Store.Length++] = '\n';
+		hmacro->Store.Text[hmacro->Store.Length] = 0;
+		hmacro->hrecord = NULL;
+		utoa(hmacro->RecordLines, (char *)Result, 10);
+		strcat((char *)Result, hmacro->RecordFull ? ",1," : ",0,");
+		utoa(hmacro->RecordRejected, (char *)Result + strlen((char *)Result), 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* in die Flash-Seite schreiben */
+	}else{
+		if(MYLIB_MACRO_Save(hmacro) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa(hmacro->Store.Length, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	sucht ein Makro nach seinem Namen
+  * @param  hmacro 		MACRO handle
+  * @param  Name 		Name des Makros
+  * @retval Beginn des Makros im Text oder MACRO_NONE
+  */
+static uint16_t MACRO_Find(MACRO_TypeDef *hmacro, const char * Name){
+
+	uint16_t length = strlen(Name);
+
+	for(uint16_t start = 0; start < hmacro->Store.Length; start = MACRO_End(hmacro, start)){
+		if(!strncmp(&hmacro->Store.Text[start], Name, length) && hmacro->Store.Text[start + length] == ':'){
+			return start;
+		}
+	}
+	return MACRO_NONE;
+}
+
+/**
+  * @brief  Funktion 	liefert das Ende eines Makros (Beginn des nächsten)
+  * @param  hmacro 		MACRO handle
+  * @param  Start 		Beginn des Makros im Text
+  * @retval Position nach dem '\n' bzw. Länge des Texts beim gerade aufgezeichneten Makro
+  */
+static uint16_t MACRO_End(MACRO_TypeDef *hmacro, uint16_t Start){
+
+	uint16_t end = Start + strcspn(&hmacro->Store.Text[Start], "\n");
+
+	return (end < hmacro->Store.Length) ? end + 1U : end;
+}
+
+/**
+  * @brief  Funktion 	zählt die Zeilen eines Makros
+  * @param  hmacro 		MACRO handle
+  * @param  Start 		Beginn des Makros im Text
+  * @retval Anzahl der Zeilen
+  */
+static uint16_t MACRO_Lines(MACRO_TypeDef *hmacro, uint16_t Start){
+
+	uint16_t end = MACRO_End(hmacro, Start);
+	uint16_t lines = 0;
+
+	for(uint16_t i=Start; i<end; i++){
+		if(hmacro->Store.Text[i] == '\r'){
+			lines++;
+		}
+	}
+	return lines;
+}
+
+/**
+  * @brief  Funktion 	entfernt ein Makro, die folgenden rücken nach
+  * @param  hmacro 		MACRO handle
+  * @param  Start 		Beginn des Makros im Text
+  * @retval none
+  */
+static void MACRO_Delete(MACRO_TypeDef *hmacro, uint16_t Start){
+
+	uint16_t end = MACRO_End(hmacro, Start);
+
+	/* samt Nullterminierung */
+	memmove(&hmacro->Store.Text[Start], &hmacro->Store.Text[end], hmacro->Store.Length - end + 1U);
+	hmacro->Store.Length -= end - Start;
+	hmacro->Modified = 1;
+}
+
+/**
+  * @brief  Funktion 	prüft einen Namen (1..MACRO_NAME_MAX Buchstaben)
+  * @param  Name 		Name
+  * @retval 1 wenn gültig, sonst 0
+  */
+static uint8_t MACRO_IsName(const char * Name){
+
+	uint8_t length = strlen(Name);
+
+	if(length == 0 || length > MACRO_NAME_MAX){
+		return 0;
+	}
+	for(uint8_t i=0; i<length; i++){
+		if(!isalpha((unsigned char)Name[i])){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+  * @brief  Funktion 	prüft, ob das Kommando einer Zeile in einem Makro laufen darf
+  * @param  Line 		Zeile "#<name>,..."
+  * @retval 1 = erlaubt, 0 = das Kommando behält seine Instanz für spätere Meldungen (MACRO_EventNames)
+  */
+static uint8_t MACRO_IsAllowed(const char * Line){
+
+	for(uint8_t i=0; i<sizeof(MACRO_EventNames)/sizeof(MACRO_EventNames[0]); i++){
+		if(strncmp(&Line[1], MACRO_EventNames[i], 3) == 0){
+			return 0;
+		}
+	}
+	return 1;
+}
+
+/**
+  * @brief  Funktion 	übergibt eine Zeile der eigenen Instanz des Protokolls und wertet die Antwort aus
+  * @param  hmacro 		MACRO handle
+  * @param  Line 		vollständige Zeile "#...\r"
+  * @retval 0: ACK, 1: NACK (auch für nicht erlaubte Kommandos, z.B. aus einer älteren Flash-Seite)
+  */
+static uint8_t MACRO_Execute(MACRO_TypeDef *hmacro, const char * Line){
+
+	uint8_t reply[SERIALPROT_TxBuffer_SIZE] = {0};
+
+	if(!MACRO_IsAllowed(Line)){
+		return 1;
+	}
+
+	/* Zeichen einzeln wie von einer Transportschicht übergeben, Antworten werden im selben Puffer gesammelt */
+	for(uint8_t i=0; Line[i] != 0; i++){
+		uint8_t rx[2] = {Line[i], 0};
+		MYLIB_SERIALPROT_XCHANGE(&hmacro->Engine, rx, reply);
+	}
+
+	return (strstr((char *)reply, "NACK") != NULL || strstr((char *)reply, "ACK") == NULL);
+}
+
+/**
+  * @brief  Funktion 	Prüfsumme des Texts einer Seite
+  * @param  Store 		Inhalt der Seite
+  * @retval Summe der Zeichen (16 Bit)
+  */
+static uint16_t MACRO_Checksum(const MACRO_StoreTypeDef * Store){
+
+	uint16_t sum = 0;
+
+	for(uint16_t i=0; i<Store->Length; i++){
+		sum += (uint8_t)Store->Text[i];
+	}
+	return sum;
+}
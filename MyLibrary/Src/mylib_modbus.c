@@ -0,0 +1,689 @@
+/**
+******************************************************************************
+* @file mylib_modbus.c
+* @author Reiter Roman
+* @brief mylib-Modbus-RTU-Slave.
+* Diese Datei stellt die Kommandos des seriellen Protokolls als Modbus-RTU-Slave an einem UART bereit:
+* + Rahmenende über die Empfangs-Timeout-Erkennung des USART (RTOR), keine Zeitmessung in Software
+* + CRC-16 (Polynom 0xA001) über eine Tabelle, ein Tabellenzugriff je Byte
+* + Coils und Holding-Register werden als Textkommandos ("gpo", "rdm", "add", "asc") von einer eigenen Instanz
+*   des seriellen Protokolls ausgeführt, die LEDs schaltet also weiterhin SERIALPROT_Command_GPO_Callback()
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) UART mit DMA initialisieren (hdmarx zirkulär, hdmatx normal, gleiche NVIC-Priorität wie der UART),
+		danach den Slave daran binden, der Empfang wird dabei gestartet
+		(+++) z.B.: MYLIB_MODBUS_Init(&hmodbus2, &huart2, 17);
+		(+) Der UART darf nicht zusätzlich von der UART-Transportschicht (mylib_serialprot_uart.h) verwendet werden
+		(+) Das Rahmenformat (Baudrate, Parität, Stoppbits) wird aus der Initialisierung des UART übernommen
+
+	(#) HAL-Callbacks weiterreichen, die Funktionen ignorieren andere UARTs
+		(+++) HAL_UART_RxCpltCallback () -> MYLIB_MODBUS_RxCpltCallback(&hmodbus2, huart)
+		(+++) HAL_UART_ErrorCallback ()  -> MYLIB_MODBUS_ErrorCallback(&hmodbus2, huart)
+
+	(#) Rahmenerkennung
+		(+) Der USART meldet nach 3,5 Zeichen Pause (ab 19200 Baud fest 1,75 ms) den Receiver-Timeout,
+			die HAL beendet dabei den DMA-Empfang und ruft HAL_UART_ErrorCallback() mit HAL_UART_ERROR_RTO auf
+		(+) Der Rahmen steht ab RxFrame[0], seine Länge ergibt sich aus dem Zählerstand der DMA
+		(+) Die Antwort wird sofort per DMA gesendet, der Empfang des nächsten Rahmens läuft bereits
+
+	(#) Unterstützte Funktionen
+		(+) 0x01 Read Coils, 0x05 Write Single Coil, 0x0F Write Multiple Coils
+			(++) Coil 0 rote LED, Coil 1 grüne LED, Coil 2 blaue LED -> "#gpo,rt|gn|bl:on|off\r"
+		(+) 0x03 Read Holding Registers, 0x06 Write Single Register, 0x10 Write Multiple Registers
+			(++) Register 0, 1: Parameter P1, P2 (0..9999)
+			(++) Register 2: "#rdm,P1:P2\r", Register 3: "#add,P1:P2\r", Register 4: "#asc,<Zeichen P1>:0\r"
+				 werden bei jedem Lesen ausgeführt, ein NACK liefert 0 und setzt das Bit im Register 5
+		(+) Adresse 0 (Broadcast): Schreibfunktionen werden ausgeführt, es wird nicht geantwortet
+		(+) Ausnahmen: 01 Funktion unbekannt, 02 Adresse ungültig, 03 Wert ungültig, 04 Kommando mit NACK beantwortet
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_modbus.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/** @defgroup MODBUS_Private_Constants
+  * @{
+  */
+#define MODBUS_BROADCAST 0
+#define MODBUS_FRAME_MIN 4							/* Adresse, Funktion, CRC */
+
+#define MODBUS_FC_READ_COILS 0x01
+#define MODBUS_FC_READ_HOLDING_REGISTERS 0x03
+#define MODBUS_FC_WRITE_SINGLE_COIL 0x05
+#define MODBUS_FC_WRITE_SINGLE_REGISTER 0x06
+#define MODBUS_FC_WRITE_MULTIPLE_COILS 0x0F
+#define MODBUS_FC_WRITE_MULTIPLE_REGISTERS 0x10
+
+#define MODBUS_EX_NONE 0x00
+#define MODBUS_EX_ILLEGAL_FUNCTION 0x01
+#define MODBUS_EX_ILLEGAL_DATA_ADDRESS 0x02
+#define MODBUS_EX_ILLEGAL_DATA_VALUE 0x03
+#define MODBUS_EX_SLAVE_DEVICE_FAILURE 0x04
+
+#define MODBUS_STATUS_RDM 0x0001
+#define MODBUS_STATUS_ADD 0x0002
+#define MODBUS_STATUS_ASC 0x0004
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/** @addtogroup MODBUS_Private_Variables
+  * @{
+  */
+
+/* CRC-16/MODBUS, Tabelle für das gespiegelte Polynom 0xA001 */
+static const uint16_t MODBUS_CRC_Table[256] = {
+	0x0000, 0xC0C1, 0xC181, 0x0140, 0xC301, 0x03C0, 0x0280, 0xC241,
+	0xC601, 0x06C0, 0x0780, 0xC741, 0x0500, 0xC5C1, 0xC481, 0x0440,
+	0xCC01, 0x0CC0, 0x0D80, 0xCD41, 0x0F00, 0xCFC1, 0xCE81, 0x0E40,
+	0x0A00, 0xCAC1, 0xCB81, 0x0B40, 0xC901, 0x09C0, 0x0880, 0xC841,
+	0xD801, 0x18C0, 0x1980, 0xD941, 0x1B00, 0xDBC1, 0xDA81, 0x1A40,
+	0x1E00, 0xDEC1, 0xDF81, 0x1F40, 0xDD01, 0x1DC0, 0x1C80, 0xDC41,
+	0x1400, 0xD4C1, 0xD581, 0x1540, 0xD701, 0x17C0, 0x1680, 0xD641,
+	0xD201, 0x12C0, 0x1380, 0xD341, 0x1100, 0xD1C1, 0xD081, 0x1040,
+	0xF001, 0x30C0, 0x3180, 0xF141, 0x3300, 0xF3C1, 0xF281, 0x3240,
+	0x3600, 0xF6C1, 0xF781, 0x3740, 0xF501, 0x35C0, 0x3480, 0xF441,
+	0x3C00, 0xFCC1, 0xFD81, 0x3D40, 0xFF01, 0x3FC0, 0x3E80, 0xFE41,
+	0xFA01, 0x3AC0, 0x3B80, 0xFB41, 0x3900, 0xF9C1, 0xF881, 0x3840,
+	0x2800, 0xE8C1, 0xE981, 0x2940, 0xEB01, 0x2BC0, 0x2A80, 0xEA41,
+	0xEE01, 0x2EC0, 0x2F80, 0xEF41, 0x2D00, 0xEDC1, 0xEC81, 0x2C40,
+	0xE401, 0x24C0, 0x2580, 0xE541, 0x2700, 0xE7C1, 0xE681, 0x2640,
+	0x2200, 0xE2C1, 0xE381, 0x2340, 0xE101, 0x21C0, 0x2080, 0xE041,
+	0xA001, 0x60C0, 0x6180, 0xA141, 0x6300, 0xA3C1, 0xA281, 0x6240,
+	0x6600, 0xA6C1, 0xA781, 0x6740, 0xA501, 0x65C0, 0x6480, 0xA441,
+	0x6C00, 0xACC1, 0xAD81, 0x6D40, 0xAF01, 0x6FC0, 0x6E80, 0xAE41,
+	0xAA01, 0x6AC0, 0x6B80, 0xAB41, 0x6900, 0xA9C1, 0xA881, 0x6840,
+	0x7800, 0xB8C1, 0xB981, 0x7940, 0xBB01, 0x7BC0, 0x7A80, 0xBA41,
+	0xBE01, 0x7EC0, 0x7F80, 0xBF41, 0x7D00, 0xBDC1, 0xBC81, 0x7C40,
+	0xB401, 0x74C0, 0x7580, 0xB541, 0x7700, 0xB7C1, 0xB681, 0x7640,
+	0x7200, 0xB2C1, 0xB381, 0x7340, 0xB101, 0x71C0, 0x7080, 0xB041,
+	0x5000, 0x90C1, 0x9181, 0x5140, 0x9301, 0x53C0, 0x5280, 0x9241,
+	0x9601, 0x56C0, 0x5780, 0x9741, 0x5500, 0x95C1, 0x9481, 0x5440,
+	0x9C01, 0x5CC0, 0x5D80, 0x9D41, 0x5F00, 0x9FC1, 0x9E81, 0x5E40,
+	0x5A00, 0x9AC1, 0x9B81, 0x5B40, 0x9901, 0x59C0, 0x5880, 0x9841,
+	0x8801, 0x48C0, 0x4980, 0x8941, 0x4B00, 0x8BC1, 0x8A81, 0x4A40,
+	0x4E00, 0x8EC1, 0x8F81, 0x4F40, 0x8D01, 0x4DC0, 0x4C80, 0x8C41,
+	0x4400, 0x84C1, 0x8581, 0x4540, 0x8701, 0x47C0, 0x4680, 0x8641,
+	0x8201, 0x42C0, 0x4380, 0x8341, 0x4100, 0x81C1, 0x8081, 0x4040
+};
+
+/* Parameter 1 des Kommandos "gpo" je Coil */
+static const char * const MODBUS_CoilNames[MODBUS_COIL_COUNT] = {"rt", "gn", "bl"};
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup MODBUS_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef MODBUS_Receive(MODBUS_TypeDef *hmodbus);
+static uint32_t MODBUS_FrameTimeout(UART_HandleTypeDef *huart);
+static void MODBUS_ProcessFrame(MODBUS_TypeDef *hmodbus, uint16_t Length);
+static uint8_t MODBUS_Execute(MODBUS_TypeDef *hmodbus, const char * Command, uint16_t * Value);
+static uint8_t MODBUS_WriteCoil(MODBUS_TypeDef *hmodbus, uint16_t Coil, uint8_t State);
+static uint16_t MODBUS_ReadRegister(MODBUS_TypeDef *hmodbus, uint16_t Register);
+static uint8_t MODBUS_ReadCoils(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength);
+static uint8_t MODBUS_ReadHoldingRegisters(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength);
+static uint8_t MODBUS_WriteSingleCoil(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength);
+static uint8_t MODBUS_WriteSingleRegister(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength);
+static uint8_t MODBUS_WriteMultipleCoils(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength);
+static uint8_t MODBUS_WriteMultipleRegisters(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	bindet den Slave an einen initialisierten UART, aktiviert den Empfangs-Timeout für das Rahmenende und startet den Empfang
+  * @param  hmodbus 	MODBUS handle
+  * @param  huart 		UART handle (bereits mit HAL_UART_Init() initialisiert, mit hdmarx und hdmatx)
+  * @param  SlaveAddress eigene Slave-Adresse 1..247
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_MODBUS_Init(MODBUS_TypeDef *hmodbus, UART_HandleTypeDef *huart, uint8_t SlaveAddress){
+
+	if(SlaveAddress == MODBUS_BROADCAST || SlaveAddress > 247 || huart->hdmarx == NULL || huart->hdmatx == NULL){
+		return HAL_ERROR;
+	}
+
+	memset(hmodbus,0,sizeof(MODBUS_TypeDef));
+	hmodbus->huart = huart;
+	hmodbus->SlaveAddress = SlaveAddress;
+
+	/* Instanz des Protokolls nur für die Kommandos, ohne Transportschicht, Echo und Eingabeaufforderung */
+	hmodbus->Engine.Quiet = 1;
+
+	/* Rahmenende: Receiver-Timeout des USART (nicht beim LPUART vorhanden) */
+	hmodbus->FrameTimeout = MODBUS_FrameTimeout(huart);
+	HAL_UART_ReceiverTimeout_Config(huart, hmodbus->FrameTimeout);
+	if(HAL_UART_EnableReceiverTimeout(huart) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	return MODBUS_Receive(hmodbus);
+}
+
+/**
+  * @brief  Funktion 	berechnet die CRC-16 eines Modbus-RTU-Rahmens
+  * @param  pData 		Rahmen (über den vollständigen Rahmen inkl. CRC berechnet ergibt sich 0)
+  * @param  Size 		Anzahl der Bytes
+  * @retval CRC, im Rahmen wird zuerst das niederwertige Byte gesendet
+  */
+uint16_t MYLIB_MODBUS_CRC16(const uint8_t *pData, uint16_t Size){
+
+	uint16_t crc = 0xFFFF;
+
+	for(uint16_t i=0; i<Size; i++){
+		crc = (crc >> 8) ^ MODBUS_CRC_Table[(crc ^ pData[i]) & 0xFF];
+	}
+	return crc;
+}
+
+/**
+  * @brief  Funktion 	aus HAL_UART_RxCpltCallback aufzurufen: die zirkuläre DMA hat den Empfangspuffer gefüllt,
+  * 					der laufende Rahmen ist länger als MODBUS_FRAME_SIZE und wird verworfen
+  * @param  hmodbus 	MODBUS handle
+  * @param  huart 		UART handle
+  * @retval none
+  */
+void MYLIB_MODBUS_RxCpltCallback(MODBUS_TypeDef *hmodbus, UART_HandleTypeDef *huart){
+
+	if(huart != hmodbus->huart){
+		return;
+	}
+	hmodbus->Overflow = 1;
+}
+
+/**
+  * @brief  Funktion 	aus HAL_UART_ErrorCallback aufzurufen: wertet beim Receiver-Timeout den empfangenen Rahmen aus,
+  * 					verwirft ihn bei einem Zeichenfehler und startet den Empfang des nächsten Rahmens
+  * @param  hmodbus 	MODBUS handle
+  * @param  huart 		UART handle
+  * @retval none
+  */
+void MYLIB_MODBUS_ErrorCallback(MODBUS_TypeDef *hmodbus, UART_HandleTypeDef *huart){
+
+	if(huart != hmodbus->huart){
+		return;
+	}
+
+	uint32_t errorcode = huart->ErrorCode;
+
+	/* Fehlerflags löschen, falls sie noch anstehen */
+	__HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_OREF | UART_CLEAR_FEF | UART_CLEAR_NEF | UART_CLEAR_PEF | UART_CLEAR_RTOF);
+
+	/* Sendefehler: der Empfang läuft weiter */
+	if(huart->RxState != HAL_UART_STATE_READY){
+		return;
+	}
+
+	if(errorcode & (HAL_UART_ERROR_ORE | HAL_UART_ERROR_FE | HAL_UART_ERROR_NE | HAL_UART_ERROR_PE)){
+		/* Zeichenfehler: Rahmen unbrauchbar, der Rest des Rahmens endet mit dem nächsten Timeout an der CRC */
+		hmodbus->Statistics.UartErrors++;
+	}else if(errorcode & HAL_UART_ERROR_RTO){
+		if(hmodbus->Overflow){
+			hmodbus->Statistics.Overflows++;
+		}else{
+			/* Länge aus dem Zählerstand der (bereits angehaltenen) DMA */
+			MODBUS_ProcessFrame(hmodbus, MODBUS_FRAME_SIZE - __HAL_DMA_GET_COUNTER(huart->hdmarx));
+		}
+	}
+
+	hmodbus->Overflow = 0;
+	MODBUS_Receive(hmodbus);
+}
+
+/**
+  * @brief  Funktion 	startet den DMA-Empfang des nächsten Rahmens ab RxFrame[0]
+  * @param  hmodbus 	MODBUS handle
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef MODBUS_Receive(MODBUS_TypeDef *hmodbus){
+
+	/* HAL_UART_Receive_DMA() aktiviert bei gesetztem RTOEN auch den Timeout-Interrupt */
+	return HAL_UART_Receive_DMA(hmodbus->huart, hmodbus->RxFrame, MODBUS_FRAME_SIZE);
+}
+
+/**
+  * @brief  Funktion 	berechnet die Pause für das Rahmenende in Bitzeiten: 3,5 Zeichen, über 19200 Baud fest 1,75 ms
+  * @param  huart 		UART handle
+  * @retval Pause in Bitzeiten
+  */
+static uint32_t MODBUS_FrameTimeout(UART_HandleTypeDef *huart){
+
+	if(huart->Init.BaudRate > 19200){
+		return (1750U * huart->Init.BaudRate + 999999U) / 1000000U;
+	}
+
+	/* Startbit + Datenbits inkl. Parität + Stoppbits */
+	uint32_t charbits = 1 + 8 + 1;
+	if(huart->Init.WordLength == UART_WORDLENGTH_9B){
+		charbits++;
+	}else if(huart->Init.WordLength == UART_WORDLENGTH_7B){
+		charbits--;
+	}
+	if(huart->Init.StopBits != UART_STOPBITS_1){
+		charbits++;
+	}
+	return (35U * charbits + 9U) / 10U;
+}
+
+/**
+  * @brief  Funktion 	prüft einen empfangenen Rahmen (Länge, CRC, Adresse), führt die Funktion aus und sendet die Antwort
+  * @param  hmodbus 	MODBUS handle
+  * @param  Length 		Länge des Rahmens inkl. CRC
+  * @retval none
+  */
+static void MODBUS_ProcessFrame(MODBUS_TypeDef *hmodbus, uint16_t Length){
+
+	uint8_t * frame = hmodbus->RxFrame;
+
+	if(Length < MODBUS_FRAME_MIN || MYLIB_MODBUS_CRC16(frame, Length) != 0){
+		hmodbus->Statistics.CrcErrors++;
+		return;
+	}
+	if(frame[0] != hmodbus->SlaveAddress && frame[0] != MODBUS_BROADCAST){
+		hmodbus->Statistics.FramesIgnored++;
+		return;
+	}
+	/* Halbduplex: solange die letzte Antwort gesendet wird, darf der Master nicht senden */
+	if(hmodbus->huart->gState != HAL_UART_STATE_READY){
+		hmodbus->Statistics.TxErrors++;
+		return;
+	}
+	hmodbus->Statistics.FramesReceived++;
+
+	/* PDU ohne Adresse und CRC, die Antwort-PDU beginnt nach der Adresse */
+	const uint8_t * pdu = &frame[1];
+	uint16_t pdulength = Length - 3;
+	uint8_t * response = &hmodbus->TxFrame[1];
+	uint16_t responselength = 0;
+	uint8_t exception;
+
+	switch(pdu[0]){
+	case MODBUS_FC_READ_COILS:
+		exception = MODBUS_ReadCoils(hmodbus, pdu, pdulength, response, &responselength);
+		break;
+	case MODBUS_FC_READ_HOLDING_REGISTERS:
+		exception = MODBUS_ReadHoldingRegisters(hmodbus, pdu, pdulength, response, &responselength);
+		break;
+	case MODBUS_FC_WRITE_SINGLE_COIL:
+		exception = MODBUS_WriteSingleCoil(hmodbus, pdu, pdulength, response, &responselength);
+		break;
+	case MODBUS_FC_WRITE_SINGLE_REGISTER:
+		exception = MODBUS_WriteSingleRegister(hmodbus, pdu, pdulength, response, &responselength);
+		break;
+	case MODBUS_FC_WRITE_MULTIPLE_COILS:
+		exception = MODBUS_WriteMultipleCoils(hmodbus, pdu, pdulength, response, &responselength);
+		break;
+	case MODBUS_FC_WRITE_MULTIPLE_REGISTERS:
+		exception = MODBUS_WriteMultipleRegisters(hmodbus, pdu, pdulength, response, &responselength);
+		break;
+	default:
+		exception = MODBUS_EX_ILLEGAL_FUNCTION;
+		break;
+	}
+
+	/* Broadcast wird nie beantwortet */
+	if(frame[0] == MODBUS_BROADCAST){
+		return;
+	}
+
+	if(exception != MODBUS_EX_NONE){
+		hmodbus->Statistics.Exceptions++;
+		response[0] = pdu[0] | 0x80;
+		response[1] = exception;
+		responselength = 2;
+	}
+
+	hmodbus->TxFrame[0] = hmodbus->SlaveAddress;
+	uint16_t crc = MYLIB_MODBUS_CRC16(hmodbus->TxFrame, responselength + 1);
+	hmodbus->TxFrame[responselength + 1] = crc & 0xFF;
+	hmodbus->TxFrame[responselength + 2] = crc >> 8;
+
+	if(HAL_UART_Transmit_DMA(hmodbus->huart, hmodbus->TxFrame, responselength + 3) != HAL_OK){
+		hmodbus->Statistics.TxErrors++;
+	}
+}
+
+/**
+  * @brief  Funktion 	führt eine Kommandozeile mit der Instanz des Protokolls aus und liefert das Ergebnis nach "#a,"
+  * @param  hmodbus 	MODBUS handle
+  * @param  Command 	Kommandozeile inkl. '\r', z.B. "#add,2:3\r"
+  * @param  Value 		Ergebnis des Kommandos (0, falls es keines liefert), darf NULL sein
+  * @retval 0: ACK, 1: NACK
+  */
+static uint8_t MODBUS_Execute(MODBUS_TypeDef *hmodbus, const char * Command, uint16_t * Value){
+
+	uint8_t reply[SERIALPROT_TxBuffer_SIZE] = {0};
+
+	/* Zeichen einzeln wie von einer Transportschicht übergeben, Antworten werden im selben Puffer gesammelt */
+	for(uint8_t i=0; Command[i] != 0; i++){
+		uint8_t rx[2] = {Command[i], 0};
+		MYLIB_SERIALPROT_XCHANGE(&hmodbus->Engine, rx, reply);
+	}
+
+	if(strstr((char *)reply, "NACK") != NULL || strstr((char *)reply, "ACK") == NULL){
+		return 1;
+	}
+
+	if(Value != NULL){
+		char * result = strstr((char *)reply, "#a,");
+		*Value = (result != NULL) ? (uint16_t)atoi(result + 3) : 0;
+	}
+	return 0;
+}
+
+/**
+  * @brief  Funktion 	schaltet eine Coil über das Kommando "gpo" und merkt sich den Zustand
+  * @param  hmodbus 	MODBUS handle
+  * @param  Coil 		Nummer der Coil
+  * @param  State 		1: ein, 0: aus
+  * @retval 0: ACK, 1: NACK
+  */
+static uint8_t MODBUS_WriteCoil(MODBUS_TypeDef *hmodbus, uint16_t Coil, uint8_t State){
+
+	char command[SERIALPROT_CollectionBuffer_SIZE + 1] = "#gpo,";
+
+	strcat(command, MODBUS_CoilNames[Coil]);
+	strcat(command, State ? ":on\r" : ":off\r");
+
+	if(MODBUS_Execute(hmodbus, command, NULL)){
+		return 1;
+	}
+
+	if(State){
+		hmodbus->Coils |= (1U << Coil);
+	}else{
+		hmodbus->Coils &= ~(1U << Coil);
+	}
+	return 0;
+}
+
+/**
+  * @brief  Funktion 	liefert ein Holding-Register, die Ergebnis-Register führen dazu ihr Kommando aus
+  * @param  hmodbus 	MODBUS handle
+  * @param  Register 	Nummer des Registers
+  * @retval Inhalt des Registers
+  */
+static uint16_t MODBUS_ReadRegister(MODBUS_TypeDef *hmodbus, uint16_t Register){
+
+	char command[SERIALPROT_CollectionBuffer_SIZE + 1] = {0};
+	char param1[6] = {0};
+	char param2[6] = {0};
+	uint16_t value = 0;
+	uint16_t status = 0;
+
+	itoa(hmodbus->Param[0], param1, 10);
+	itoa(hmodbus->Param[1], param2, 10);
+
+	switch(Register){
+	case MODBUS_REG_PARAM1:
+	case MODBUS_REG_PARAM2:
+		return hmodbus->Param[Register - MODBUS_REG_PARAM1];
+
+	case MODBUS_REG_RDM:
+	case MODBUS_REG_ADD:
+		strcat(command, (Register == MODBUS_REG_RDM) ? "#rdm," : "#add,");
+		strcat(command, param1);
+		strcat(command, ":");
+		strcat(command, param2);
+		strcat(command, "\r");
+		status = (Register == MODBUS_REG_RDM) ? MODBUS_STATUS_RDM : MODBUS_STATUS_ADD;
+		break;
+
+	case MODBUS_REG_ASC:
+		/* niederwertiges Byte von P1 als Zeichen, Steuer- und Trennzeichen würden die Kommandozeile verändern */
+		status = MODBUS_STATUS_ASC;
+		if((hmodbus->Param[0] & 0xFF) <= ' ' || (hmodbus->Param[0] & 0xFF) > '~' || strchr("#,:", hmodbus->Param[0] & 0xFF) != NULL){
+			hmodbus->Status |= status;
+			return 0;
+		}
+		strcat(command, "#asc,");
+		command[strlen(command)] = hmodbus->Param[0] & 0xFF;
+		strcat(command, ":0\r");
+		break;
+
+	default:
+		return hmodbus->Status;
+	}
+
+	if(MODBUS_Execute(hmodbus, command, &value)){
+		hmodbus->Status |= status;
+		return 0;
+	}
+	hmodbus->Status &= ~status;
+	return value;
+}
+
+/**
+  * @brief  Funktion 	0x01 Read Coils
+  * @param  hmodbus 	MODBUS handle
+  * @param  pdu 		Anfrage ab dem Funktionscode
+  * @param  Length 		Länge der Anfrage
+  * @param  Response 	Antwort ab dem Funktionscode
+  * @param  ResponseLength Länge der Antwort
+  * @retval Ausnahme oder MODBUS_EX_NONE
+  */
+static uint8_t MODBUS_ReadCoils(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength){
+
+	if(Length != 5){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+
+	uint16_t start = (pdu[1] << 8) | pdu[2];
+	uint16_t quantity = (pdu[3] << 8) | pdu[4];
+
+	if(quantity == 0 || quantity > 2000){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+	if(start >= MODBUS_COIL_COUNT || quantity > MODBUS_COIL_COUNT - start){
+		return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+	}
+
+	/* höchstens 3 Coils, passen in ein Byte */
+	Response[0] = pdu[0];
+	Response[1] = 1;
+	Response[2] = (hmodbus->Coils >> start) & ((1U << quantity) - 1);
+	*ResponseLength = 3;
+
+	return MODBUS_EX_NONE;
+}
+
+/**
+  * @brief  Funktion 	0x03 Read Holding Registers
+  * @param  hmodbus 	MODBUS handle
+  * @param  pdu 		Anfrage ab dem Funktionscode
+  * @param  Length 		Länge der Anfrage
+  * @param  Response 	Antwort ab dem Funktionscode
+  * @param  ResponseLength Länge der Antwort
+  * @retval Ausnahme oder MODBUS_EX_NONE
+  */
+static uint8_t MODBUS_ReadHoldingRegisters(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength){
+
+	if(Length != 5){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+
+	uint16_t start = (pdu[1] << 8) | pdu[2];
+	uint16_t quantity = (pdu[3] << 8) | pdu[4];
+
+	if(quantity == 0 || quantity > 125){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+	if(start >= MODBUS_REGISTER_COUNT || quantity > MODBUS_REGISTER_COUNT - start){
+		return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+	}
+
+	Response[0] = pdu[0];
+	Response[1] = quantity * 2;
+	/* aufsteigend, das Status-Register gibt damit die Kommandos derselben Anfrage wieder */
+	for(uint16_t i=0; i<quantity; i++){
+		uint16_t value = MODBUS_ReadRegister(hmodbus, start + i);
+		Response[2 + 2*i] = value >> 8;
+		Response[3 + 2*i] = value & 0xFF;
+	}
+	*ResponseLength = 2 + quantity * 2;
+
+	return MODBUS_EX_NONE;
+}
+
+/**
+  * @brief  Funktion 	0x05 Write Single Coil
+  * @param  hmodbus 	MODBUS handle
+  * @param  pdu 		Anfrage ab dem Funktionscode
+  * @param  Length 		Länge der Anfrage
+  * @param  Response 	Antwort ab dem Funktionscode
+  * @param  ResponseLength Länge der Antwort
+  * @retval Ausnahme oder MODBUS_EX_NONE
+  */
+static uint8_t MODBUS_WriteSingleCoil(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength){
+
+	if(Length != 5){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+
+	uint16_t coil = (pdu[1] << 8) | pdu[2];
+	uint16_t value = (pdu[3] << 8) | pdu[4];
+
+	if(value != 0xFF00 && value != 0x0000){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+	if(coil >= MODBUS_COIL_COUNT){
+		return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+	}
+	if(MODBUS_WriteCoil(hmodbus, coil, value == 0xFF00)){
+		return MODBUS_EX_SLAVE_DEVICE_FAILURE;
+	}
+
+	/* Antwort ist das Echo der Anfrage */
+	memcpy(Response, pdu, 5);
+	*ResponseLength = 5;
+
+	return MODBUS_EX_NONE;
+}
+
+/**
+  * @brief  Funktion 	0x06 Write Single Register
+  * @param  hmodbus 	MODBUS handle
+  * @param  pdu 		Anfrage ab dem Funktionscode
+  * @param  Length 		Länge der Anfrage
+  * @param  Response 	Antwort ab dem Funktionscode
+  * @param  ResponseLength Länge der Antwort
+  * @retval Ausnahme oder MODBUS_EX_NONE
+  */
+static uint8_t MODBUS_WriteSingleRegister(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength){
+
+	if(Length != 5){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+
+	uint16_t reg = (pdu[1] << 8) | pdu[2];
+	uint16_t value = (pdu[3] << 8) | pdu[4];
+
+	/* nur die Parameter sind beschreibbar */
+	if(reg > MODBUS_REG_PARAM2){
+		return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+	}
+	if(value > MODBUS_PARAM_MAX){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+	hmodbus->Param[reg - MODBUS_REG_PARAM1] = value;
+
+	memcpy(Response, pdu, 5);
+	*ResponseLength = 5;
+
+	return MODBUS_EX_NONE;
+}
+
+/**
+  * @brief  Funktion 	0x0F Write Multiple Coils
+  * @param  hmodbus 	MODBUS handle
+  * @param  pdu 		Anfrage ab dem Funktionscode
+  * @param  Length 		Länge der Anfrage
+  * @param  Response 	Antwort ab dem Funktionscode
+  * @param  ResponseLength Länge der Antwort
+  * @retval Ausnahme oder MODBUS_EX_NONE
+  */
+static uint8_t MODBUS_WriteMultipleCoils(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength){
+
+	if(Length < 6){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+
+	uint16_t start = (pdu[1] << 8) | pdu[2];
+	uint16_t quantity = (pdu[3] << 8) | pdu[4];
+	uint8_t bytecount = pdu[5];
+
+	if(quantity == 0 || quantity > 1968 || bytecount != (quantity + 7) / 8 || Length != 6 + bytecount){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+	if(start >= MODBUS_COIL_COUNT || quantity > MODBUS_COIL_COUNT - start){
+		return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+	}
+
+	for(uint16_t i=0; i<quantity; i++){
+		if(MODBUS_WriteCoil(hmodbus, start + i, (pdu[6 + i/8] >> (i%8)) & 1)){
+			return MODBUS_EX_SLAVE_DEVICE_FAILURE;
+		}
+	}
+
+	memcpy(Response, pdu, 5);
+	*ResponseLength = 5;
+
+	return MODBUS_EX_NONE;
+}
+
+/**
+  * @brief  Funktion 	0x10 Write Multiple Registers
+  * @param  hmodbus 	MODBUS handle
+  * @param  pdu 		Anfrage ab dem Funktionscode
+  * @param  Length 		Länge der Anfrage
+  * @param  Response 	Antwort ab dem Funktionscode
+  * @param  ResponseLength Länge der Antwort
+  * @retval Ausnahme oder MODBUS_EX_NONE
+  */
+static uint8_t MODBUS_WriteMultipleRegisters(MODBUS_TypeDef *hmodbus, const uint8_t * pdu, uint16_t Length, uint8_t * Response, uint16_t * ResponseLength){
+
+	if(Length < 6){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+
+	uint16_t start = (pdu[1] << 8) | pdu[2];
+	uint16_t quantity = (pdu[3] << 8) | pdu[4];
+	uint8_t bytecount = pdu[5];
+
+	if(quantity == 0 || quantity > 123 || bytecount != quantity * 2 || Length != 6 + bytecount){
+		return MODBUS_EX_ILLEGAL_DATA_VALUE;
+	}
+	if(start > MODBUS_REG_PARAM2 || quantity > MODBUS_REG_PARAM2 + 1 - start){
+		return MODBUS_EX_ILLEGAL_DATA_ADDRESS;
+	}
+
+	/* zuerst alle Werte prüfen, damit die Anfrage ganz oder gar nicht ausgeführt wird */
+	for(uint16_t i=0; i<quantity; i++){
+		if(((pdu[6 + 2*i] << 8) | pdu[7 + 2*i]) > MODBUS_PARAM_MAX){
+			return MODBUS_EX_ILLEGAL_DATA_VALUE;
+		}
+	}
+	for(uint16_t i=0; i<quantity; i++){
+		hmodbus->Param[start + i - MODBUS_REG_PARAM1] = (pdu[6 + 2*i] << 8) | pdu[7 + 2*i];
+	}
+
+	memcpy(Response, pdu, 5);
+	*ResponseLength = 5;
+
+	return MODBUS_EX_NONE;
+}
@@ -0,0 +1,297 @@
+/**
+******************************************************************************
+* @file mylib_pwm.c
+* @author Reiter Roman
+* @brief mylib-PWM.
+* Diese Datei stellt die Helligkeit der LEDs per Hardware-PWM ein, die CPU ist am Tastgrad nicht beteiligt:
+* + Je Kanal ein eigener Timer mit 1 MHz Zähltakt und 1 kHz Periode, Tastgrad in Promille (0..1000)
+* + TIMx über die HAL (PWM Mode 1), LPTIMx über die Register (PWM-Ausgang OUT)
+* + 0 und 1000 Promille werden statisch als GPIO-Ausgang getrieben, dazwischen übernimmt der Timer den Pin (Alternate Function)
+* + Kommando "pwm" für alle Kanäle der Tabelle
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) HAL_TIM_MODULE_ENABLED in stm32l4xx_hal_conf.h
+		(+) Die Pins sind bereits als Ausgang eingerichtet (z.B. über die GPIO-Tabelle), der Treiber schaltet nur zwischen Ausgang und AF um
+		(+) Die Timer werden von keinem anderen Modul verwendet
+
+	(#) Kanal-Tabelle als const anlegen, z.B.:
+		(+++) static const PWM_ChannelTypeDef PwmTable[] = {
+		(+++)     {"gn", RGB_GN_GPIO_Port, RGB_GN_Pin, GPIO_AF1_TIM1, TIM1, TIM_CHANNEL_1, GPIO_PIN_RESET},
+		(+++)     {"bl", RGB_BL_GPIO_Port, RGB_BL_Pin, GPIO_AF14_LPTIM2, LPTIM2, 0, GPIO_PIN_RESET},
+		(+++) };
+		(+++) z.B.: MYLIB_PWM_Init(&hpwm, PwmTable, sizeof(PwmTable)/sizeof(PwmTable[0]));
+		(+) Alle Kanäle starten mit Tastgrad 0 (Pin statisch inaktiv)
+
+	(#) Kommando "pwm" in SERIALPROT_Command_User_Callback() weiterreichen
+		(+++) z.B.: return MYLIB_PWM_Command(&hpwm, hserialprot, Result);
+		(+) "#pwm,<name>:<duty>\r" stellt den Tastgrad 0..1000 Promille ein, z.B. "#pwm,rt:250\r", "=> #a,<duty>" bestätigt den Wert
+		(+) Unbekannte Kommandos werden mit SERIALPROT_COMMAND_UNKNOWN zurückgegeben
+
+	(#) Schalten die Kommandos "gpo" oder "gpm" einen Pin direkt, vorher MYLIB_PWM_ReleasePins() aufrufen,
+		damit der Pin wieder als Ausgang arbeitet (sonst bleibt der Timer am Pin)
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_pwm.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup PWM_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef PWM_InitTimer(PWM_TypeDef *hpwm, uint8_t Channel);
+static HAL_StatusTypeDef PWM_InitLowPowerTimer(const PWM_ChannelTypeDef *Descriptor);
+static void PWM_SetPinMode(const PWM_ChannelTypeDef *Descriptor, uint32_t Mode);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet die Timer aller Kanäle ein und startet sie mit Tastgrad 0
+  * @param  hpwm 		PWM handle
+  * @param  Table 		konstante Kanal-Tabelle
+  * @param  Count 		Anzahl der Einträge
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_PWM_Init(PWM_TypeDef *hpwm, const PWM_ChannelTypeDef *Table, uint8_t Count){
+
+	if(Count > PWM_MAX_CHANNELS){
+		return HAL_ERROR;
+	}
+
+	memset(hpwm,0,sizeof(PWM_TypeDef));
+	hpwm->Table = Table;
+	hpwm->Count = Count;
+
+	for(uint8_t i = 0; i < Count; i++){
+		const PWM_ChannelTypeDef *descriptor = &Table[i];
+		uint32_t shift = (POSITION_VAL(descriptor->Pin) & 0x07U) * 4U;
+
+		/* Alternate Function schon jetzt eintragen, sie wirkt erst beim Umschalten des Pins auf AF */
+		MODIFY_REG(descriptor->Port->AFR[POSITION_VAL(descriptor->Pin) >> 3], 0x0FU << shift, (uint32_t)descriptor->Alternate << shift);
+
+		HAL_StatusTypeDef status = IS_LPTIM_INSTANCE(descriptor->Instance) ? PWM_InitLowPowerTimer(descriptor)
+																			  : PWM_InitTimer(hpwm, i);
+		if(status != HAL_OK){
+			return status;
+		}
+		MYLIB_PWM_SetDuty(hpwm, i, 0);
+	}
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	stellt den Tastgrad eines Kanals ein
+  * @param  hpwm 		PWM handle
+  * @param  Channel 	Index des Kanals in der Tabelle
+  * @param  Duty 		Tastgrad in Promille (0..PWM_DUTY_MAX), bezogen auf den aktiven Pegel
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_PWM_SetDuty(PWM_TypeDef *hpwm, uint8_t Channel, uint16_t Duty){
+
+	if(Channel >= hpwm->Count || Duty > PWM_DUTY_MAX){
+		return HAL_ERROR;
+	}
+
+	const PWM_ChannelTypeDef *descriptor = &hpwm->Table[Channel];
+	GPIO_PinState inactive = (descriptor->ActiveLevel == GPIO_PIN_SET) ? GPIO_PIN_RESET : GPIO_PIN_SET;
+
+	hpwm->Duty[Channel] = Duty;
+
+	/* Ränder statisch treiben: der Timer erreicht 0 % bzw. 100 % nicht ohne Restimpuls */
+	if(Duty == 0 || Duty == PWM_DUTY_MAX){
+		HAL_GPIO_WritePin(descriptor->Port, descriptor->Pin, (Duty == 0) ? inactive : descriptor->ActiveLevel);
+		PWM_SetPinMode(descriptor, GPIO_MODE_OUTPUT_PP);
+		hpwm->Running &= ~(1U << Channel);
+		return HAL_OK;
+	}
+
+	if(IS_LPTIM_INSTANCE(descriptor->Instance)){
+		LPTIM_TypeDef *lptim = (LPTIM_TypeDef *)descriptor->Instance;
+		/* OUT ist für CMP + 1 Zähltakte aktiv, das Register wird am Periodenende übernommen */
+		lptim->ICR = LPTIM_ICR_CMPOKCF;
+		lptim->CMP = Duty - 1U;
+		while((lptim->ISR & LPTIM_ISR_CMPOK) == 0U){
+		}
+	}else{
+		__HAL_TIM_SET_COMPARE(&hpwm->htim[Channel], descriptor->Channel, Duty);
+	}
+
+	PWM_SetPinMode(descriptor, GPIO_MODE_AF_PP);
+	hpwm->Running |= (1U << Channel);
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	gibt Pins, die ein Timer treibt, wieder als Ausgang frei (vor "gpo"/"gpm" aufzurufen)
+  * @param  hpwm 		PWM handle
+  * @param  Port 		GPIO-Port der Pins
+  * @param  Pins 		Maske der Pins (GPIO_PIN_x verodert)
+  * @retval none
+  */
+void MYLIB_PWM_ReleasePins(PWM_TypeDef *hpwm, GPIO_TypeDef *Port, uint16_t Pins){
+
+	for(uint8_t i = 0; i < hpwm->Count; i++){
+		const PWM_ChannelTypeDef *descriptor = &hpwm->Table[i];
+
+		if(descriptor->Port == Port && (descriptor->Pin & Pins) != 0U && (hpwm->Running & (1U << i)) != 0U){
+			PWM_SetPinMode(descriptor, GPIO_MODE_OUTPUT_PP);
+			hpwm->Running &= ~(1U << i);
+			hpwm->Duty[i] = 0;
+		}
+	}
+}
+
+/**
+  * @brief  Funktion 	wertet das Kommando "#pwm,<name>:<duty>" aus
+  * @param  hpwm 		PWM handle
+  * @param  hserialprot SERIALPROT handle
+  * @param  Result 		Ergebnis: eingestellter Tastgrad
+  * @retval SERIALPROTOCOL_CommandStatusTypeDef
+  */
+uint8_t MYLIB_PWM_Command(PWM_TypeDef *hpwm, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"pwm")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	if(hserialprot->MessageKind != MESSAGEKIND_TEXT_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	uint16_t duty = atoi((char *)hserialprot->Parameter2);
+
+	for(uint8_t i = 0; i < hpwm->Count; i++){
+		if(!strcmp((char *)hserialprot->Parameter1, hpwm->Table[i].Name)){
+			if(MYLIB_PWM_SetDuty(hpwm, i, duty) != HAL_OK){
+				return SERIALPROT_COMMAND_INVALID;
+			}
+			itoa(duty, (char *)Result, 10);
+			return SERIALPROT_COMMAND_OK;
+		}
+	}
+	return SERIALPROT_COMMAND_INVALID;
+}
+
+/**
+  * @brief  Funktion 	richtet einen TIMx als PWM mit PWM_COUNTER_CLOCK Zähltakt und PWM_DUTY_MAX Zähltakten Periode ein
+  * @param  hpwm 		PWM handle
+  * @param  Channel 	Index des Kanals in der Tabelle
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef PWM_InitTimer(PWM_TypeDef *hpwm, uint8_t Channel){
+
+	const PWM_ChannelTypeDef *descriptor = &hpwm->Table[Channel];
+	TIM_HandleTypeDef *htim = &hpwm->htim[Channel];
+	TIM_OC_InitTypeDef sConfigOC = {0};
+	uint32_t clock;
+
+	if(descriptor->Instance == TIM1){
+		__HAL_RCC_TIM1_CLK_ENABLE();
+		clock = HAL_RCC_GetPCLK2Freq();
+	}else if(descriptor->Instance == TIM15){
+		__HAL_RCC_TIM15_CLK_ENABLE();
+		clock = HAL_RCC_GetPCLK2Freq();
+	}else if(descriptor->Instance == TIM16){
+		__HAL_RCC_TIM16_CLK_ENABLE();
+		clock = HAL_RCC_GetPCLK2Freq();
+	}else if(descriptor->Instance == TIM2){
+		__HAL_RCC_TIM2_CLK_ENABLE();
+		clock = HAL_RCC_GetPCLK1Freq();
+	}else{
+		return HAL_ERROR;
+	}
+
+	htim->Instance = (TIM_TypeDef *)descriptor->Instance;
+	htim->Init.Prescaler = clock / PWM_COUNTER_CLOCK - 1U;
+	htim->Init.CounterMode = TIM_COUNTERMODE_UP;
+	htim->Init.Period = PWM_DUTY_MAX - 1U;
+	htim->Init.ClockDivision = TIM_CLOCKDIVISION_DIV1;
+	htim->Init.RepetitionCounter = 0;
+	htim->Init.AutoReloadPreload = TIM_AUTORELOAD_PRELOAD_ENABLE;
+	if(HAL_TIM_PWM_Init(htim) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	/* PWM Mode 1: aktiv solange CNT < CCR, die Polarität bildet den aktiven Pegel der LED ab */
+	sConfigOC.OCMode = TIM_OCMODE_PWM1;
+	sConfigOC.Pulse = 0;
+	sConfigOC.OCPolarity = (descriptor->ActiveLevel == GPIO_PIN_SET) ? TIM_OCPOLARITY_HIGH : TIM_OCPOLARITY_LOW;
+	sConfigOC.OCNPolarity = TIM_OCNPOLARITY_HIGH;
+	sConfigOC.OCFastMode = TIM_OCFAST_DISABLE;
+	sConfigOC.OCIdleState = TIM_OCIDLESTATE_RESET;
+	sConfigOC.OCNIdleState = TIM_OCNIDLESTATE_RESET;
+	if(HAL_TIM_PWM_ConfigChannel(htim, &sConfigOC, descriptor->Channel) != HAL_OK){
+		return HAL_ERROR;
+	}
+
+	/* setzt bei TIM1/TIM15/TIM16 auch MOE */
+	return HAL_TIM_PWM_Start(htim, descriptor->Channel);
+}
+
+/**
+  * @brief  Funktion 	richtet einen LPTIMx (Takt PCLK1) als PWM mit PWM_COUNTER_CLOCK Zähltakt und PWM_DUTY_MAX Zähltakten Periode ein
+  * @param  Descriptor 	Kanal-Beschreibung
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef PWM_InitLowPowerTimer(const PWM_ChannelTypeDef *Descriptor){
+
+	LPTIM_TypeDef *lptim = (LPTIM_TypeDef *)Descriptor->Instance;
+	uint32_t presc = 0;
+
+	if(lptim == LPTIM1){
+		__HAL_RCC_LPTIM1_CLK_ENABLE();
+		__HAL_RCC_LPTIM1_CONFIG(RCC_LPTIM1CLKSOURCE_PCLK1);
+	}else{
+		__HAL_RCC_LPTIM2_CLK_ENABLE();
+		__HAL_RCC_LPTIM2_CONFIG(RCC_LPTIM2CLKSOURCE_PCLK1);
+	}
+
+	/* Vorteiler nur in Zweierpotenzen 1..128 */
+	while((HAL_RCC_GetPCLK1Freq() >> presc) > PWM_COUNTER_CLOCK && presc < 7U){
+		presc++;
+	}
+	if((HAL_RCC_GetPCLK1Freq() >> presc) != PWM_COUNTER_CLOCK){
+		return HAL_ERROR;
+	}
+
+	/* CFGR nur bei ENABLE = 0 schreiben, WAVPOL = 1 invertiert OUT für aktiv High */
+	lptim->CR = 0;
+	lptim->CFGR = (presc << LPTIM_CFGR_PRESC_Pos) | ((Descriptor->ActiveLevel == GPIO_PIN_SET) ? LPTIM_CFGR_WAVPOL : 0U);
+
+	/* ARR und CMP erst nach ENABLE, jede Übernahme mit ARROK bzw. CMPOK abwarten */
+	lptim->CR = LPTIM_CR_ENABLE;
+	lptim->ARR = PWM_DUTY_MAX - 1U;
+	while((lptim->ISR & LPTIM_ISR_ARROK) == 0U){
+	}
+	lptim->ICR = LPTIM_ICR_CMPOKCF;
+	lptim->CMP = 0;
+	while((lptim->ISR & LPTIM_ISR_CMPOK) == 0U){
+	}
+
+	lptim->CR = LPTIM_CR_ENABLE | LPTIM_CR_CNTSTRT;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	schaltet den Pin eines Kanals zwischen Ausgang und Alternate Function (Timer) um
+  * @param  Descriptor 	Kanal-Beschreibung
+  * @param  Mode 		GPIO_MODE_OUTPUT_PP oder GPIO_MODE_AF_PP
+  * @retval none
+  */
+static void PWM_SetPinMode(const PWM_ChannelTypeDef *Descriptor, uint32_t Mode){
+
+	uint32_t shift = POSITION_VAL(Descriptor->Pin) * 2U;
+
+	MODIFY_REG(Descriptor->Port->MODER, GPIO_MODER_MODE0 << shift, (Mode & GPIO_MODER_MODE0) << shift);
+}
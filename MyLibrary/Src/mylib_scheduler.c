@@ -0,0 +1,276 @@
+/**
+******************************************************************************
+* @file mylib_scheduler.c
+* @author Reiter Roman
+* @brief mylib-Scheduler.
+* Diese Datei führt GPIO-Aktionen zu absoluten Zeitpunkten der Gerätezeit aus, unabhängig von der Latenz der Verbindung:
+* + Gerätezeit ist ein frei laufender 32-Bit-Timer mit 1 MHz (Überlauf nach ca. 71 Minuten)
+* + Die Aktionen stehen nach Zeitpunkt sortiert in einer Warteschlange, der Vergleichskanal 4 des Timers
+*   löst genau zum Zeitpunkt der vordersten Aktion einen Interrupt aus, der sie mit einem BSRR-Zugriff ausführt
+* + Der Host liest die Gerätezeit, lädt die Aktionen im Voraus und erhält sie unabhängig vom Zeitpunkt der Kommandos
+* + Zeitvergleiche über die vorzeichenbehaftete Differenz, dadurch auch über den Überlauf der Gerätezeit hinweg gültig
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Takt des Timers einschalten, Timer-Interrupt mit der Priorität der Transportschichten (0) freigeben,
+			damit Kommandos und Vergleichs-Interrupt sich nicht unterbrechen
+		(+) Pin-Tabelle initialisiert (mylib_gpiotable), die Aktionen verwenden deren Namen und aktive Pegel
+
+	(#) Scheduler initialisieren, der Timer läuft ab jetzt als Gerätezeit
+		(+++) z.B.: MYLIB_SCHEDULER_Init(&hscheduler, TIM2, &hgpiotable);
+
+	(#) Interrupt weiterreichen
+		(+++) TIM2_IRQHandler ()  -> MYLIB_SCHEDULER_IRQHandler(&hscheduler)
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen
+		(+++) z.B.: return MYLIB_SCHEDULER_Command(&hscheduler, hserialprot, Result);
+		(+) Ein Zeitpunkt hat bis zu 10 Stellen, die Parameter nur 4: Zeitpunkt = hoch * 10^8 + mitte * 10^4 + tief
+		(+) "#tnw,0:0"          liest die Gerätezeit in µs, "=> #a,<zeit>"
+		(+) "#tsh,<hoch>:<mitte>" setzt den oberen Teil der folgenden Zeitpunkte (hoch 0..42, mitte 0..9999,
+			zusammen höchstens 42:9496, sonst NACK)
+		(+) "#son,<name>:<tief>"  schaltet den Pin <name> der Pin-Tabelle zum Zeitpunkt ein (aktiver Pegel)
+		(+) "#sof,<name>:<tief>"  schaltet ihn zum Zeitpunkt aus
+		(+) "#scl,0:0"          verwirft alle wartenden Aktionen, "=> #a,<anzahl>"
+		(+) "#sst,0:0"          "=> #a,<wartend>,<ausgeführt>,<max. Verspätung in µs>"
+		(+) "son"/"sof" werden mit "=> #a,<wartend>" bestätigt, NACK bei voller Warteschlange, unbekanntem Namen,
+			einem Zeitpunkt über 2^32 - 1 oder
+			einem Zeitpunkt, der nicht mindestens SCHEDULER_LEAD_MIN_US und höchstens 2^31 µs in der Zukunft liegt
+		(+) Aktionen mit gleichem Zeitpunkt werden in der Reihenfolge der Kommandos ausgeführt
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_scheduler.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SCHEDULER_Private_Functions
+  * @{
+  */
+static void SCHEDULER_ArmCompare(SCHEDULER_TypeDef *hscheduler);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	startet den Timer als frei laufende Gerätezeit mit SCHEDULER_COUNTER_CLOCK, die Warteschlange ist leer
+  * @param  hscheduler 	SCHEDULER handle
+  * @param  Timer 		32-Bit-Timer (TIM2), Takt bereits eingeschaltet
+  * @param  hgpiotable 	initialisierte Pin-Tabelle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SCHEDULER_Init(SCHEDULER_TypeDef *hscheduler, TIM_TypeDef *Timer, GPIOTABLE_TypeDef *hgpiotable){
+
+	if(!IS_TIM_32B_COUNTER_INSTANCE(Timer) || HAL_RCC_GetPCLK1Freq() % SCHEDULER_COUNTER_CLOCK != 0U){
+		return HAL_ERROR;
+	}
+
+	memset(hscheduler,0,sizeof(SCHEDULER_TypeDef));
+	hscheduler->Timer = Timer;
+	hscheduler->hgpiotable = hgpiotable;
+
+	/* Kanal 4 als reiner Vergleich (Frozen, kein Pin), der Interrupt wird erst mit der ersten Aktion freigegeben */
+	Timer->CR1 = 0;
+	Timer->DIER = 0;
+	Timer->CCMR2 &= ~(TIM_CCMR2_CC4S | TIM_CCMR2_OC4M | TIM_CCMR2_OC4PE);
+	Timer->PSC = HAL_RCC_GetPCLK1Freq() / SCHEDULER_COUNTER_CLOCK - 1U;
+	Timer->ARR = 0xFFFFFFFFU;
+	Timer->EGR = TIM_EGR_UG;
+	Timer->SR = 0;
+	Timer->CR1 = TIM_CR1_CEN;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	liefert die Gerätezeit
+  * @param  hscheduler 	SCHEDULER handle
+  * @retval Gerätezeit in µs
+  */
+uint32_t MYLIB_SCHEDULER_GetTime(SCHEDULER_TypeDef *hscheduler){
+
+	return hscheduler->Timer->CNT;
+}
+
+/**
+  * @brief  Funktion 	sortiert eine Aktion in die Warteschlange ein
+  * @param  hscheduler 	SCHEDULER handle
+  * @param  Time 		Zeitpunkt in µs Gerätezeit
+  * @param  Descriptor 	Ausgang der Pin-Tabelle
+  * @param  On 			1: aktiver Pegel, 0: inaktiver Pegel
+  * @retval HAL status (HAL_ERROR bei voller Warteschlange, Eingang oder Zeitpunkt außerhalb des gültigen Bereichs)
+  */
+HAL_StatusTypeDef MYLIB_SCHEDULER_Add(SCHEDULER_TypeDef *hscheduler, uint32_t Time, const GPIOTABLE_DescriptorTypeDef *Descriptor, uint8_t On){
+
+	int32_t lead = (int32_t)(Time - MYLIB_SCHEDULER_GetTime(hscheduler));
+	uint8_t i;
+
+	if(hscheduler->Count >= SCHEDULER_QUEUE_SIZE || Descriptor->Mode == GPIO_MODE_INPUT || lead < SCHEDULER_LEAD_MIN_US){
+		return HAL_ERROR;
+	}
+
+	/* während des Umsortierens keinen Vergleichs-Interrupt, ein anstehendes Ereignis folgt danach */
+	hscheduler->Timer->DIER &= ~TIM_DIER_CC4IE;
+
+	/* hinter allen Aktionen mit gleichem oder früherem Zeitpunkt einsortieren */
+	for(i = hscheduler->Count; i > 0 && (int32_t)(hscheduler->Queue[i - 1].Time - Time) > 0; i--){
+		hscheduler->Queue[i] = hscheduler->Queue[i - 1];
+	}
+	hscheduler->Queue[i].Time = Time;
+	hscheduler->Queue[i].Port = Descriptor->Port;
+	hscheduler->Queue[i].Bsrr = ((On != 0) == (Descriptor->ActiveLevel == GPIO_PIN_SET)) ? Descriptor->Pin : (uint32_t)Descriptor->Pin << 16;
+	hscheduler->Count++;
+
+	SCHEDULER_ArmCompare(hscheduler);
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	verwirft alle wartenden Aktionen
+  * @param  hscheduler 	SCHEDULER handle
+  * @retval Anzahl der verworfenen Aktionen
+  */
+uint8_t MYLIB_SCHEDULER_Clear(SCHEDULER_TypeDef *hscheduler){
+
+	uint8_t count;
+
+	hscheduler->Timer->DIER &= ~TIM_DIER_CC4IE;
+	count = hscheduler->Count;
+	hscheduler->Count = 0;
+	hscheduler->Timer->SR = ~TIM_SR_CC4IF;
+
+	return count;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos des Schedulers aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hscheduler 	SCHEDULER handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_SCHEDULER_Command(SCHEDULER_TypeDef *hscheduler, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	/* Gerätezeit lesen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"tnw")){
+		if(!__SERIALPROT_IS_COMMAND(hserialprot,"tnw","0","0")){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa(MYLIB_SCHEDULER_GetTime(hscheduler), (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* oberer Teil der folgenden Zeitpunkte */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"tsh")){
+		uint32_t high = atoi((char *)hserialprot->Parameter1);
+		uint32_t middle = atoi((char *)hserialprot->Parameter2);
+		uint64_t time = (uint64_t)high * 100000000U + (uint64_t)middle * 10000U;
+
+		/* der obere Teil muss in 32 Bit passen (höchstens 42 * 10^8 + 9496 * 10^4), den unteren prüft "son"/"sof" */
+		if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER || middle > SERIALPROT_PARAM_MAX || time > 0xFFFFFFFFU){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hscheduler->TimeHigh = (uint32_t)time;
+		return SERIALPROT_COMMAND_OK;
+
+	/* Aktion einplanen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"son") || __SERIALPROT_IS_COMMANDNAME(hserialprot,"sof")){
+		if(hserialprot->MessageKind != MESSAGEKIND_TEXT_NUMBER){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		const GPIOTABLE_DescriptorTypeDef *descriptor = MYLIB_GPIOTABLE_Find(hscheduler->hgpiotable, (char *)hserialprot->Parameter1);
+		uint64_t time = (uint64_t)hscheduler->TimeHigh + (uint32_t)atoi((char *)hserialprot->Parameter2);
+
+		if(descriptor == NULL || time > 0xFFFFFFFFU
+				|| MYLIB_SCHEDULER_Add(hscheduler, (uint32_t)time, descriptor, __SERIALPROT_IS_COMMANDNAME(hserialprot,"son")) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		itoa(hscheduler->Count, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Warteschlange leeren */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"scl")){
+		if(!__SERIALPROT_IS_COMMAND(hserialprot,"scl","0","0")){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		itoa(MYLIB_SCHEDULER_Clear(hscheduler), (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Zustand */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sst")){
+		if(!__SERIALPROT_IS_COMMAND(hserialprot,"sst","0","0")){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		itoa(hscheduler->Count, (char *)Result, 10);
+		strcat((char *)Result, ",");
+		utoa(hscheduler->Fired, (char *)Result + strlen((char *)Result), 10);
+		strcat((char *)Result, ",");
+		utoa(hscheduler->MaxLate, (char *)Result + strlen((char *)Result), 10);
+		return SERIALPROT_COMMAND_OK;
+	}
+
+	return SERIALPROT_COMMAND_UNKNOWN;
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des Timers aufzurufen: führt alle fälligen Aktionen aus
+  * @param  hscheduler 	SCHEDULER handle
+  * @retval none
+  */
+void MYLIB_SCHEDULER_IRQHandler(SCHEDULER_TypeDef *hscheduler){
+
+	TIM_TypeDef *timer = hscheduler->Timer;
+
+	if(!(timer->SR & TIM_SR_CC4IF) || !(timer->DIER & TIM_DIER_CC4IE)){
+		return;
+	}
+	timer->SR = ~TIM_SR_CC4IF;
+
+	SCHEDULER_ArmCompare(hscheduler);
+}
+
+/**
+  * @brief  Funktion 	führt alle bereits fälligen Aktionen aus und stellt den Vergleich auf die nächste Aktion
+  * @param  hscheduler 	SCHEDULER handle
+  * @retval none
+  */
+static void SCHEDULER_ArmCompare(SCHEDULER_TypeDef *hscheduler){
+
+	TIM_TypeDef *timer = hscheduler->Timer;
+
+	while(hscheduler->Count > 0){
+		SCHEDULER_ActionTypeDef *action = &hscheduler->Queue[0];
+		int32_t late = (int32_t)(timer->CNT - action->Time);
+
+		if(late < 0){
+			/* Vergleich auf die nächste Aktion stellen; liegt sie danach schon zurück, hat der Vergleich sie
+			   verpasst und sie wird sofort ausgeführt */
+			timer->CCR4 = action->Time;
+			timer->SR = ~TIM_SR_CC4IF;
+			timer->DIER |= TIM_DIER_CC4IE;
+			if((int32_t)(timer->CNT - action->Time) < 0){
+				return;
+			}
+			timer->DIER &= ~TIM_DIER_CC4IE;
+			late = (int32_t)(timer->CNT - action->Time);
+		}
+
+		action->Port->BSRR = action->Bsrr;
+		hscheduler->Fired++;
+		if((uint32_t)late > hscheduler->MaxLate){
+			hscheduler->MaxLate = late;
+		}
+
+		hscheduler->Count--;
+		memmove(&hscheduler->Queue[0], &hscheduler->Queue[1], hscheduler->Count * sizeof(SCHEDULER_ActionTypeDef));
+	}
+
+	timer->DIER &= ~TIM_DIER_CC4IE;
+}
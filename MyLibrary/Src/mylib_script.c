@@ -0,0 +1,630 @@
+/**
+******************************************************************************
+* @file mylib_script.c
+* @author Reiter Roman
+* @brief mylib-Skript.
+* Diese Datei führt hochgeladene Programme aus Bytecode direkt am Gerät aus:
+* + Kleiner Stack-Interpreter mit Variablen, Sprüngen, Schleifenzähler und Wartezeiten
+* + Die Kommandos des Protokolls ("rdm", "add", "asc", "gpo") laufen über eine eigene Instanz des Protokolls
+*   ohne Transportschicht, wie eine über die Schnittstelle empfangene Zeile
+* + Folgen wie "LED schalten, warten, Zufallszahl lesen, addieren, 1000 mal wiederholen" brauchen so keine Runde
+*   über die Schnittstelle je Schritt, es werden nur die mit EMIT gemeldeten Ergebnisse gesendet
+* + Takt des Interpreters ist der Interrupt eines LPTIM (SCRIPT_TICK_MS), je Takt laufen höchstens
+*   SCRIPT_STEPS_PER_TICK Befehle, ein Programm blockiert die übrigen Interrupts also nie länger als einen Takt
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Takt des LPTIM ist PCLK1, sein Interrupt ist freigegeben (Priorität 0 wie die Transportschichten,
+			die Kommandos des Programms und die der Schnittstellen unterbrechen sich nicht)
+
+	(#) Konfiguration eintragen und den Interpreter initialisieren
+		(+++) z.B.: hscript.Init.Timer = LPTIM1;
+		(+++) z.B.: MYLIB_SCRIPT_Init(&hscript);
+
+	(#) Interrupt des LPTIM weiterreichen
+		(+++) LPTIM1_IRQHandler ()  -> MYLIB_SCRIPT_IRQHandler(&hscript)
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen (alle Werte dezimal)
+		(+++) z.B.: return MYLIB_SCRIPT_Command(&hscript, hserialprot, Result);
+		(+) "#vmc,0:0"            löscht das Programm, "=> #a,0"
+		(+) "#vma,<byte>:<byte>"  hängt zwei Bytes (0..255) an das Programm an, "=> #a,<länge>"
+			(ein überzähliges Byte am Ende darf 0 = END sein)
+		(+) "#vmr,<v0>:<v1>"      startet das Programm ab Adresse 0 mit den Variablen 0 und 1, alle übrigen 0,
+			"=> #a,<länge>", der erste Befehl läuft im nächsten Takt
+		(+) "#vmx,0:0"            hält das Programm an, "=> #a,<zustand>,<adresse>" (Zustand vor dem Anhalten: 0 aus, 1 läuft)
+		(+) "#vmv,<v>:0"          liest Variable v (auch nach dem Ende), "=> #a,<wert>"
+		(+) "vmc" und "vma" nur ohne laufendes Programm, sonst NACK
+		(+) Das Programm selbst darf keine "vm"-Kommandos aufrufen (NACK)
+		(+) CALL kennt nur "rdm" und "add" (wie mylib_modbus), "asc" und "gpo" haben eigene Befehle, alle übrigen
+			Namen brechen mit SCRIPT_ERROR_OPCODE ab: Kommandos, die später Meldungen senden ("lar", "ads", "fqs",
+			"cpa", "sqr", ..), würden diese an die eigene Instanz ohne Transportschicht richten
+
+	(#) Befehle (SCRIPT_OpcodeTypeDef), Operanden folgen dem Befehl, Werte auf dem Stack sind int32_t
+		(+) Beispiel: 1000 mal die rote LED umschalten, 10 ms warten, Zufallszahl 1..100 addieren, dann die Summe melden
+			(+++) 00: PUSHW 232 3   STORE 7          Zähler = 1000
+			(+++) 05: LOAD 1        NOT   DUP   STORE 1   GPO 2 'r' 't'   Variable 1 umschalten, "#gpo,rt:on|off"
+			(+++) 15: PUSH 10       WAIT
+			(+++) 18: PUSH 1  PUSH 100  CALL 'r' 'd' 'm'   LOAD 0  ADD  STORE 0
+			(+++) 31: DJNZ 7 5      LOAD 0  EMIT  END
+			(+++) als Bytes: 2,232,3,4,7, 3,1,13,5,4,1,20,2,114,116, 1,10,17, 1,1,1,100,18,114,100,109,3,0,8,4,0, 16,7,5,3,0,21,0
+			(+++) hochladen mit "#vma,2:232", "#vma,3:4", .. und starten mit "#vmr,0:0"
+
+	(#) Meldungen an die Instanz von "vmr"
+		(+) "=> #e,vm,v,<wert>"              Wert von EMIT (eine volle Sendewarteschlange hält das Programm an, bis Platz ist)
+		(+) "=> #e,vm,end,<befehle>,<ms>"    Programm am END angekommen, ausgeführte Befehle und Laufzeit
+		(+) "=> #e,vm,err,<fehler>,<adr>"    Programm abgebrochen (SCRIPT_ErrorTypeDef) am Befehl an Adresse adr
+
+	(#) Grenzen
+		(+) Parameter der Kommandos sind nicht negativ (0..SCRIPT_ARG_MAX)
+		(+) Ergebnis eines Kommandos ist die erste Zahl nach "#a,", ein Kommando kostet etwa SCRIPT_CALL_STEPS Befehle
+		(+) Wartezeiten haben die Auflösung eines Takts (SCRIPT_TICK_MS)
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_script.h"
+#include "stdlib.h"
+#include "string.h"
+#include "ctype.h"
+
+/* Private variables ---------------------------------------------------------*/
+/** @addtogroup SCRIPT_Private_Variables
+  * @{
+  */
+
+/* Kommandos des Befehls CALL, nur solche mit sofortigem Ergebnis und ohne spätere Meldungen */
+static const char * const SCRIPT_CallNames[] = {"rdm", "add"};
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SCRIPT_Private_Functions
+  * @{
+  */
+static void SCRIPT_Run(SCRIPT_TypeDef *hscript);
+static SCRIPT_ErrorTypeDef SCRIPT_Step(SCRIPT_TypeDef *hscript, uint16_t *Cost);
+static SCRIPT_ErrorTypeDef SCRIPT_Call(SCRIPT_TypeDef *hscript, const char * Name, int32_t Param1, int32_t Param2, int32_t * Value);
+static SCRIPT_ErrorTypeDef SCRIPT_Execute(SCRIPT_TypeDef *hscript, const char * Command, int32_t * Value);
+static HAL_StatusTypeDef SCRIPT_Finish(SCRIPT_TypeDef *hscript);
+static HAL_StatusTypeDef SCRIPT_Send(SCRIPT_TypeDef *hscript, const char * Event);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet den LPTIM als Takt des Interpreters ein (SCRIPT_TICK_MS, Interrupt bei ARR) und leert das Programm
+  * @param  hscript 	SCRIPT handle mit ausgefüllter Konfiguration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SCRIPT_Init(SCRIPT_TypeDef *hscript){
+
+	LPTIM_TypeDef *timer = hscript->Init.Timer;
+	uint32_t clock = HAL_RCC_GetPCLK1Freq();
+	uint8_t presc = 0;
+
+	if(!IS_LPTIM_INSTANCE(timer)){
+		return HAL_ERROR;
+	}
+
+	memset(hscript->Code, 0, sizeof(hscript->Code));
+	memset(hscript->Var, 0, sizeof(hscript->Var));
+	hscript->Length = 0;
+	hscript->State = SCRIPT_STATE_IDLE;
+	hscript->Error = SCRIPT_ERROR_NONE;
+	hscript->hserialprot = NULL;
+
+	/* Instanz des Protokolls nur für die Kommandos, ohne Transportschicht, Echo und Eingabeaufforderung */
+	memset(&hscript->Engine, 0, sizeof(SERIALPROTOCOL_TypeDef));
+	hscript->Engine.Quiet = 1;
+
+	/* kleinster Teiler (1..128), bei dem ein Takt in das 16-Bit-ARR passt */
+	while(presc < 7 && (clock >> presc) / 1000U * SCRIPT_TICK_MS > 65536U){
+		presc++;
+	}
+	hscript->Reload = (clock >> presc) / 1000U * SCRIPT_TICK_MS - 1U;
+
+	/* CFGR und IER nur bei ausgeschaltetem LPTIM beschreibbar */
+	timer->CR = 0;
+	timer->CFGR = (uint32_t)presc << LPTIM_CFGR_PRESC_Pos;
+	timer->IER = LPTIM_IER_ARRMIE;
+	timer->ICR = LPTIM_ICR_ARRMCF | LPTIM_ICR_ARROKCF;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	löscht das Programm
+  * @param  hscript 	SCRIPT handle
+  * @retval none
+  */
+void MYLIB_SCRIPT_Clear(SCRIPT_TypeDef *hscript){
+
+	memset(hscript->Code, 0, sizeof(hscript->Code));
+	hscript->Length = 0;
+}
+
+/**
+  * @brief  Funktion 	hängt Bytes an das Programm an
+  * @param  hscript 	SCRIPT handle
+  * @param  Code 		Bytes
+  * @param  Length 		Anzahl der Bytes
+  * @retval HAL status (HAL_ERROR, wenn das Programm läuft oder die Bytes nicht mehr in SCRIPT_CODE_SIZE passen)
+  */
+HAL_StatusTypeDef MYLIB_SCRIPT_Append(SCRIPT_TypeDef *hscript, const uint8_t *Code, uint16_t Length){
+
+	if(hscript->State != SCRIPT_STATE_IDLE || hscript->Length + Length > SCRIPT_CODE_SIZE){
+		return HAL_ERROR;
+	}
+	memcpy(&hscript->Code[hscript->Length], Code, Length);
+	hscript->Length += Length;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	startet das Programm ab Adresse 0, der erste Befehl läuft im nächsten Takt
+  * @param  hscript 	SCRIPT handle
+  * @param  Var0 		Anfangswert der Variable 0
+  * @param  Var1 		Anfangswert der Variable 1 (alle übrigen 0)
+  * @retval HAL status (HAL_ERROR ohne Programm)
+  */
+HAL_StatusTypeDef MYLIB_SCRIPT_Start(SCRIPT_TypeDef *hscript, int32_t Var0, int32_t Var1){
+
+	LPTIM_TypeDef *timer = hscript->Init.Timer;
+
+	if(hscript->Length == 0){
+		return HAL_ERROR;
+	}
+
+	MYLIB_SCRIPT_Stop(hscript);
+
+	memset(hscript->Var, 0, sizeof(hscript->Var));
+	hscript->Var[0] = Var0;
+	hscript->Var[1] = Var1;
+	hscript->Pc = 0;
+	hscript->Sp = 0;
+	hscript->Wait = 0;
+	hscript->Steps = 0;
+	hscript->Ticks = 0;
+	hscript->Error = SCRIPT_ERROR_NONE;
+	hscript->State = SCRIPT_STATE_RUN;
+
+	/* ARR erst nach dem Einschalten beschreibbar, danach fortlaufend zählen */
+	timer->CR = LPTIM_CR_ENABLE;
+	timer->ARR = hscript->Reload;
+	while((timer->ISR & LPTIM_ISR_ARROK) == 0U){
+	}
+	timer->ICR = LPTIM_ICR_ARROKCF | LPTIM_ICR_ARRMCF;
+	timer->CR = LPTIM_CR_ENABLE | LPTIM_CR_CNTSTRT;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	hält das Programm sofort an, Variablen und Programm bleiben erhalten
+  * @param  hscript 	SCRIPT handle
+  * @retval none
+  */
+void MYLIB_SCRIPT_Stop(SCRIPT_TypeDef *hscript){
+
+	hscript->Init.Timer->CR = 0;
+	hscript->Init.Timer->ICR = LPTIM_ICR_ARRMCF;
+	hscript->State = SCRIPT_STATE_IDLE;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos des Interpreters aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hscript 	SCRIPT handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_SCRIPT_Command(SCRIPT_TypeDef *hscript, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"vmc") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"vma")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"vmr") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"vmx")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"vmv")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos des Interpreters haben zwei Zahlen als Parameter, das Programm darf sich nicht selbst steuern */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER || hserialprot == &hscript->Engine){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	uint16_t param1 = atoi((char *)hserialprot->Parameter1);
+	uint16_t param2 = atoi((char *)hserialprot->Parameter2);
+
+	/* Programm löschen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"vmc")){
+		if(hscript->State != SCRIPT_STATE_IDLE){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		MYLIB_SCRIPT_Clear(hscript);
+		utoa(hscript->Length, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* zwei Bytes anhängen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"vma")){
+		uint8_t code[2] = {param1, param2};
+		if(param1 > 255 || param2 > 255 || MYLIB_SCRIPT_Append(hscript, code, sizeof(code)) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa(hscript->Length, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* starten */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"vmr")){
+		hscript->hserialprot = hserialprot;
+		if(MYLIB_SCRIPT_Start(hscript, param1, param2) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		utoa(hscript->Length, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Variable lesen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"vmv")){
+		if(param1 >= SCRIPT_VARS){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		itoa(hscript->Var[param1], (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* anhalten */
+	}else{
+		utoa(hscript->State, (char *)Result, 10);
+		strcat((char *)Result, ",");
+		utoa(hscript->Pc, (char *)Result + strlen((char *)Result), 10);
+		MYLIB_SCRIPT_Stop(hscript);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des LPTIM aufzurufen: zählt Wartezeiten und führt die Befehle des Takts aus
+  * @param  hscript 	SCRIPT handle
+  * @retval none
+  */
+void MYLIB_SCRIPT_IRQHandler(SCRIPT_TypeDef *hscript){
+
+	LPTIM_TypeDef *timer = hscript->Init.Timer;
+
+	if(!(timer->ISR & LPTIM_ISR_ARRM)){
+		return;
+	}
+	timer->ICR = LPTIM_ICR_ARRMCF;
+
+	if(hscript->State != SCRIPT_STATE_RUN){
+		return;
+	}
+	hscript->Ticks++;
+
+	/* abgebrochenes Programm: nur noch die Meldung, bis sie in die Sendewarteschlange passt */
+	if(hscript->Error != SCRIPT_ERROR_NONE){
+		SCRIPT_Finish(hscript);
+		return;
+	}
+
+	if(hscript->Wait != 0 && --hscript->Wait != 0){
+		return;
+	}
+	SCRIPT_Run(hscript);
+}
+
+/**
+  * @brief  Funktion 	führt Befehle aus, bis das Programm wartet, endet oder die Befehle des Takts verbraucht sind
+  * @param  hscript 	SCRIPT handle
+  * @retval none
+  */
+static void SCRIPT_Run(SCRIPT_TypeDef *hscript){
+
+	uint16_t budget = SCRIPT_STEPS_PER_TICK;
+
+	while(hscript->State == SCRIPT_STATE_RUN && hscript->Wait == 0){
+		uint16_t pc = hscript->Pc;
+		uint16_t cost = 1;
+		SCRIPT_ErrorTypeDef error;
+
+		if(pc >= hscript->Length){
+			error = SCRIPT_ERROR_OPCODE;
+		}else if(hscript->Code[pc] == SCRIPT_OP_END){
+			SCRIPT_Finish(hscript);
+			return;
+		}else{
+			error = SCRIPT_Step(hscript, &cost);
+		}
+
+		if(error != SCRIPT_ERROR_NONE){
+			/* Pc bleibt auf dem fehlerhaften Befehl, die Meldung nennt seine Adresse */
+			hscript->Pc = pc;
+			hscript->Error = error;
+			SCRIPT_Finish(hscript);
+			return;
+		}
+
+		/* EMIT bei voller Sendewarteschlange: nicht ausgeführt, im nächsten Takt erneut */
+		if(cost == 0){
+			return;
+		}
+		hscript->Steps++;
+		if(budget <= cost){
+			return;
+		}
+		budget -= cost;
+	}
+}
+
+/**
+  * @brief  Funktion 	führt einen Befehl aus (nicht END)
+  * @param  hscript 	SCRIPT handle
+  * @param  Cost 		Kosten des Befehls in Befehlen, nur bei Kommandos des Protokolls verändert, 0 = nicht ausgeführt
+  * @retval SCRIPT_ERROR_NONE oder der Fehler, Pc steht danach auf dem nächsten Befehl
+  */
+static SCRIPT_ErrorTypeDef SCRIPT_Step(SCRIPT_TypeDef *hscript, uint16_t *Cost){
+
+	/* Operanden und Stack vor dem Befehl prüfen, danach greift der Befehl ohne weitere Prüfung zu */
+	static const uint8_t operands[] = {0, 1, 2, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 2, 0, 3, 0, 1, 0};
+	static const uint8_t pops[]     = {0, 0, 0, 0, 1, 1, 1, 2, 2, 2, 2, 2, 2, 1, 0, 1, 0, 1, 2, 1, 1, 1};
+	static const uint8_t pushes[]   = {0, 1, 1, 1, 0, 2, 0, 2, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, 1, 0, 0};
+
+	uint8_t *code = hscript->Code;
+	uint16_t pc = hscript->Pc;
+	uint8_t op = code[pc];
+	int32_t *stack = hscript->Stack;
+	int32_t a, b, value;
+	SCRIPT_ErrorTypeDef error;
+
+	if(op >= sizeof(operands) || pc + 1U + operands[op] > hscript->Length){
+		return SCRIPT_ERROR_OPCODE;
+	}
+	if(op == SCRIPT_OP_GPO && (code[pc + 1] == 0 || code[pc + 1] > SERIALPROT_CollectionBuffer_SIZE - 10
+			|| pc + 2U + code[pc + 1] > hscript->Length)){
+		return SCRIPT_ERROR_OPCODE;
+	}
+	if(hscript->Sp < pops[op] || hscript->Sp - pops[op] + pushes[op] > SCRIPT_STACK_SIZE){
+		return SCRIPT_ERROR_STACK;
+	}
+	if((op == SCRIPT_OP_LOAD || op == SCRIPT_OP_STORE || op == SCRIPT_OP_DJNZ) && code[pc + 1] >= SCRIPT_VARS){
+		return SCRIPT_ERROR_OPCODE;
+	}
+
+	hscript->Pc = pc + 1U + operands[op];
+
+	switch(op){
+	case SCRIPT_OP_PUSH:
+		stack[hscript->Sp++] = code[pc + 1];
+		break;
+	case SCRIPT_OP_PUSHW:
+		stack[hscript->Sp++] = code[pc + 1] | ((int32_t)code[pc + 2] << 8);
+		break;
+	case SCRIPT_OP_LOAD:
+		stack[hscript->Sp++] = hscript->Var[code[pc + 1]];
+		break;
+	case SCRIPT_OP_STORE:
+		hscript->Var[code[pc + 1]] = stack[--hscript->Sp];
+		break;
+	case SCRIPT_OP_DUP:
+		stack[hscript->Sp] = stack[hscript->Sp - 1];
+		hscript->Sp++;
+		break;
+	case SCRIPT_OP_DROP:
+		hscript->Sp--;
+		break;
+	case SCRIPT_OP_SWAP:
+		a = stack[hscript->Sp - 1];
+		stack[hscript->Sp - 1] = stack[hscript->Sp - 2];
+		stack[hscript->Sp - 2] = a;
+		break;
+	case SCRIPT_OP_ADD:
+	case SCRIPT_OP_SUB:
+	case SCRIPT_OP_MUL:
+	case SCRIPT_OP_EQ:
+	case SCRIPT_OP_LT:
+		b = stack[--hscript->Sp];
+		a = stack[--hscript->Sp];
+		/* Überlauf wie uint32_t, kein undefiniertes Verhalten */
+		if(op == SCRIPT_OP_ADD){
+			value = (int32_t)((uint32_t)a + (uint32_t)b);
+		}else if(op == SCRIPT_OP_SUB){
+			value = (int32_t)((uint32_t)a - (uint32_t)b);
+		}else if(op == SCRIPT_OP_MUL){
+			value = (int32_t)((uint32_t)a * (uint32_t)b);
+		}else if(op == SCRIPT_OP_EQ){
+			value = (a == b);
+		}else{
+			value = (a < b);
+		}
+		stack[hscript->Sp++] = value;
+		break;
+	case SCRIPT_OP_NOT:
+		stack[hscript->Sp - 1] = (stack[hscript->Sp - 1] == 0);
+		break;
+	case SCRIPT_OP_JMP:
+		hscript->Pc = code[pc + 1];
+		break;
+	case SCRIPT_OP_JZ:
+		if(stack[--hscript->Sp] == 0){
+			hscript->Pc = code[pc + 1];
+		}
+		break;
+	case SCRIPT_OP_DJNZ:
+		if(--hscript->Var[code[pc + 1]] != 0){
+			hscript->Pc = code[pc + 2];
+		}
+		break;
+	case SCRIPT_OP_WAIT:
+		value = stack[--hscript->Sp];
+		/* auch WAIT 0 gibt die CPU bis zum nächsten Takt ab */
+		hscript->Wait = (value > 0) ? ((uint32_t)value + SCRIPT_TICK_MS - 1U) / SCRIPT_TICK_MS : 1U;
+		break;
+	case SCRIPT_OP_CALL:
+		{
+			char name[4] = {code[pc + 1], code[pc + 2], code[pc + 3], 0};
+			b = stack[--hscript->Sp];
+			a = stack[--hscript->Sp];
+			*Cost = SCRIPT_CALL_STEPS;
+			error = SCRIPT_Call(hscript, name, a, b, &value);
+			if(error != SCRIPT_ERROR_NONE){
+				return error;
+			}
+			stack[hscript->Sp++] = value;
+		}
+		break;
+	case SCRIPT_OP_ASC:
+		{
+			char command[SERIALPROT_CollectionBuffer_SIZE + 1] = "#asc,";
+			a = stack[--hscript->Sp];
+			if(a < 0 || a > 127 || !isalnum(a)){
+				return SCRIPT_ERROR_ARGUMENT;
+			}
+			command[5] = a;
+			strcat(command, ":0\r");
+			*Cost = SCRIPT_CALL_STEPS;
+			error = SCRIPT_Execute(hscript, command, &value);
+			if(error != SCRIPT_ERROR_NONE){
+				return error;
+			}
+			stack[hscript->Sp++] = value;
+		}
+		break;
+	case SCRIPT_OP_GPO:
+		{
+			char command[SERIALPROT_CollectionBuffer_SIZE + 1] = "#gpo,";
+			uint8_t length = code[pc + 1];
+			hscript->Pc = pc + 2U + length;
+			memcpy(&command[5], &code[pc + 2], length);
+			command[5 + length] = 0;
+			strcat(command, stack[--hscript->Sp] ? ":on\r" : ":off\r");
+			*Cost = SCRIPT_CALL_STEPS;
+			return SCRIPT_Execute(hscript, command, NULL);
+		}
+	case SCRIPT_OP_EMIT:
+		{
+			char event[5 + 11 + 1] = "vm,v,";		/* "vm,v," + int32_t mit Vorzeichen ("-2147483648") + 0 */
+			itoa(stack[hscript->Sp - 1], event + 5, 10);
+			if(SCRIPT_Send(hscript, event) != HAL_OK){
+				hscript->Pc = pc;
+				*Cost = 0;
+			}else{
+				hscript->Sp--;
+			}
+		}
+		break;
+	default:
+		return SCRIPT_ERROR_OPCODE;
+	}
+	return SCRIPT_ERROR_NONE;
+}
+
+/**
+  * @brief  Funktion 	führt ein Kommando mit zwei Zahlen als Parameter aus ("#<name>,<param1>:<param2>")
+  * @param  hscript 	SCRIPT handle
+  * @param  Name 		Name des Kommandos (einer aus SCRIPT_CallNames)
+  * @param  Param1 		erster Parameter (0..SCRIPT_ARG_MAX)
+  * @param  Param2 		zweiter Parameter (0..SCRIPT_ARG_MAX)
+  * @param  Value 		Ergebnis des Kommandos
+  * @retval SCRIPT_ERROR_NONE oder der Fehler
+  */
+static SCRIPT_ErrorTypeDef SCRIPT_Call(SCRIPT_TypeDef *hscript, const char * Name, int32_t Param1, int32_t Param2, int32_t * Value){
+
+	char command[SERIALPROT_CollectionBuffer_SIZE + 1] = "#";
+	uint8_t known = 0;
+
+	for(uint8_t i=0; i<sizeof(SCRIPT_CallNames)/sizeof(SCRIPT_CallNames[0]); i++){
+		if(strcmp(Name, SCRIPT_CallNames[i]) == 0){
+			known = 1;
+		}
+	}
+	if(!known){
+		return SCRIPT_ERROR_OPCODE;
+	}
+	if(Param1 < 0 || Param1 > SCRIPT_ARG_MAX || Param2 < 0 || Param2 > SCRIPT_ARG_MAX){
+		return SCRIPT_ERROR_ARGUMENT;
+	}
+
+	strcat(command, Name);
+	strcat(command, ",");
+	utoa(Param1, command + strlen(command), 10);
+	strcat(command, ":");
+	utoa(Param2, command + strlen(command), 10);
+	strcat(command, "\r");
+
+	return SCRIPT_Execute(hscript, command, Value);
+}
+
+/**
+  * @brief  Funktion 	übergibt ein Kommando der eigenen Instanz des Protokolls und wertet die Antwort aus
+  * @param  hscript 	SCRIPT handle
+  * @param  Command 	vollständige Zeile "#...\r"
+  * @param  Value 		erste Zahl des Ergebnisses nach "#a," (ohne Ergebnis 0), NULL wenn nicht benötigt
+  * @retval SCRIPT_ERROR_NONE oder SCRIPT_ERROR_NACK
+  */
+static SCRIPT_ErrorTypeDef SCRIPT_Execute(SCRIPT_TypeDef *hscript, const char * Command, int32_t * Value){
+
+	uint8_t reply[SERIALPROT_TxBuffer_SIZE] = {0};
+
+	/* Zeichen einzeln wie von einer Transportschicht übergeben, Antworten werden im selben Puffer gesammelt */
+	for(uint8_t i=0; Command[i] != 0; i++){
+		uint8_t rx[2] = {Command[i], 0};
+		MYLIB_SERIALPROT_XCHANGE(&hscript->Engine, rx, reply);
+	}
+
+	if(strstr((char *)reply, "NACK") != NULL || strstr((char *)reply, "ACK") == NULL){
+		return SCRIPT_ERROR_NACK;
+	}
+
+	if(Value != NULL){
+		char * result = strstr((char *)reply, "#a,");
+		*Value = (result != NULL) ? atoi(result + 3) : 0;
+	}
+	return SCRIPT_ERROR_NONE;
+}
+
+/**
+  * @brief  Funktion 	meldet das Ende bzw. den Fehler und hält das Programm an, bei voller Sendewarteschlange im nächsten Takt erneut
+  * @param  hscript 	SCRIPT handle
+  * @retval HAL status (HAL_BUSY, wenn die Meldung nicht gesendet werden konnte)
+  */
+static HAL_StatusTypeDef SCRIPT_Finish(SCRIPT_TypeDef *hscript){
+
+	char event[32];
+
+	if(hscript->Error == SCRIPT_ERROR_NONE){
+		strcpy(event, "vm,end,");
+		utoa(hscript->Steps, event + strlen(event), 10);
+		strcat(event, ",");
+		utoa(hscript->Ticks * SCRIPT_TICK_MS, event + strlen(event), 10);
+	}else{
+		strcpy(event, "vm,err,");
+		utoa(hscript->Error, event + strlen(event), 10);
+		strcat(event, ",");
+		utoa(hscript->Pc, event + strlen(event), 10);
+	}
+
+	if(SCRIPT_Send(hscript, event) != HAL_OK){
+		return HAL_BUSY;
+	}
+	MYLIB_SCRIPT_Stop(hscript);
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	sendet eine Meldung an die Instanz, die das Programm gestartet hat
+  * @param  hscript 	SCRIPT handle
+  * @param  Event 		Text der Meldung
+  * @retval HAL status (HAL_OK auch ohne Instanz, HAL_BUSY bei voller Sendewarteschlange)
+  */
+static HAL_StatusTypeDef SCRIPT_Send(SCRIPT_TypeDef *hscript, const char * Event){
+
+	if(hscript->hserialprot == NULL){
+		return HAL_OK;
+	}
+	return MYLIB_SERIALPROT_Event(hscript->hserialprot, (const uint8_t *)Event);
+}
@@ -0,0 +1,279 @@
+/**
+******************************************************************************
+* @file mylib_sequencer.c
+* @author Reiter Roman
+* @brief mylib-Sequencer.
+* Diese Datei gibt ein vom Host geladenes Pin-Muster ohne CPU aus:
+* + Das Muster liegt als Tabelle von BSRR-Werten im RAM, je Schritt ein Wert
+* + Das Update-Ereignis eines Basis-Timers fordert je Schritt eine DMA-Übertragung Tabelle -> GPIOx->BSRR an,
+*   alle Pins eines Schritts wechseln gleichzeitig, der Takt der Schritte ist quarzgenau und ohne Jitter der Kommandos
+* + Durchläufe zählt der Transfer-Complete-Interrupt der DMA, der letzte Durchlauf endet exakt nach dem letzten Schritt
+* + Die DMA wird direkt über die Register betrieben (wie die SPI-Transportschicht)
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen
+		(+) Takt des Timers und der DMA einschalten, Interrupt des DMA-Kanals freigeben (Priorität 0 wie die Transportschichten)
+		(+) Die Pins sind bereits als Ausgang eingerichtet (z.B. über die GPIO-Tabelle)
+
+	(#) Konfiguration eintragen und den Sequencer initialisieren
+		(+++) z.B.: hsequencer.Init.Timer = TIM6;
+		(+++) z.B.: hsequencer.Init.Channel = DMA2_Channel4; hsequencer.Init.DmaRequest = 3;
+		(+++) z.B.: hsequencer.Init.Port = GPIOA; hsequencer.Init.Pins = GPIO_PIN_4|GPIO_PIN_6|GPIO_PIN_8;
+		(+++) z.B.: MYLIB_SEQUENCER_Init(&hsequencer);
+
+	(#) Interrupt des DMA-Kanals weiterreichen
+		(+++) DMA2_Channel4_IRQHandler ()  -> MYLIB_SEQUENCER_DMA_IRQHandler(&hsequencer)
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen (alle Werte dezimal)
+		(+++) z.B.: return MYLIB_SEQUENCER_Command(&hsequencer, hserialprot, Result);
+		(+) "#sqc,0:0"         löscht das Muster
+		(+) "#sqa,<pegel>:<n>" hängt n gleiche Schritte an (Bit gesetzt = High, nur Pins aus Init.Pins), "=> #a,<schritte>"
+		(+) "#sqr,<us>:<n>"    startet das Muster mit <us> Schrittzeit (SEQUENCER_STEP_MIN_US..SEQUENCER_STEP_MAX_US) und n Durchläufen (0 = endlos)
+		(+) "#sqs,0:0"         hält das Muster an, "=> #a,<durchläufe>" meldet die beendeten Durchläufe
+		(+) Nach dem letzten Durchlauf folgt die Zeile "=> #e,seq,done,<durchläufe>", bei einem DMA-Fehler "=> #e,seq,err,<durchläufe>"
+		(+) Der erste Schritt wird 1 µs nach "sqr" ausgegeben, der Pegel des letzten Schritts bleibt nach dem Ende stehen
+		(+) Während das Muster läuft, werden "sqc" und "sqa" mit NACK abgewiesen
+
+	(#) Grenzen
+		(+) Ein Durchlauf muss länger dauern als die Interrupt-Latenz, sonst werden Durchläufe nicht gezählt
+		(+) Längere Schritte als SEQUENCER_STEP_MAX_US entstehen durch Wiederholen eines Pegels mit "sqa"
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_sequencer.h"
+#include "mylib_dmachannel.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SEQUENCER_Private_Functions
+  * @{
+  */
+static void SEQUENCER_Finish(SEQUENCER_TypeDef *hsequencer, const char * Status);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	richtet Timer und DMA-Request ein, das Muster ist leer
+  * @param  hsequencer 	SEQUENCER handle mit ausgefüllter Konfiguration
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SEQUENCER_Init(SEQUENCER_TypeDef *hsequencer){
+
+	TIM_TypeDef *timer = hsequencer->Init.Timer;
+	DMA_Channel_TypeDef *channel = hsequencer->Init.Channel;
+
+	if(HAL_RCC_GetPCLK1Freq() % SEQUENCER_COUNTER_CLOCK != 0U){
+		return HAL_ERROR;
+	}
+
+	hsequencer->Count = 0;
+	hsequencer->Loops = 0;
+	hsequencer->LoopsDone = 0;
+	hsequencer->Running = 0;
+	hsequencer->hserialprot = NULL;
+
+	channel->CCR &= ~DMA_CCR_EN;
+	MYLIB_DMACHANNEL_SetRequest(channel, hsequencer->Init.DmaRequest);
+
+	/* URS: nur der Überlauf erzeugt einen DMA-Request, nicht das Laden des Vorteilers mit UG */
+	timer->CR1 = TIM_CR1_URS;
+	timer->DIER = 0;
+	timer->PSC = HAL_RCC_GetPCLK1Freq() / SEQUENCER_COUNTER_CLOCK - 1U;
+	timer->EGR = TIM_EGR_UG;
+	timer->SR = 0;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	startet die Ausgabe des Musters
+  * @param  hsequencer 	SEQUENCER handle
+  * @param  StepUs 		Schrittzeit in µs (SEQUENCER_STEP_MIN_US..SEQUENCER_STEP_MAX_US)
+  * @param  Loops 		Anzahl der Durchläufe (0 = endlos, max. SEQUENCER_LOOPS_MAX)
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SEQUENCER_Start(SEQUENCER_TypeDef *hsequencer, uint16_t StepUs, uint16_t Loops){
+
+	TIM_TypeDef *timer = hsequencer->Init.Timer;
+	DMA_Channel_TypeDef *channel = hsequencer->Init.Channel;
+
+	if(hsequencer->Count == 0 || StepUs < SEQUENCER_STEP_MIN_US || StepUs > SEQUENCER_STEP_MAX_US || Loops > SEQUENCER_LOOPS_MAX){
+		return HAL_ERROR;
+	}
+
+	MYLIB_SEQUENCER_Stop(hsequencer);
+
+	hsequencer->Loops = Loops;
+	hsequencer->LoopsDone = 0;
+
+	/* Speicher -> BSRR, 32 Bit, nur bei einem einzigen Durchlauf ohne CIRC */
+	MYLIB_DMACHANNEL_ClearFlags(channel);
+	channel->CPAR = (uint32_t)&hsequencer->Init.Port->BSRR;
+	channel->CMAR = (uint32_t)hsequencer->Table;
+	channel->CNDTR = hsequencer->Count;
+	channel->CCR = DMA_CCR_PL_1 | DMA_CCR_MSIZE_1 | DMA_CCR_PSIZE_1 | DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE
+					| ((Loops != 1) ? DMA_CCR_CIRC : 0U);
+	channel->CCR |= DMA_CCR_EN;
+
+	/* der erste Überlauf folgt nach einem Zähltakt, danach je Schritt */
+	timer->ARR = StepUs - 1U;
+	timer->CNT = StepUs - 1U;
+	timer->SR = 0;
+	timer->DIER = TIM_DIER_UDE;
+	hsequencer->Running = 1;
+	timer->CR1 |= TIM_CR1_CEN;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	hält die Ausgabe sofort an, die Pins behalten den Pegel des zuletzt ausgegebenen Schritts
+  * @param  hsequencer 	SEQUENCER handle
+  * @retval none
+  */
+void MYLIB_SEQUENCER_Stop(SEQUENCER_TypeDef *hsequencer){
+
+	hsequencer->Init.Timer->CR1 &= ~TIM_CR1_CEN;
+	hsequencer->Init.Timer->DIER = 0;
+	hsequencer->Init.Channel->CCR &= ~DMA_CCR_EN;
+	hsequencer->Running = 0;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos des Sequencers aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hsequencer 	SEQUENCER handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_SEQUENCER_Command(SEQUENCER_TypeDef *hsequencer, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqc") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqa")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqr") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqs")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos des Sequencers haben zwei Zahlen als Parameter */
+	if(hserialprot->MessageKind != MESSAGEKIND_NUMBER_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	uint16_t param1 = atoi((char *)hserialprot->Parameter1);
+	uint16_t param2 = atoi((char *)hserialprot->Parameter2);
+
+	/* Muster löschen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqc")){
+		if(hsequencer->Running){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		hsequencer->Count = 0;
+		itoa(hsequencer->Count, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Schritte anhängen: gesetzte Bits -> High, die übrigen Pins des Sequencers -> Low */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqa")){
+		if(hsequencer->Running || (param1 & ~hsequencer->Init.Pins) != 0
+				|| param2 == 0 || param2 > SEQUENCER_TABLE_SIZE - hsequencer->Count){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		uint32_t bsrr = param1 | ((uint32_t)(hsequencer->Init.Pins & ~param1) << 16);
+		while(param2--){
+			hsequencer->Table[hsequencer->Count++] = bsrr;
+		}
+		itoa(hsequencer->Count, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Muster starten */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sqr")){
+		hsequencer->hserialprot = hserialprot;
+		if(MYLIB_SEQUENCER_Start(hsequencer, param1, param2) != HAL_OK){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		itoa(hsequencer->Count, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Muster anhalten */
+	}else{
+		MYLIB_SEQUENCER_Stop(hsequencer);
+		itoa(hsequencer->LoopsDone, (char *)Result, 10);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des DMA-Kanals aufzurufen: zählt die Durchläufe und beendet das Muster
+  * @param  hsequencer 	SEQUENCER handle
+  * @retval none
+  */
+void MYLIB_SEQUENCER_DMA_IRQHandler(SEQUENCER_TypeDef *hsequencer){
+
+	DMA_Channel_TypeDef *channel = hsequencer->Init.Channel;
+	uint32_t flags = MYLIB_DMACHANNEL_GetFlags(channel);
+
+	if(!hsequencer->Running){
+		return;
+	}
+
+	if(flags & DMA_ISR_TEIF1){
+		/* Übertragungsfehler: der Kanal wurde von der DMA abgeschaltet */
+		MYLIB_SEQUENCER_Stop(hsequencer);
+		SEQUENCER_Finish(hsequencer, "err");
+		return;
+	}
+
+	if(!(flags & DMA_ISR_TCIF1)){
+		return;
+	}
+
+	hsequencer->LoopsDone++;
+
+	/* letzter Durchlauf ohne CIRC, damit die DMA nach dem letzten Schritt von selbst endet */
+	if(channel->CCR & DMA_CCR_CIRC){
+		if(hsequencer->Loops != 0 && hsequencer->LoopsDone == hsequencer->Loops - 1U){
+			/* CNDTR/CMAR sind nur bei EN = 0 beschreibbar, bereits ausgegebene Schritte des letzten Durchlaufs überspringen.
+			   Ein in dieser Zeit fälliger Request des Timers bleibt anstehen und wird nach EN bedient */
+			channel->CCR &= ~DMA_CCR_EN;
+			uint32_t remaining = channel->CNDTR;
+			channel->CMAR = (uint32_t)&hsequencer->Table[hsequencer->Count - remaining];
+			channel->CNDTR = remaining;
+			channel->CCR = (channel->CCR & ~DMA_CCR_CIRC) | DMA_CCR_EN;
+		}
+		return;
+	}
+
+	/* letzter Schritt ausgegeben: Timer anhalten, der Pegel bleibt stehen */
+	MYLIB_SEQUENCER_Stop(hsequencer);
+	SEQUENCER_Finish(hsequencer, "done");
+}
+
+/**
+  * @brief  Funktion 	meldet das Ende des Musters an die Instanz, die es gestartet hat
+  * @param  hsequencer 	SEQUENCER handle
+  * @param  Status 		"done" oder "err"
+  * @retval none
+  */
+static void SEQUENCER_Finish(SEQUENCER_TypeDef *hsequencer, const char * Status){
+
+	uint8_t event[20] = "seq,";
+
+	if(hsequencer->hserialprot == NULL){
+		return;
+	}
+
+	strcat((char *)event, Status);
+	strcat((char *)event, ",");
+	itoa(hsequencer->LoopsDone, (char *)event + strlen((char *)event), 10);
+	MYLIB_SERIALPROT_Event(hsequencer->hserialprot, event);
+}
@@ -4,9 +4,10 @@
 * @author Reiter Roman
 * @brief mylib-Serielles Protokoll.
 * Diese Datei bietet Funktionen zur Verwaltung der folgenden
-* Funktionalitäten eines seriellen Protokolls in Verbindung mit dem UART2:
+* Funktionalitäten eines seriellen Protokolls unabhängig von der Schnittstelle:
 * + IO-Betriebsfunktionen
 * + Zustands- und Fehlerfunktionen
+* + Transportschnittstelle (UART siehe mylib_serialprot_uart.c, Speicher-Loopback siehe mylib_serialprot_loopback.c)
 *
 @verbatim
 ==============================================================================
@@ -15,32 +16,38 @@
 [. . ]
 Der SERIALPROT MYLIB-Treiber kann wie folgt verwendet werden:
 
-	(#) Einbinden des UART2
-		(+) Damit das serielle Protokoll verwendet werden kann muss der UART2 aktiviert werden.
-			(++) Der UART2 muss auf den Pins PA4 (TX) und PA15(RX) liegen
-			(++) Für den UART2 werden die Standardeinstellungen der IDE-CubeMX verwendet (Baudrate, Wortlänge, Stop-Bit, Parität, Prescaler-Wert..)
-			(++) Zusätzlich muss der globale Interrupt in der NVIC-Konfiguration des UART2 aktiviert werden.
-			(++) Das Empfangen der Daten erfolgt mit HAL_UART_Receive_IT ()
-			(++) Das Senden der Daten erfolgt mit HAL_UART_Transmit ()
-			(++) Da der Datenampfang per Interrupt erfolgt, muss die Callback-Methode HAL_UART_TxCpltCallback () definiert werden.
+	(#) Einbinden der Schnittstellen
+		(+) Das Protokoll kennt die Schnittstelle nur über die Transportschnittstelle SERIALPROTOCOL_TransportTypeDef:
+			(++) Start()    startet den Empfang der Schnittstelle
+			(++) Transmit() sendet einen Sendepuffer des Protokolls ohne Kopie, der Puffer bleibt bis MYLIB_SERIALPROT_TxComplete() unverändert
+		(+) Die Schnittstelle meldet dem Protokoll:
+			(++) MYLIB_SERIALPROT_RxNotify()   empfangene Zeichen (einzeln oder als Block, z.B. aus einem DMA-Puffer)
+			(++) MYLIB_SERIALPROT_TxComplete() das Ende eines Sendevorgangs
+			(++) MYLIB_SERIALPROT_RxAbort()    einen Empfangsfehler, die angefangene Eingabe wird verworfen
+			(++) RxNotify() und TxComplete() einer Instanz dürfen sich nicht gegenseitig unterbrechen (gleiche NVIC-Priorität)
+		(+) UART (IT oder DMA): mylib_serialprot_uart.h
+			(++) Der UART2 liegt auf den Pins PA2 (TX) und PA15 (RX), der USART1 auf PA9 (TX) und PA10 (RX)
+			(++) Der LPUART1 kann beim UFQFPN32-Gehäuse nicht zusätzlich verwendet werden, da sein TX nur auf PA2 (UART2 TX) liegt
+		(+) Speicher-Loopback (ohne Hardware, z.B. für Messungen am Host): mylib_serialprot_loopback.h
 
 	(#) Verwenden des seriellen Protokolls
-		(+) Für das serielle Protokoll wird der UART2 benötigt.
-			(++) Die Daten werden mit dem UART2 per Interrupt zeichenweise empfangen. Dafür muss ein Empfangspuffer deklariert und initialisiert werden.
-				(+++) z.B.: uint8_t RxBuffer[RxBuffer_SIZE]={0};
-			(++) Der Funktion HAL_UART_Receive_IT () muss der Empfangspuffer übergeben werden.
-				(+++) z.B.: HAL_UART_Receive_IT(&huart2, RxBuffer, 1)
-			(++) Nach einem Zeichenempfang wird die HAL_UART_RxCpltCallback () aufgerufen
-				(+++) Um die Eingabe mit dem seriellen Protokoll zu verknüpfen muss ein exchangePuffer angelegt werden,
-				 welcher die Antworten zu den getätigten Eingaben in RxBuffer enthält.
-					(++++) z.B.: uint8_t exchangedMessage[50] ={0};
-				(+++) Als Schnittstelle für die Eingabe (RxBuffer) und der Ausgabe (exchangedMessage) muss die Funktion
-					MYLIB_SERIALPROT_XCHANGE() aufgerufen werden.
-					(++++) z.B.: MYLIB_SERIALPROT_XCHANGE(&hserialprot,RxBuffer,exchangedMessage);
-				(+++) Die erstellte Antwortnachricht muss nun über den UART2 hinausgeschrieben werden HAL_UART_Transmit()
-					(++++) z.B.: HAL_UART_Transmit(&huart2, exchangedMessage,(uint16_t)strlen(exchangedMessage), 100)
-				(+++) Abschließend muss der Interrupt für den UART2-Empfang wieder aktiviert werden HAL_UART_Receive_IT()
-					(++++) z.B.: HAL_UART_Receive_IT(&huart2, RxBuffer, RxBuffer_SIZE)
+		(+) Je Schnittstelle wird eine eigene Instanz (SERIALPROT handle) angelegt, der gesamte Zustand einer Verbindung liegt in dieser Instanz.
+			(++) Mehrere Schnittstellen können gleichzeitig unabhängige Kommandos bedienen (z.B. USART1 und USART2).
+				(+++) z.B.: SERIALPROTOCOL_TypeDef hserialprot2;
+			(++) Nach der Initialisierung der Schnittstelle wird die Instanz mit MYLIB_SERIALPROT_Init() an die Transportschicht gebunden, dabei wird der Empfang gestartet.
+				(+++) z.B.: MYLIB_SERIALPROT_Init(&hserialprot2, &hserialuart2.Transport);
+		(+) Senden mit zwei Sendepuffern je Instanz (TxQueue[2]):
+			(++) Die Antworten werden von MYLIB_SERIALPROT_XCHANGE() direkt in den gerade zu füllenden Puffer geschrieben,
+				 während der andere Puffer von der Schnittstelle gesendet wird. Danach werden die Puffer getauscht.
+			(++) Ist kein Platz für eine Antwort mehr frei, wird sie verworfen und in Statistics.TxDropped gezählt.
+
+	(#) Statistik der Verbindung
+		(+) Die Zähler in hserialprot.Statistics werden laufend mitgeführt (RX/TX-Zeichen, ACK, NACK je Grund, OV, max. Füllstände, max. Antwortlänge)
+			(++) Mit dem Kommando "#sta,0:0" werden alle Zähler als Datensatz fester Länge ausgegeben, mit "#sta,0:1" zusätzlich zurückgesetzt
+
+	(#) Fehlerbehandlung
+		(+) Fehler der Schnittstelle dürfen nicht zum Aufruf von Error_Handler() führen, da dieser die Interrupts sperrt und das Protokoll bis zum Neustart stillsteht.
+			(++) Die Schnittstelle zählt ihre Fehler in hserialprot.ErrorCounter und meldet sie mit MYLIB_SERIALPROT_RxAbort().
 
 	(#) Verwenden der Callback-Funktion SERIALPROT_Command_GPO_Callback()
 	 	(+) Die Funktion dient dazu, um GPIO's ansteuern zu können.
@@ -50,6 +57,27 @@ Der SERIALPROT MYLIB-Treiber kann wie folgt verwendet werden:
 	 		 		  wodurch die Eingabeparameter des letzten Kommandos abgefragt werden können
 	 		 		  (++++) z.B.: __SERIALPROT_IS_COMMAND(hserialprot,"gpo","rt","off")
 	 		 	(+++) Je nach Ergebnis muss beim erfüllen der Bedingung eine 0, anderfalls eine 1 zurückgegeben werden
+		(+) Alternativ übernimmt eine Pin-Tabelle (mylib_gpiotable.h) die Abfrage für alle Pins: MYLIB_GPIOTABLE_Command()
+
+	(#) Verwenden der Callback-Funktion SERIALPROT_Command_User_Callback()
+		(+) Jedes Kommando, das die Bibliothek nicht kennt, wird an diese Callback übergeben (z.B. die I2C-Bridge, mylib_i2cbridge.h)
+			(++) Rückgabe SERIALPROT_COMMAND_OK (ACK), SERIALPROT_COMMAND_INVALID (NACK Parameter) oder SERIALPROT_COMMAND_UNKNOWN (NACK Kommando)
+			(++) Ein in "Result" geschriebenes Ergebnis wird als "=> #a,<Result>" an das ACK angehängt
+		(+) Ergebnisse, die erst später vorliegen, werden mit MYLIB_SERIALPROT_Event() als eigene Zeile "=> #e,<Text>" gesendet
+			(++) Eine Meldung wird nur angenommen, wenn danach im Füllpuffer noch Platz für eine Antwort bleibt, sonst HAL_BUSY
+			(++) Eine Instanz ohne Transportschicht (Transport = NULL, intern bei Modbus, Skript und Makro) verwirft ihre Meldungen
+		(+) Jede mit "rdm" erzeugte Zufallszahl wird zusätzlich an SERIALPROT_Random_Callback() übergeben (z.B. für mylib_stats)
+		(+) Jedes empfangene Zeichen wird vor der Verarbeitung an SERIALPROT_RxByte_Callback() übergeben (z.B. für mylib_capture)
+
+	(#) Schneller Pfad für "#gpo,<Name>:on|off" (SERIALPROT_FastPath_Resolve_Callback())
+		(+) Die Zeile wird schon beim Empfang Zeichen für Zeichen dekodiert, beim ':' wird der Pin-Name einmal über die Callback aufgelöst
+			(++) Die Callback liefert Port und die BSRR-Werte für "on" und "off" und gibt 0 zurück, 1 = Pin nicht über den schnellen Pfad schalten
+		(+) Beim '\r' wird der Pin vor der Prüfung der Zeile mit einem einzigen BSRR-Zugriff geschaltet,
+			danach läuft die Zeile wie bisher durch SERIALPROT_Command_GPO_Callback() (muss idempotent sein) und erzeugt das ACK
+		(+) Die Zeit vom Eintreffen des Blocks mit dem '\r' in MYLIB_SERIALPROT_RxNotify() bis zum BSRR-Zugriff wird mit dem DWT-Zyklenzähler gemessen
+			(++) Nur am Target (Cortex-M), am Host wird nicht gemessen und "lat" liefert 0
+			(++) "#lat,0:0" liefert "=> #a,<Anzahl>,<letzte ns>,<max ns>", "#lat,0:1" setzt die Messung zusätzlich zurück
+			(++) Die Latenz ab dem Stoppbit hängt zusätzlich von der Transportschicht ab (UART-DMA: MYLIB_SERIALPROT_UART_EnableLineMatch())
 
 @endverbatim
 */
@@ -63,15 +91,44 @@ Der SERIALPROT MYLIB-Treiber kann wie folgt verwendet werden:
 #include "stdlib.h"
 #include "string.h"
 
+/* Private typedef -----------------------------------------------------------*/
+
+/** @defgroup SERIALPROT_Private_Types
+  * @{
+  */
+
+/**
+  * @brief  SERIALPROT NACK-Grund definition
+  */
+typedef enum
+{
+	NACK_SYNTAX = 0x00,					/*!< Eingabe entspricht nicht der Kommando-Syntax */
+	NACK_COMMAND = 0x01,				/*!< Kommando für diese Nachrichtenart nicht definiert */
+	NACK_PARAMETER = 0x02				/*!< Parameter des Kommandos ungültig */
+} SERIALPROTOCOL_NackTypeDef;
+/**
+  * @}
+  */
+
 /* Private define ------------------------------------------------------------*/
 
 /** @defgroup SERIALPROT_Private_Constants
   * @{
   */
-#define CollectionBuffer_SIZE 20
+#define CollectionBuffer_SIZE SERIALPROT_CollectionBuffer_SIZE
 #define STM32_ACK "STM32-ACK -> "
 #define STM32_NACK "STM32-NACK -> "
 #define NEW_LINE "\n\r"
+
+/* DWT-Zyklenzähler für die Latenzmessung des schnellen Pfads nur am Target,
+   am Host (z.B. Tools/serialprot_pty.c) gibt es weder DWT noch SystemCoreClock, "lat" liefert dort 0 */
+#if defined(__arm__)
+#define SERIALPROT_CYCLES() (DWT->CYCCNT)
+#define SERIALPROT_CYCLES_TO_NS(__CYCLES__) ((uint32_t)((uint64_t)(__CYCLES__) * 1000000000U / SystemCoreClock))
+#else
+#define SERIALPROT_CYCLES() (0U)
+#define SERIALPROT_CYCLES_TO_NS(__CYCLES__) (0U)
+#endif
 /**
   * @}
   */
@@ -81,7 +138,6 @@ Der SERIALPROT MYLIB-Treiber kann wie folgt verwendet werden:
   * @{
   */
 
-static uint8_t CollectionBuffer[CollectionBuffer_SIZE];
 /**
   * @}
   */
@@ -97,7 +153,12 @@ static void random_number(uint16_t * number_min, uint16_t * number_max, uint16_t
 static uint8_t string_char_frequency(char * string, char * spanset);
 static void add(uint16_t * number1, uint16_t * number2, uint16_t * result);
 static void asc(uint8_t * sign, uint8_t * result);
-static void wrong_message(uint8_t * TxBuffer);
+static void wrong_message(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer, SERIALPROTOCOL_NackTypeDef reason);
+static void hex32(uint32_t value, uint8_t * result);
+static void dec32(uint32_t value, uint8_t * result);
+static void SERIALPROT_StartTransmit(SERIALPROTOCOL_TypeDef *hserialprot);
+static void SERIALPROT_FastPath_Decode(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Character);
+static void SERIALPROT_FastPath_Reset(SERIALPROTOCOL_TypeDef *hserialprot);
 static SERIALPROTCOL_StatusTypeDef SERIALPROT_CheckMessage(SERIALPROTOCOL_TypeDef *hserialprot);
 static void SERIALPROT_CreateMessage_NUMBER_NUMBER(SERIALPROTOCOL_TypeDef *hserialprot,uint8_t * TxBuffer );
 static void SERIALPROT_CreateMessage_TEXT_TEXT(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer );
@@ -107,6 +168,9 @@ static void SERIALPROT_COMMAND_RDM(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t
 static void SERIALPROT_COMMAND_GPO(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer );
 static void SERIALPROT_COMMAND_ADD(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer );
 static void SERIALPROT_COMMAND_ASC(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer );
+static void SERIALPROT_COMMAND_STA(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer );
+static void SERIALPROT_COMMAND_LAT(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer );
+static void SERIALPROT_COMMAND_USER(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer );
 /**
   * @}
   */
@@ -177,6 +241,39 @@ static void asc(uint8_t * sign, uint8_t * result){
 	itoa(sig,result,10);
 }
 
+/**
+  * @brief  Funktion 	wandelt "value" in 8 Hex-Stellen (ohne Nullterminierung) um
+  * @param  value 		umzuwandelnder Wert
+  * @param  result  	Zielpuffer für 8 Zeichen
+  * @retval none
+  */
+static void hex32(uint32_t value, uint8_t * result){
+	static const char digits[] = "0123456789ABCDEF";
+	for(int8_t i=7; i>=0; i--){
+		result[i] = digits[value & 0x0F];
+		value >>= 4;
+	}
+}
+
+/**
+  * @brief  Funktion 	wandelt "value" in eine Dezimalzahl ohne führende Nullen (nullterminiert) um
+  * @param  value 		umzuwandelnder Wert
+  * @param  result  	Zielpuffer für bis zu 11 Zeichen
+  * @retval none
+  */
+static void dec32(uint32_t value, uint8_t * result){
+	uint8_t digits[10];
+	uint8_t n = 0;
+	do{
+		digits[n++] = '0' + value % 10U;
+		value /= 10U;
+	}while(value != 0);
+	while(n > 0){
+		*result++ = digits[--n];
+	}
+	*result = 0;
+}
+
 /**
   * @brief  Funktion zerteilt den Inputstring "string" bei jedem Zeichen "delimiter" und speichert diese in "result"
   * @param  string		der zu zerteilende String
@@ -231,22 +328,39 @@ static uint8_t string_char_frequency(char * string, char * spanset){
   */
 void MYLIB_SERIALPROT_XCHANGE(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * RxBuffer, uint8_t * TxBuffer ){
 
+	hserialprot->Statistics.RxBytes++;
+	SERIALPROT_RxByte_Callback(hserialprot, RxBuffer[0]);
+
 	/* Überprüfen eingegebene Zeichen zwischen 32 und 127 oder Enter-Taste sind */
 	if(RxBuffer[0]>=32 && RxBuffer[0]<=127 ||RxBuffer[0]=='\r' ){
 
 		/* Wenn Puffergröße überschritten, dann OV ausgeben */
-		if(strlen(CollectionBuffer)==CollectionBuffer_SIZE){
-			memset(CollectionBuffer,0,strlen(CollectionBuffer));
+		if(strlen(hserialprot->CollectionBuffer)==CollectionBuffer_SIZE){
+			hserialprot->Statistics.Overflows++;
+			memset(hserialprot->CollectionBuffer,0,strlen(hserialprot->CollectionBuffer));
+			SERIALPROT_FastPath_Reset(hserialprot);
 			strcat(TxBuffer, " -> OV\n\r");
-			strcat(TxBuffer, "Input> ");
+			if(!hserialprot->Quiet){
+				strcat(TxBuffer, "Input> ");
+			}
 
 		}else
 		{
 			/* Wenn Backspace-Taste gedrückt */
 			if(RxBuffer[0]!='\177')
 			{
-				strcat(CollectionBuffer, RxBuffer);
-				strcat(TxBuffer, RxBuffer);
+				strcat(hserialprot->CollectionBuffer, RxBuffer);
+				if(RxBuffer[0]!='\r'){
+					SERIALPROT_FastPath_Decode(hserialprot, RxBuffer[0]);
+				}
+				if(!hserialprot->Quiet){
+					strcat(TxBuffer, RxBuffer);
+				}
+
+				/* höchsten Füllstand des Eingabepuffers merken */
+				if(strlen(hserialprot->CollectionBuffer) > hserialprot->Statistics.PeakRxDepth){
+					hserialprot->Statistics.PeakRxDepth = strlen(hserialprot->CollectionBuffer);
+				}
 			}
 		}
 
@@ -254,10 +368,15 @@ void MYLIB_SERIALPROT_XCHANGE(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * RxB
 		if(RxBuffer[0]=='\177')
 		{
 			/* Verhindern, dass "Input> " überschrieben wird */
-			if(strlen(CollectionBuffer)>0){
-				CollectionBuffer[strlen(CollectionBuffer)-1]=0;
-				strcat(TxBuffer, "\177");
-			}else{
+			if(strlen(hserialprot->CollectionBuffer)>0){
+				hserialprot->CollectionBuffer[strlen(hserialprot->CollectionBuffer)-1]=0;
+				/* korrigierte Zeilen laufen nur über den normalen Pfad */
+				hserialprot->FastPath.State = SERIALPROT_FASTPATH_NONE;
+				hserialprot->FastPath.Bsrr = 0;
+				if(!hserialprot->Quiet){
+					strcat(TxBuffer, "\177");
+				}
+			}else if(!hserialprot->Quiet){
 				strcat(TxBuffer, "\32");
 			}
 	}
@@ -265,6 +384,17 @@ void MYLIB_SERIALPROT_XCHANGE(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * RxB
 	/* Wenn Enter-Taste gedrückt */
 	if(RxBuffer[0]=='\r')
 	{
+		/* schneller Pfad: vollständig dekodiertes "gpo" sofort schalten, Prüfung und ACK folgen im normalen Pfad */
+		if(hserialprot->FastPath.Bsrr != 0 && hserialprot->FastPath.State == SERIALPROT_FASTPATH_LEVEL){
+			hserialprot->FastPath.Port->BSRR = hserialprot->FastPath.Bsrr;
+			hserialprot->FastPath.LastCycles = SERIALPROT_CYCLES() - hserialprot->FastPath.RxStamp;
+			if(hserialprot->FastPath.LastCycles > hserialprot->FastPath.MaxCycles){
+				hserialprot->FastPath.MaxCycles = hserialprot->FastPath.LastCycles;
+			}
+			hserialprot->FastPath.Count++;
+		}
+		SERIALPROT_FastPath_Reset(hserialprot);
+
 		/* Eingabe überprüfen ob Kommando-Syntax */
 		if(SERIALPROT_CheckMessage(hserialprot) == SERIALPROT_OK )
 		{
@@ -279,30 +409,290 @@ void MYLIB_SERIALPROT_XCHANGE(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * RxB
 				SERIALPROT_CreateMessage_NUMBER_TEXT(hserialprot,TxBuffer);
 			}
 
-		}else if(!strcmp(CollectionBuffer,"\r"))
+		}else if(!strcmp(hserialprot->CollectionBuffer,"\r"))
 		{
-			strcat(TxBuffer, "\n\r");
+			if(!hserialprot->Quiet){
+				strcat(TxBuffer, "\n\r");
+			}
 		}else{
-			wrong_message(TxBuffer);
+			wrong_message(hserialprot,TxBuffer,NACK_SYNTAX);
 		}
-			strcat(TxBuffer, "Input> ");
-			memset(CollectionBuffer,0,strlen(CollectionBuffer));
+			if(!hserialprot->Quiet){
+				strcat(TxBuffer, "Input> ");
+			}
+			memset(hserialprot->CollectionBuffer,0,strlen(hserialprot->CollectionBuffer));
 		}
-	}else{
+	}else if(!hserialprot->Quiet){
 		strcat(TxBuffer, "\32");
 	}
+
+	/* größte Antwortlänge merken */
+	if(strlen(TxBuffer) > hserialprot->Statistics.MaxReplySize){
+		hserialprot->Statistics.MaxReplySize = strlen(TxBuffer);
+	}
 }
 
 /**
-  * @brief  Funktion 	fügt dem TxBuffer "falsche Nachricht" hinzu
+  * @brief  Funktion 	bindet eine SERIALPROT-Instanz an eine Transportschicht, setzt den Zustand zurück und startet den Empfang
+  * @param  hserialprot SERIALPROT handle
+  * @param  htransport 	Transportschicht (z.B. UART per IT/DMA oder Loopback), über die diese Instanz empfängt und antwortet
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_Init(SERIALPROTOCOL_TypeDef *hserialprot, SERIALPROTOCOL_TransportTypeDef *htransport){
+
+	memset(hserialprot,0,sizeof(SERIALPROTOCOL_TypeDef));
+	hserialprot->Transport = htransport;
+	htransport->hserialprot = hserialprot;
+
+#if defined(__arm__)
+	/* DWT-Zyklenzähler für die Latenzmessung des schnellen Pfads (läuft frei, wird von allen Instanzen geteilt) */
+	CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL |= DWT_CTRL_CYCCNTENA_Msk;
+#endif
+
+	return htransport->Start(htransport);
+}
+
+/**
+  * @brief  Funktion 	von der Transportschicht aufzurufen, wenn Zeichen empfangen wurden: verarbeitet jedes Zeichen mit
+  * 					MYLIB_SERIALPROT_XCHANGE(), schreibt die Antworten direkt in den Füllpuffer der Sendewarteschlange
+  * 					und übergibt diesen an die Transportschicht, sobald sie frei ist
+  * @param  hserialprot SERIALPROT handle
+  * @param  pData 		empfangene Zeichen
+  * @param  Size 		Anzahl der empfangenen Zeichen
+  * @retval none
+  */
+void MYLIB_SERIALPROT_RxNotify(SERIALPROTOCOL_TypeDef *hserialprot, const uint8_t * pData, uint16_t Size){
+
+	/* Zeitpunkt des Eintreffens für die Latenzmessung des schnellen Pfads */
+	hserialprot->FastPath.RxStamp = SERIALPROT_CYCLES();
+
+	for(uint16_t i=0; i<Size; i++){
+
+		uint8_t rx[2] = {pData[i], 0};
+		uint8_t fill = hserialprot->TxFill;
+
+		/* Platz für die längste Antwort reservieren, sonst zuerst den Füllpuffer abgeben */
+		if(SERIALPROT_TxQueue_SIZE - hserialprot->TxLength[fill] <= SERIALPROT_TxBuffer_SIZE){
+			SERIALPROT_StartTransmit(hserialprot);
+			fill = hserialprot->TxFill;
+		}
+
+		if(SERIALPROT_TxQueue_SIZE - hserialprot->TxLength[fill] > SERIALPROT_TxBuffer_SIZE){
+			/* Antwort direkt hinter die bereits wartenden Antworten schreiben */
+			uint8_t * reply = &hserialprot->TxQueue[fill][hserialprot->TxLength[fill]];
+			*reply = 0;
+			MYLIB_SERIALPROT_XCHANGE(hserialprot, rx, reply);
+			hserialprot->TxLength[fill] += strlen(reply);
+
+			if(hserialprot->TxLength[fill] > hserialprot->Statistics.PeakTxDepth){
+				hserialprot->Statistics.PeakTxDepth = hserialprot->TxLength[fill];
+			}
+		}else{
+			/* beide Puffer belegt: Zeichen trotzdem verarbeiten, die Antwort wird verworfen */
+			uint8_t discard[SERIALPROT_TxBuffer_SIZE] = {0};
+			MYLIB_SERIALPROT_XCHANGE(hserialprot, rx, discard);
+			hserialprot->Statistics.TxDropped++;
+		}
+	}
+
+	SERIALPROT_StartTransmit(hserialprot);
+}
+
+/**
+  * @brief  Funktion 	von der Transportschicht aufzurufen, wenn der übergebene Sendepuffer vollständig gesendet wurde
+  * @param  hserialprot SERIALPROT handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_TxComplete(SERIALPROTOCOL_TypeDef *hserialprot){
+
+	uint8_t sent = hserialprot->TxFill ^ 1U;
+
+	hserialprot->TxLength[sent] = 0;
+	hserialprot->TxBusy = 0;
+	SERIALPROT_StartTransmit(hserialprot);
+}
+
+/**
+  * @brief  Funktion 	von der Transportschicht bei einem Zeichenfehler aufzurufen: die angefangene Eingabe ist unbrauchbar und wird verworfen
+  * @param  hserialprot SERIALPROT handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_RxAbort(SERIALPROTOCOL_TypeDef *hserialprot){
+
+	memset(hserialprot->CollectionBuffer,0,sizeof(hserialprot->CollectionBuffer));
+	SERIALPROT_FastPath_Reset(hserialprot);
+}
+
+/**
+  * @brief  Funktion 	schreibt eine asynchrone Meldung "=> #e,<Event>" (z.B. das Ergebnis einer I2C-Übertragung) in die Sendewarteschlange
+  * @note   Darf nur aus einem Interrupt mit der NVIC-Priorität der Transportschicht aufgerufen werden (wie RxNotify() und TxComplete())
+  * @param  hserialprot SERIALPROT handle
+  * @param  Event 		nullterminierter Text der Meldung
+  * @retval HAL status (HAL_BUSY, wenn die Meldung verworfen wurde, weil danach kein Platz für eine Antwort bliebe)
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_Event(SERIALPROTOCOL_TypeDef *hserialprot, const uint8_t * Event){
+
+	HAL_StatusTypeDef status = HAL_OK;
+	uint16_t size = strlen(NEW_LINE "=> #e,") + strlen(Event) + strlen(NEW_LINE);
+	uint8_t fill = hserialprot->TxFill;
+
+	/* Platz für die Meldung und danach noch für eine Antwort (SERIALPROT_TxBuffer_SIZE) reservieren,
+	 * sonst zuerst den Füllpuffer abgeben; ein Datenstrom kann so die Antworten nie verdrängen */
+	if(SERIALPROT_TxQueue_SIZE - hserialprot->TxLength[fill] <= size + SERIALPROT_TxBuffer_SIZE){
+		SERIALPROT_StartTransmit(hserialprot);
+		fill = hserialprot->TxFill;
+	}
+
+	if(SERIALPROT_TxQueue_SIZE - hserialprot->TxLength[fill] > size + SERIALPROT_TxBuffer_SIZE){
+		uint8_t * reply = &hserialprot->TxQueue[fill][hserialprot->TxLength[fill]];
+		*reply = 0;
+		strcat(reply, NEW_LINE);
+		strcat(reply, "=> #e,");
+		strcat(reply, Event);
+		strcat(reply, NEW_LINE);
+		hserialprot->TxLength[fill] += size;
+
+		if(hserialprot->TxLength[fill] > hserialprot->Statistics.PeakTxDepth){
+			hserialprot->Statistics.PeakTxDepth = hserialprot->TxLength[fill];
+		}
+	}else{
+		hserialprot->Statistics.TxDropped++;
+		status = HAL_BUSY;
+	}
+
+	SERIALPROT_StartTransmit(hserialprot);
+	return status;
+}
+
+/**
+  * @brief  Funktion 	dekodiert ein Zeichen der laufenden Zeile für den schnellen "gpo"-Pfad
+  * 					("#gpo," -> Pin-Name bis ':' -> "on"/"off"), beim ':' wird der Pin aufgelöst
+  * @param  hserialprot SERIALPROT handle
+  * @param  Character 	empfangenes Zeichen (ohne '\r' und Backspace)
+  * @retval none
+  */
+static void SERIALPROT_FastPath_Decode(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Character){
+
+	static const char prefix[] = "#gpo,";
+	SERIALPROTOCOL_FastPathTypeDef *fast = &hserialprot->FastPath;
+
+	switch(fast->State){
+	case SERIALPROT_FASTPATH_PREFIX:
+		if(Character == prefix[fast->Index]){
+			if(++fast->Index == strlen(prefix)){
+				fast->State = SERIALPROT_FASTPATH_NAME;
+				fast->Index = 0;
+			}
+		}else{
+			fast->State = SERIALPROT_FASTPATH_NONE;
+		}
+		break;
+
+	case SERIALPROT_FASTPATH_NAME:
+		if(Character == ':' && fast->Index > 0){
+			fast->Name[fast->Index] = 0;
+			fast->Index = 0;
+			/* Pin einmal auflösen, danach bleibt für das '\r' nur der BSRR-Zugriff */
+			if(SERIALPROT_FastPath_Resolve_Callback(hserialprot, fast->Name, &fast->Port, &fast->BsrrOn, &fast->BsrrOff) == 0){
+				fast->State = SERIALPROT_FASTPATH_LEVEL;
+			}else{
+				fast->State = SERIALPROT_FASTPATH_NONE;
+			}
+		}else if(isalpha(Character) && fast->Index < SERIALPROT_FastPath_NAME_SIZE){
+			fast->Name[fast->Index++] = Character;
+		}else{
+			fast->State = SERIALPROT_FASTPATH_NONE;
+		}
+		break;
+
+	case SERIALPROT_FASTPATH_LEVEL:
+		/* Index: 0 = Anfang, 1 = "o", 2 = "on", 3 = "of", 4 = "off" */
+		if(fast->Index == 0 && Character == 'o'){
+			fast->Index = 1;
+		}else if(fast->Index == 1 && Character == 'n'){
+			fast->Index = 2;
+			fast->Bsrr = fast->BsrrOn;
+		}else if(fast->Index == 1 && Character == 'f'){
+			fast->Index = 3;
+		}else if(fast->Index == 3 && Character == 'f'){
+			fast->Index = 4;
+			fast->Bsrr = fast->BsrrOff;
+		}else{
+			fast->State = SERIALPROT_FASTPATH_NONE;
+			fast->Bsrr = 0;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+/**
+  * @brief  Funktion 	setzt die Dekodierung des schnellen Pfads für die nächste Zeile zurück (Messwerte bleiben erhalten)
+  * @param  hserialprot SERIALPROT handle
+  * @retval none
+  */
+static void SERIALPROT_FastPath_Reset(SERIALPROTOCOL_TypeDef *hserialprot){
+
+	hserialprot->FastPath.State = SERIALPROT_FASTPATH_PREFIX;
+	hserialprot->FastPath.Index = 0;
+	hserialprot->FastPath.Bsrr = 0;
+}
+
+/**
+  * @brief  Funktion 	übergibt den Füllpuffer der Sendewarteschlange (ohne Kopie) an die Transportschicht, falls diese frei ist,
+  * 					und schreibt weitere Antworten in den zweiten Puffer
+  * @param  hserialprot SERIALPROT handle
+  * @retval none
+  */
+static void SERIALPROT_StartTransmit(SERIALPROTOCOL_TypeDef *hserialprot){
+
+	uint8_t fill = hserialprot->TxFill;
+
+	/* Instanz ohne Transportschicht (intern bei Modbus, Skript und Makro): gesammelte Meldungen verwerfen */
+	if(hserialprot->Transport == NULL){
+		hserialprot->TxLength[fill] = 0;
+		return;
+	}
+
+	if(hserialprot->TxBusy || hserialprot->TxLength[fill] == 0){
+		return;
+	}
+
+	hserialprot->TxBusy = 1;
+	hserialprot->TxFill = fill ^ 1U;
+	hserialprot->Statistics.TxBytes += hserialprot->TxLength[fill];
+
+	if(hserialprot->Transport->Transmit(hserialprot->Transport, hserialprot->TxQueue[fill], hserialprot->TxLength[fill]) != HAL_OK){
+		/* Block verwerfen, damit die Verbindung nicht stehen bleibt */
+		hserialprot->ErrorCounter.TxErrors++;
+		hserialprot->TxLength[fill] = 0;
+		hserialprot->TxBusy = 0;
+	}
+}
+
+/**
+  * @brief  Funktion 	fügt dem TxBuffer "falsche Nachricht" hinzu und zählt den Grund
+  * @param  hserialprot SERIALPROT handle
   * @param  TxBuffer 	Sendepuffer/Antwortpuffer
+  * @param  reason 		Grund der falschen Nachricht
   * @retval none
   */
-static void wrong_message(uint8_t * TxBuffer){
+static void wrong_message(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer, SERIALPROTOCOL_NackTypeDef reason){
+
+	if(reason == NACK_SYNTAX){
+		hserialprot->Statistics.NackSyntax++;
+	}else if(reason == NACK_COMMAND){
+		hserialprot->Statistics.NackCommand++;
+	}else{
+		hserialprot->Statistics.NackParameter++;
+	}
 
 	strcat(TxBuffer, "\n\r");
 	strcat(TxBuffer, "STM32-NACK -> ");
-	strcat(TxBuffer, CollectionBuffer);
+	strcat(TxBuffer, hserialprot->CollectionBuffer);
 	strcat(TxBuffer, "\n\r");
 }
 
@@ -323,8 +713,14 @@ static void SERIALPROT_CreateMessage_NUMBER_NUMBER(SERIALPROTOCOL_TypeDef *hseri
 	/* Überprüfen ob Kommando "asc" */
 	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"asc")){
 			SERIALPROT_COMMAND_ASC(hserialprot,TxBuffer);
+	/* Überprüfen ob Kommando "sta" */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sta")){
+			SERIALPROT_COMMAND_STA(hserialprot,TxBuffer);
+	/* Überprüfen ob Kommando "lat" */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"lat")){
+			SERIALPROT_COMMAND_LAT(hserialprot,TxBuffer);
 	}else{
-		wrong_message(TxBuffer);
+		SERIALPROT_COMMAND_USER(hserialprot,TxBuffer);
 	}
 }
 
@@ -339,7 +735,7 @@ static void SERIALPROT_CreateMessage_TEXT_TEXT( SERIALPROTOCOL_TypeDef *hserialp
 	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"gpo")){
 		SERIALPROT_COMMAND_GPO(hserialprot,TxBuffer);
 	}else{
-		wrong_message(TxBuffer);
+		SERIALPROT_COMMAND_USER(hserialprot,TxBuffer);
 	}
 }
 
@@ -354,7 +750,7 @@ static void SERIALPROT_CreateMessage_TEXT_NUMBER(SERIALPROTOCOL_TypeDef *hserial
 	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"asc")){
 			SERIALPROT_COMMAND_ASC(hserialprot,TxBuffer);
 	}else{
-		wrong_message(TxBuffer);
+		SERIALPROT_COMMAND_USER(hserialprot,TxBuffer);
 	}
 }
 
@@ -366,11 +762,11 @@ static void SERIALPROT_CreateMessage_TEXT_NUMBER(SERIALPROTOCOL_TypeDef *hserial
   */
 static void SERIALPROT_CreateMessage_NUMBER_TEXT(SERIALPROTOCOL_TypeDef *hserialprot,uint8_t * TxBuffer ){
 
-	/* kein Kommando definiert */
+	/* kein Kommando der Bibliothek definiert */
 	if(0){
 
 	}else{
-		wrong_message(TxBuffer);
+		SERIALPROT_COMMAND_USER(hserialprot,TxBuffer);
 	}
 }
 
@@ -383,12 +779,13 @@ static void SERIALPROT_CreateMessage_NUMBER_TEXT(SERIALPROTOCOL_TypeDef *hserial
 static void SERIALPROT_COMMAND_GPO(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer ){
 	/* Erzeugen der Ausgangsnachricht falls Rückgabewerde der Callback 0 ist */
 	if (!SERIALPROT_Command_GPO_Callback(hserialprot)){
+		hserialprot->Statistics.FramesAccepted++;
 		strcat(TxBuffer, NEW_LINE);
 		strcat(TxBuffer, STM32_ACK);
-		strcat(TxBuffer, CollectionBuffer);
+		strcat(TxBuffer, hserialprot->CollectionBuffer);
 		strcat(TxBuffer, NEW_LINE);
 	}else{
-		wrong_message(TxBuffer);
+		wrong_message(hserialprot,TxBuffer,NACK_PARAMETER);
 	}
 }
 
@@ -407,6 +804,114 @@ __weak uint8_t SERIALPROT_Command_GPO_Callback(SERIALPROTOCOL_TypeDef *hserialpr
 	 */
 }
 
+/**
+  * @brief  Funktion 	übergibt ein in der Bibliothek nicht definiertes Kommando an "SERIALPROT_Command_User_Callback" und erzeugt dementsprechend die Antwort im TxBuffer
+  * @param  hserialprot SERIALPROT handle
+  * @param  TxBuffer 	Sendepuffer/Antwortpuffer
+  * @retval none
+  */
+static void SERIALPROT_COMMAND_USER(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer ){
+
+	uint8_t result[SERIALPROT_Result_SIZE]={0};
+	uint8_t status = SERIALPROT_Command_User_Callback(hserialprot, result);
+
+	if(status == SERIALPROT_COMMAND_OK){
+		hserialprot->Statistics.FramesAccepted++;
+		strcat(TxBuffer, NEW_LINE);
+		strcat(TxBuffer, STM32_ACK);
+		strcat(TxBuffer, hserialprot->CollectionBuffer);
+		/* Ergebnis nur anhängen, wenn die Callback eines geliefert hat */
+		if(result[0] != 0){
+			TxBuffer[strlen(TxBuffer)-1]=0;
+			strcat(TxBuffer," => " );
+			strcat(TxBuffer, "#a,");
+			strncat(TxBuffer, result, SERIALPROT_Result_SIZE-1);
+		}
+		strcat(TxBuffer, NEW_LINE);
+	}else if(status == SERIALPROT_COMMAND_INVALID){
+		wrong_message(hserialprot,TxBuffer,NACK_PARAMETER);
+	}else{
+		wrong_message(hserialprot,TxBuffer,NACK_COMMAND);
+	}
+}
+
+/**
+  * @brief  Funktion 	Callback für zusätzliche Kommandos der Anwendung (z.B. I2C-Bridge), wird für jedes in der Bibliothek
+  * 					nicht definierte Kommando aufgerufen
+  * @param  hserialprot SERIALPROT handle
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen), wird als "=> #a,<Result>" an das ACK angehängt, wenn nicht leer
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+__weak uint8_t SERIALPROT_Command_User_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result)
+{
+	/* Prevent unused argument(s) compilation warning */
+	UNUSED(hserialprot);
+	UNUSED(Result);
+
+	/* NOTE : This function should not be modified, when the callback is needed,
+            	the SERIALPROT_Command_User_Callback could be implemented in the user file
+	 */
+	return SERIALPROT_COMMAND_UNKNOWN;
+}
+
+/**
+  * @brief  Funktion 	Callback für jede mit "rdm" erzeugte Zufallszahl (z.B. für eine Statistik der Zufallszahlen)
+  * @param  hserialprot SERIALPROT handle
+  * @param  Value 		Zufallszahl
+  * @retval none
+  */
+__weak void SERIALPROT_Random_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint16_t Value)
+{
+	/* Prevent unused argument(s) compilation warning */
+	UNUSED(hserialprot);
+	UNUSED(Value);
+
+	/* NOTE : This function should not be modified, when the callback is needed,
+            	the SERIALPROT_Random_Callback could be implemented in the user file
+	 */
+}
+
+/**
+  * @brief  Funktion 	Callback für jedes empfangene Zeichen, vor der Verarbeitung (z.B. für eine Aufzeichnung des Empfangs)
+  * @param  hserialprot SERIALPROT handle
+  * @param  Byte 		empfangenes Zeichen
+  * @retval none
+  */
+__weak void SERIALPROT_RxByte_Callback(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t Byte)
+{
+	/* Prevent unused argument(s) compilation warning */
+	UNUSED(hserialprot);
+	UNUSED(Byte);
+
+	/* NOTE : This function should not be modified, when the callback is needed,
+            	the SERIALPROT_RxByte_Callback could be implemented in the user file
+	 */
+}
+
+/**
+  * @brief  Funktion 	löst den Pin-Namen eines "gpo"-Kommandos für den schnellen Pfad auf, wird beim ':' noch vor dem '\r' aufgerufen
+  * @param  hserialprot SERIALPROT handle
+  * @param  Name 		Pin-Name (nur Buchstaben, max. SERIALPROT_FastPath_NAME_SIZE Zeichen)
+  * @param  Port 		Rückgabe: Port des Pins
+  * @param  BsrrOn 		Rückgabe: BSRR-Wert für "on"
+  * @param  BsrrOff 	Rückgabe: BSRR-Wert für "off"
+  * @retval 0 = Pin über den schnellen Pfad schalten, 1 = nur normaler Pfad
+  */
+__weak uint8_t SERIALPROT_FastPath_Resolve_Callback(SERIALPROTOCOL_TypeDef *hserialprot, const uint8_t * Name, GPIO_TypeDef ** Port, uint32_t * BsrrOn, uint32_t * BsrrOff)
+{
+	/* Prevent unused argument(s) compilation warning */
+	UNUSED(hserialprot);
+	UNUSED(Name);
+	UNUSED(Port);
+	UNUSED(BsrrOn);
+	UNUSED(BsrrOff);
+
+	/* NOTE : This function should not be modified, when the callback is needed,
+            	the SERIALPROT_FastPath_Resolve_Callback could be implemented in the user file
+	 */
+	return 1;
+}
+
 /**
   * @brief  Funktion 	Überprüft die Eingabeparameter 1 und 2 des Kommandos für die Zuffalszahl und erzeugt dementsprechend die Antwort im TxBuffer
   * @param  hserialprot SERIALPROT handle
@@ -417,18 +922,20 @@ static void SERIALPROT_COMMAND_RDM(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t
 
 	/* Überprüfen ob Parameter1 kleiner als Parameter2 und erzeugen der Ausgangsnachricht */
 	if(atoi(hserialprot->Parameter1)<atoi(hserialprot->Parameter2)){
+		hserialprot->Statistics.FramesAccepted++;
 		strcat(TxBuffer, NEW_LINE);
 		strcat(TxBuffer, STM32_ACK);
-		strcat(TxBuffer, CollectionBuffer);
+		strcat(TxBuffer, hserialprot->CollectionBuffer);
 		TxBuffer[strlen(TxBuffer)-1]=0;
 		strcat(TxBuffer," => " );
 		uint16_t result[20]={0};
 		random_number(hserialprot->Parameter1, hserialprot->Parameter2, result);
+		SERIALPROT_Random_Callback(hserialprot, atoi((char *)result));
 		strcat(TxBuffer, "#a,");
 		strcat(TxBuffer, result);
 		strcat(TxBuffer, NEW_LINE);
 	}else{
-		wrong_message(TxBuffer);
+		wrong_message(hserialprot,TxBuffer,NACK_PARAMETER);
 	}
 }
 
@@ -441,9 +948,10 @@ static void SERIALPROT_COMMAND_RDM(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t
 static void SERIALPROT_COMMAND_ADD(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer ){
 
 	/* Erzeugen der Ausgangsnachricht */
+	hserialprot->Statistics.FramesAccepted++;
 	strcat(TxBuffer, NEW_LINE);
 	strcat(TxBuffer, STM32_ACK);
-	strcat(TxBuffer, CollectionBuffer);
+	strcat(TxBuffer, hserialprot->CollectionBuffer);
 	TxBuffer[strlen(TxBuffer)-1]=0;
 	strcat(TxBuffer," => " );
 	uint16_t result[20]={0};
@@ -463,9 +971,10 @@ static void SERIALPROT_COMMAND_ASC(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t
 
 	/* Überprüfen ob Parameter1 ein Zeichen enthält und Parameter2 null ist und erzeugen der Ausgangsnachricht */
 	if(strlen(hserialprot->Parameter1) ==1 && atoi(hserialprot->Parameter2)==0){
+		hserialprot->Statistics.FramesAccepted++;
 		strcat(TxBuffer, NEW_LINE);
 		strcat(TxBuffer, STM32_ACK);
-		strcat(TxBuffer, CollectionBuffer);
+		strcat(TxBuffer, hserialprot->CollectionBuffer);
 		TxBuffer[strlen(TxBuffer)-1]=0;
 		strcat(TxBuffer," => " );
 		uint8_t result[20]={0};
@@ -474,7 +983,91 @@ static void SERIALPROT_COMMAND_ASC(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t
 		strcat(TxBuffer,result);
 		strcat(TxBuffer, NEW_LINE);
 	}else{
-		wrong_message(TxBuffer);
+		wrong_message(hserialprot,TxBuffer,NACK_PARAMETER);
+	}
+}
+
+/**
+  * @brief  Funktion 	gibt die Statistikzähler der Verbindung als Datensatz fester Länge im TxBuffer zurück
+  * 					(Reihenfolge siehe SERIALPROTOCOL_StatisticsTypeDef, je Zähler 8 Hex-Stellen ohne Trennzeichen)
+  * @param  hserialprot SERIALPROT handle
+  * @param  TxBuffer 	Sendepuffer/Antwortpuffer
+  * @retval none
+  */
+static void SERIALPROT_COMMAND_STA(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer ){
+
+	/* Überprüfen ob Parameter1 0 ist und Parameter2 0 (lesen) oder 1 (lesen und zurücksetzen) ist */
+	if(atoi(hserialprot->Parameter1)==0 && atoi(hserialprot->Parameter2)<=1){
+		hserialprot->Statistics.FramesAccepted++;
+		hserialprot->Statistics.UartErrors = hserialprot->ErrorCounter.OverrunErrors + hserialprot->ErrorCounter.FramingErrors
+											+ hserialprot->ErrorCounter.NoiseErrors + hserialprot->ErrorCounter.ParityErrors;
+		hserialprot->Statistics.TxErrors = hserialprot->ErrorCounter.TxErrors;
+
+		strcat(TxBuffer, NEW_LINE);
+		strcat(TxBuffer, STM32_ACK);
+		strcat(TxBuffer, hserialprot->CollectionBuffer);
+		TxBuffer[strlen(TxBuffer)-1]=0;
+		strcat(TxBuffer," => " );
+		strcat(TxBuffer, "#a,");
+
+		/* alle Zähler der Reihe nach mit fester Breite anhängen */
+		uint32_t * counter = (uint32_t *)&hserialprot->Statistics;
+		uint8_t * result = TxBuffer + strlen(TxBuffer);
+		for(uint8_t i=0; i<sizeof(SERIALPROTOCOL_StatisticsTypeDef)/sizeof(uint32_t); i++){
+			hex32(counter[i], result);
+			result+=8;
+		}
+		*result=0;
+		strcat(TxBuffer, NEW_LINE);
+
+		/* Zähler zurücksetzen */
+		if(atoi(hserialprot->Parameter2)==1){
+			memset(&hserialprot->Statistics,0,sizeof(SERIALPROTOCOL_StatisticsTypeDef));
+			memset(&hserialprot->ErrorCounter,0,sizeof(SERIALPROTOCOL_ErrorCounterTypeDef));
+		}
+	}else{
+		wrong_message(hserialprot,TxBuffer,NACK_PARAMETER);
+	}
+}
+
+/**
+  * @brief  Funktion 	gibt die gemessene Latenz des schnellen "gpo"-Pfads (Eintreffen des '\r' bis BSRR-Zugriff) im TxBuffer zurück
+  * @param  hserialprot SERIALPROT handle
+  * @param  TxBuffer 	Sendepuffer/Antwortpuffer
+  * @retval none
+  */
+static void SERIALPROT_COMMAND_LAT(SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * TxBuffer ){
+
+	/* Überprüfen ob Parameter1 0 ist und Parameter2 0 (lesen) oder 1 (lesen und zurücksetzen) ist */
+	if(atoi(hserialprot->Parameter1)==0 && atoi(hserialprot->Parameter2)<=1){
+		hserialprot->Statistics.FramesAccepted++;
+		strcat(TxBuffer, NEW_LINE);
+		strcat(TxBuffer, STM32_ACK);
+		strcat(TxBuffer, hserialprot->CollectionBuffer);
+		TxBuffer[strlen(TxBuffer)-1]=0;
+		strcat(TxBuffer," => " );
+		strcat(TxBuffer, "#a,");
+
+		/* Zyklen in ns umrechnen */
+		uint8_t result[12]={0};
+		dec32(hserialprot->FastPath.Count, result);
+		strcat(TxBuffer, result);
+		strcat(TxBuffer, ",");
+		dec32(SERIALPROT_CYCLES_TO_NS(hserialprot->FastPath.LastCycles), result);
+		strcat(TxBuffer, result);
+		strcat(TxBuffer, ",");
+		dec32(SERIALPROT_CYCLES_TO_NS(hserialprot->FastPath.MaxCycles), result);
+		strcat(TxBuffer, result);
+		strcat(TxBuffer, NEW_LINE);
+
+		/* Messung zurücksetzen */
+		if(atoi(hserialprot->Parameter2)==1){
+			hserialprot->FastPath.Count = 0;
+			hserialprot->FastPath.LastCycles = 0;
+			hserialprot->FastPath.MaxCycles = 0;
+		}
+	}else{
+		wrong_message(hserialprot,TxBuffer,NACK_PARAMETER);
 	}
 }
 
@@ -487,7 +1080,7 @@ static SERIALPROTCOL_StatusTypeDef SERIALPROT_CheckMessage(SERIALPROTOCOL_TypeDe
 {
 
 	uint8_t inputmessage[40] = {0};
-	strcat(inputmessage, CollectionBuffer);
+	strcat(inputmessage, hserialprot->CollectionBuffer);
 
 	uint8_t  pos_command_start = strcspn( inputmessage, "#" );
 	uint8_t  pos_command_split = strcspn( inputmessage, "," );
@@ -516,7 +1109,7 @@ static SERIALPROTCOL_StatusTypeDef SERIALPROT_CheckMessage(SERIALPROTOCOL_TypeDe
 		uint8_t sd = strlen(command_name);
 		uint8_t sdd = strlen(command_param1);
 		uint8_t sdf = strlen(command_param2);
-		if(strlen(command_name)<=3 && strlen(command_param1)<=4 && strlen(command_param2)<=4){
+		if(strlen(command_name)<=3 && strlen(command_param1)<=SERIALPROT_PARAM_SIZE && strlen(command_param2)<=SERIALPROT_PARAM_SIZE){
 
 			strcpy(hserialprot->CommandName, command_name);
 			strcpy(hserialprot->Parameter1, command_param1);
@@ -0,0 +1,335 @@
+/**
+******************************************************************************
+* @file mylib_serialprot_i2c.c
+* @author Reiter Roman
+* @brief mylib-Serielles Protokoll, I2C-Slave-Transportschicht.
+* Diese Datei stellt die Kommandos des seriellen Protokolls über die Transportschnittstelle als I2C-Slave zur Verfügung:
+* + Registerschnittstelle STATUS/DATA/CMD, damit mehrere Boards an einem Bus von einem Master bedient werden können
+* + Übertragung per Interrupt mit HAL_I2C_EnableListen_IT() und HAL_I2C_Slave_Seq_Receive_IT()/HAL_I2C_Slave_Seq_Transmit_IT()
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Hardware
+		(+) I2C3: PA7 (SCL), PB4 (SDA), Open-Drain mit Pull-Up, EV- und ER-Interrupt mit derselben NVIC-Priorität
+			wie die übrigen Transportschichten. Die Slave-Adresse ist hi2c->Init.OwnAddress1 (je Board unterschiedlich).
+
+	(#) Initialisierung
+		(+++) z.B.: MYLIB_SERIALPROT_I2C_Init(&hseriali2c3, &hi2c3);
+		(+++) z.B.: MYLIB_SERIALPROT_Init(&hserialprot4, &hseriali2c3.Transport);
+		(+++) z.B.: hserialprot4.Quiet = 1;
+
+	(#) Die HAL-Callbacks werden an die Transportschicht weitergeleitet:
+		(+++) HAL_I2C_AddrCallback ()        -> MYLIB_SERIALPROT_I2C_AddrCallback(hi2c, TransferDirection, AddrMatchCode)
+		(+++) HAL_I2C_SlaveRxCpltCallback () -> MYLIB_SERIALPROT_I2C_SlaveRxCpltCallback(hi2c)
+		(+++) HAL_I2C_SlaveTxCpltCallback () -> MYLIB_SERIALPROT_I2C_SlaveTxCpltCallback(hi2c)
+		(+++) HAL_I2C_ListenCpltCallback ()  -> MYLIB_SERIALPROT_I2C_ListenCpltCallback(hi2c)
+		(+++) HAL_I2C_ErrorCallback ()       -> MYLIB_SERIALPROT_I2C_ErrorCallback(hi2c)
+
+	(#) Ablauf für den Master
+		(+) Kommando senden:   START, Adresse+W, 0x02 (CMD), "#gpo,rt:on\r", STOP
+		(+) Länge abfragen:    START, Adresse+W, 0x00 (STATUS), RESTART, Adresse+R, 2 Byte lesen (LSB zuerst), STOP
+		(+) Antwort abholen:   START, Adresse+W, 0x01 (DATA), RESTART, Adresse+R, genau die gemeldete Anzahl lesen, STOP
+		(+) STATUS so lange wiederholen, bis 0 gemeldet wird (eine Antwort kann auf zwei Sendepuffer verteilt sein).
+		(+) Das Register bleibt bis zum nächsten Schreiben ausgewählt, STATUS und DATA können daher wiederholt gelesen werden.
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_serialprot_i2c.h"
+#include "string.h"
+
+/* Private define ------------------------------------------------------------*/
+/** @addtogroup SERIALPROT_I2C_Private_Define
+  * @{
+  */
+#define SERIALPROT_I2C_QUEUED_FILL 0x00			/*!< Füllzeichen übergeben */
+#define SERIALPROT_I2C_QUEUED_DATA 0x01			/*!< Antwortzeichen übergeben */
+#define SERIALPROT_I2C_QUEUED_STATUS 0x02		/*!< Zeichen von STATUS übergeben */
+/**
+  * @}
+  */
+
+/* Private variables ---------------------------------------------------------*/
+/** @addtogroup SERIALPROT_I2C_Private_Variables
+  * @{
+  */
+
+/* gebundene I2C, Zuordnung I2C -> SERIALPROT_I2C handle für die HAL-Callbacks */
+static SERIALPROT_I2C_TypeDef * SERIALPROT_I2C_Instances[SERIALPROT_I2C_MAX_INSTANCES];
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SERIALPROT_I2C_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef SERIALPROT_I2C_Start(SERIALPROTOCOL_TransportTypeDef *htransport);
+static HAL_StatusTypeDef SERIALPROT_I2C_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size);
+static void SERIALPROT_I2C_TransmitNext(SERIALPROT_I2C_TypeDef *hseriali2c, uint32_t XferOptions);
+static void SERIALPROT_I2C_Listen(SERIALPROT_I2C_TypeDef *hseriali2c);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	initialisiert die I2C-Transportschicht und trägt sie für die HAL-Callbacks ein
+  * @param  hseriali2c 	SERIALPROT_I2C handle
+  * @param  hi2c 		I2C handle (bereits mit HAL_I2C_Init() als Slave initialisiert)
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_I2C_Init(SERIALPROT_I2C_TypeDef *hseriali2c, I2C_HandleTypeDef *hi2c){
+
+	uint8_t free_slot = SERIALPROT_I2C_MAX_INSTANCES;
+
+	for(uint8_t i=0; i<SERIALPROT_I2C_MAX_INSTANCES; i++){
+		if(SERIALPROT_I2C_Instances[i] == hseriali2c){
+			free_slot = i;
+			break;
+		}
+		if(SERIALPROT_I2C_Instances[i] == NULL && free_slot == SERIALPROT_I2C_MAX_INSTANCES){
+			free_slot = i;
+		}
+	}
+	if(free_slot == SERIALPROT_I2C_MAX_INSTANCES){
+		return HAL_ERROR;
+	}
+
+	memset(hseriali2c,0,sizeof(SERIALPROT_I2C_TypeDef));
+	hseriali2c->Transport.Start = SERIALPROT_I2C_Start;
+	hseriali2c->Transport.Transmit = SERIALPROT_I2C_Transmit;
+	hseriali2c->hi2c = hi2c;
+	hseriali2c->Register = SERIALPROT_I2C_REG_STATUS;
+	SERIALPROT_I2C_Instances[free_slot] = hseriali2c;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	liefert den an den I2C gebundenen SERIALPROT_I2C handle
+  * @param  hi2c 		I2C handle
+  * @retval SERIALPROT_I2C handle oder NULL, falls keine Transportschicht gebunden ist
+  */
+SERIALPROT_I2C_TypeDef * MYLIB_SERIALPROT_I2C_GetInstance(I2C_HandleTypeDef *hi2c){
+
+	for(uint8_t i=0; i<SERIALPROT_I2C_MAX_INSTANCES; i++){
+		if(SERIALPROT_I2C_Instances[i] != NULL && SERIALPROT_I2C_Instances[i]->hi2c == hi2c){
+			return SERIALPROT_I2C_Instances[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: auf die eigene Adresse hören (von MYLIB_SERIALPROT_Init() aufgerufen)
+  * @param  htransport 	Transportschicht
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_I2C_Start(SERIALPROTOCOL_TransportTypeDef *htransport){
+
+	SERIALPROT_I2C_TypeDef *hseriali2c = (SERIALPROT_I2C_TypeDef *)htransport;
+
+	return HAL_I2C_EnableListen_IT(hseriali2c->hi2c);
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Sendepuffer des Protokolls ohne Kopie zum Abholen über das Register DATA bereitstellen
+  * @param  htransport 	Transportschicht
+  * @param  pData 		Sendepuffer, bleibt bis zum Abholen des letzten Zeichens unverändert
+  * @param  Size 		Anzahl der Zeichen
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_I2C_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size){
+
+	SERIALPROT_I2C_TypeDef *hseriali2c = (SERIALPROT_I2C_TypeDef *)htransport;
+
+	if(hseriali2c->pTxData != NULL){
+		return HAL_BUSY;
+	}
+
+	hseriali2c->TxPos = 0;
+	hseriali2c->TxSize = Size;
+	hseriali2c->pTxData = pData;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_AddrCallback aufzurufen: beginnt eine Schreib- oder Leseübertragung des Masters
+  * @param  hi2c 		I2C handle
+  * @param  TransferDirection I2C_DIRECTION_TRANSMIT (Master schreibt) oder I2C_DIRECTION_RECEIVE (Master liest)
+  * @param  AddrMatchCode angesprochene Adresse
+  * @retval none
+  */
+void MYLIB_SERIALPROT_I2C_AddrCallback(I2C_HandleTypeDef *hi2c, uint8_t TransferDirection, uint16_t AddrMatchCode){
+
+	SERIALPROT_I2C_TypeDef *hseriali2c = MYLIB_SERIALPROT_I2C_GetInstance(hi2c);
+	(void)AddrMatchCode;
+
+	if(hseriali2c == NULL){
+		return;
+	}
+
+	if(TransferDirection == I2C_DIRECTION_TRANSMIT){
+		/* Master schreibt: zuerst die Registeradresse */
+		hseriali2c->RegisterPending = 1;
+		HAL_I2C_Slave_Seq_Receive_IT(hi2c, &hseriali2c->RxByte, 1, I2C_FIRST_FRAME);
+	}else{
+		/* Master liest: Abbild von STATUS für diese Übertragung festhalten */
+		uint16_t pending = (hseriali2c->pTxData != NULL) ? (hseriali2c->TxSize - hseriali2c->TxPos) : 0;
+		hseriali2c->Status[0] = (uint8_t)(pending & 0xFF);
+		hseriali2c->Status[1] = (uint8_t)(pending >> 8);
+		hseriali2c->StatusPos = 0;
+		SERIALPROT_I2C_TransmitNext(hseriali2c, I2C_FIRST_FRAME);
+	}
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_SlaveRxCpltCallback aufzurufen: Registeradresse übernehmen bzw. Kommandozeichen an das Protokoll melden
+  * @param  hi2c 		I2C handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_I2C_SlaveRxCpltCallback(I2C_HandleTypeDef *hi2c){
+
+	SERIALPROT_I2C_TypeDef *hseriali2c = MYLIB_SERIALPROT_I2C_GetInstance(hi2c);
+	if(hseriali2c == NULL){
+		return;
+	}
+
+	if(hseriali2c->RegisterPending){
+		hseriali2c->Register = hseriali2c->RxByte;
+		hseriali2c->RegisterPending = 0;
+	}else if(hseriali2c->Register == SERIALPROT_I2C_REG_CMD){
+		MYLIB_SERIALPROT_RxNotify(hseriali2c->Transport.hserialprot, &hseriali2c->RxByte, 1);
+	}
+
+	/* Zeichen in andere Register werden verworfen */
+	HAL_I2C_Slave_Seq_Receive_IT(hi2c, &hseriali2c->RxByte, 1, I2C_NEXT_FRAME);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_SlaveTxCpltCallback aufzurufen: das übergebene Zeichen wird gerade gesendet,
+  * 					das nächste Zeichen bereitstellen
+  * @param  hi2c 		I2C handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_I2C_SlaveTxCpltCallback(I2C_HandleTypeDef *hi2c){
+
+	SERIALPROT_I2C_TypeDef *hseriali2c = MYLIB_SERIALPROT_I2C_GetInstance(hi2c);
+	if(hseriali2c == NULL){
+		return;
+	}
+
+	/* Ohne TXIS stammt der Aufruf vom NACK des Masters: das Zeichen wurde aus TXDR verworfen, die Leseübertragung ist beendet */
+	if(__HAL_I2C_GET_FLAG(hi2c, I2C_FLAG_TXIS) == RESET){
+		HAL_I2C_Slave_Seq_Transmit_IT(hi2c, &hseriali2c->FillByte, 1, I2C_NEXT_FRAME);
+		return;
+	}
+
+	if(hseriali2c->TxQueued == SERIALPROT_I2C_QUEUED_STATUS){
+		hseriali2c->StatusPos++;
+	}else if(hseriali2c->TxQueued == SERIALPROT_I2C_QUEUED_DATA){
+		hseriali2c->TxPos++;
+
+		/* letztes Zeichen ist im Schieberegister: Puffer an das Protokoll zurückgeben, es stellt ggf. den zweiten bereit */
+		if(hseriali2c->TxPos >= hseriali2c->TxSize){
+			hseriali2c->pTxData = NULL;
+			MYLIB_SERIALPROT_TxComplete(hseriali2c->Transport.hserialprot);
+		}
+	}
+
+	SERIALPROT_I2C_TransmitNext(hseriali2c, I2C_NEXT_FRAME);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_ListenCpltCallback aufzurufen: Übertragung beendet (STOP), wieder auf die Adresse hören
+  * @param  hi2c 		I2C handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_I2C_ListenCpltCallback(I2C_HandleTypeDef *hi2c){
+
+	SERIALPROT_I2C_TypeDef *hseriali2c = MYLIB_SERIALPROT_I2C_GetInstance(hi2c);
+	if(hseriali2c == NULL){
+		return;
+	}
+
+	hseriali2c->RegisterPending = 0;
+	SERIALPROT_I2C_Listen(hseriali2c);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_I2C_ErrorCallback aufzurufen: zählt Busfehler und hört wieder auf die Adresse
+  * @note   Ein AF (NACK bzw. STOP vor dem bereitgestellten Zeichen) ist das normale Ende jeder Übertragung.
+  * @param  hi2c 		I2C handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_I2C_ErrorCallback(I2C_HandleTypeDef *hi2c){
+
+	SERIALPROT_I2C_TypeDef *hseriali2c = MYLIB_SERIALPROT_I2C_GetInstance(hi2c);
+	if(hseriali2c == NULL){
+		return;
+	}
+
+	SERIALPROTOCOL_TypeDef *hserialprot = hseriali2c->Transport.hserialprot;
+	uint32_t errorcode = HAL_I2C_GetError(hi2c);
+
+	if(errorcode & HAL_I2C_ERROR_OVR){
+		hserialprot->ErrorCounter.OverrunErrors++;
+	}
+	if(errorcode & HAL_I2C_ERROR_BERR){
+		hserialprot->ErrorCounter.FramingErrors++;
+	}
+	if(errorcode & HAL_I2C_ERROR_ARLO){
+		hserialprot->ErrorCounter.NoiseErrors++;
+	}
+
+	/* Busfehler während eines Kommandos: angefangene Eingabe verwerfen */
+	if((errorcode & (HAL_I2C_ERROR_OVR | HAL_I2C_ERROR_BERR | HAL_I2C_ERROR_ARLO)) && hseriali2c->Register == SERIALPROT_I2C_REG_CMD){
+		MYLIB_SERIALPROT_RxAbort(hserialprot);
+	}
+
+	SERIALPROT_I2C_Listen(hseriali2c);
+}
+
+/**
+  * @brief  Funktion 	stellt das nächste Zeichen des ausgewählten Registers (oder ein Füllzeichen) zum Senden bereit
+  * @param  hseriali2c 	SERIALPROT_I2C handle
+  * @param  XferOptions I2C_FIRST_FRAME zu Beginn der Leseübertragung, sonst I2C_NEXT_FRAME
+  * @retval none
+  */
+static void SERIALPROT_I2C_TransmitNext(SERIALPROT_I2C_TypeDef *hseriali2c, uint32_t XferOptions){
+
+	uint8_t *pData = &hseriali2c->FillByte;
+
+	hseriali2c->TxQueued = SERIALPROT_I2C_QUEUED_FILL;
+
+	if(hseriali2c->Register == SERIALPROT_I2C_REG_STATUS && hseriali2c->StatusPos < sizeof(hseriali2c->Status)){
+		pData = &hseriali2c->Status[hseriali2c->StatusPos];
+		hseriali2c->TxQueued = SERIALPROT_I2C_QUEUED_STATUS;
+	}else if(hseriali2c->Register == SERIALPROT_I2C_REG_DATA && hseriali2c->pTxData != NULL && hseriali2c->TxPos < hseriali2c->TxSize){
+		pData = &hseriali2c->pTxData[hseriali2c->TxPos];
+		hseriali2c->TxQueued = SERIALPROT_I2C_QUEUED_DATA;
+	}
+
+	HAL_I2C_Slave_Seq_Transmit_IT(hseriali2c->hi2c, pData, 1, XferOptions);
+}
+
+/**
+  * @brief  Funktion 	aktiviert das Hören auf die eigene Adresse, falls die HAL es beendet hat
+  * @param  hseriali2c 	SERIALPROT_I2C handle
+  * @retval none
+  */
+static void SERIALPROT_I2C_Listen(SERIALPROT_I2C_TypeDef *hseriali2c){
+
+	if(HAL_I2C_GetState(hseriali2c->hi2c) == HAL_I2C_STATE_READY){
+		if(HAL_I2C_EnableListen_IT(hseriali2c->hi2c) != HAL_OK){
+			hseriali2c->Transport.hserialprot->ErrorCounter.RxRearmErrors++;
+		}
+	}
+}
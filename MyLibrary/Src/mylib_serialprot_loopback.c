@@ -0,0 +1,123 @@
+/**
+******************************************************************************
+* @file mylib_serialprot_loopback.c
+* @author Reiter Roman
+* @brief mylib-Serielles Protokoll, Speicher-Transportschicht.
+* Diese Datei bindet das serielle Protokoll über die Transportschnittstelle an einen Speicherbereich statt an eine Schnittstelle:
+* + Eingaben werden mit MYLIB_SERIALPROT_LOOPBACK_Write() direkt an das Protokoll übergeben
+* + Antworten werden in einen Ausgabepuffer kopiert und sofort als gesendet gemeldet
+* Damit kann das Protokoll ohne UART betrieben werden, z.B. um den Durchsatz am Host oder am Target zu messen.
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) SERIALPROT_LOOPBACK handle und Instanz des Protokolls anlegen und binden
+		(+++) z.B.: MYLIB_SERIALPROT_LOOPBACK_Init(&hloopback, output, sizeof(output));
+		(+++) z.B.: MYLIB_SERIALPROT_Init(&hserialprot, &hloopback.Transport);
+
+	(#) Eingaben übergeben, die Antworten stehen danach in output (hloopback.OutputLength Zeichen)
+		(+++) z.B.: MYLIB_SERIALPROT_LOOPBACK_Write(&hloopback, (uint8_t *)"#gpo,rt:on\r", 11);
+		(+) MYLIB_SERIALPROT_LOOPBACK_Flush() leert den Ausgabepuffer
+
+	(#) Am Host werden mylib_serialprot.c, diese Datei und die Ersatzfunktionen aus Tools/serialprot_host.c
+		(HAL_GetTick(), itoa(), SERIALPROT_Command_GPO_Callback()) benötigt
+		(+) Durchsatzmessung je Kommando: Tools/serialprot_bench.c
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_serialprot_loopback.h"
+#include "string.h"
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SERIALPROT_LOOPBACK_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef SERIALPROT_LOOPBACK_Start(SERIALPROTOCOL_TransportTypeDef *htransport);
+static HAL_StatusTypeDef SERIALPROT_LOOPBACK_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	initialisiert die Speicher-Transportschicht
+  * @param  hloopback 	SERIALPROT_LOOPBACK handle
+  * @param  pOutput 	Ausgabepuffer für die Antworten (NULL: Antworten werden nur gezählt)
+  * @param  OutputSize 	Größe des Ausgabepuffers
+  * @retval none
+  */
+void MYLIB_SERIALPROT_LOOPBACK_Init(SERIALPROT_LOOPBACK_TypeDef *hloopback, uint8_t *pOutput, uint32_t OutputSize){
+
+	memset(hloopback,0,sizeof(SERIALPROT_LOOPBACK_TypeDef));
+	hloopback->Transport.Start = SERIALPROT_LOOPBACK_Start;
+	hloopback->Transport.Transmit = SERIALPROT_LOOPBACK_Transmit;
+	hloopback->pOutput = pOutput;
+	hloopback->OutputSize = (pOutput != NULL) ? OutputSize : 0;
+}
+
+/**
+  * @brief  Funktion 	übergibt Eingaben an das gebundene Protokoll (entspricht dem Empfang über eine Schnittstelle)
+  * @param  hloopback 	SERIALPROT_LOOPBACK handle
+  * @param  pData 		Eingabezeichen
+  * @param  Size 		Anzahl der Eingabezeichen
+  * @retval none
+  */
+void MYLIB_SERIALPROT_LOOPBACK_Write(SERIALPROT_LOOPBACK_TypeDef *hloopback, const uint8_t *pData, uint16_t Size){
+
+	if(hloopback->Transport.hserialprot == NULL){
+		return;
+	}
+	MYLIB_SERIALPROT_RxNotify(hloopback->Transport.hserialprot, pData, Size);
+}
+
+/**
+  * @brief  Funktion 	leert den Ausgabepuffer
+  * @param  hloopback 	SERIALPROT_LOOPBACK handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_LOOPBACK_Flush(SERIALPROT_LOOPBACK_TypeDef *hloopback){
+
+	hloopback->OutputLength = 0;
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Empfang starten, für den Speicher nichts zu tun
+  * @param  htransport 	Transportschicht
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_LOOPBACK_Start(SERIALPROTOCOL_TransportTypeDef *htransport){
+
+	(void)htransport;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Sendepuffer in den Ausgabepuffer kopieren und sofort als gesendet melden
+  * @param  htransport 	Transportschicht
+  * @param  pData 		Sendepuffer
+  * @param  Size 		Anzahl der zu sendenden Zeichen
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_LOOPBACK_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size){
+
+	SERIALPROT_LOOPBACK_TypeDef *hloopback = (SERIALPROT_LOOPBACK_TypeDef *)htransport;
+	uint32_t n = Size;
+
+	if(n > hloopback->OutputSize - hloopback->OutputLength){
+		n = hloopback->OutputSize - hloopback->OutputLength;
+	}
+	if(n > 0){
+		memcpy(&hloopback->pOutput[hloopback->OutputLength], pData, n);
+		hloopback->OutputLength += n;
+	}
+	hloopback->OutputDropped += Size - n;
+
+	/* Der Speicher ist sofort "gesendet" */
+	MYLIB_SERIALPROT_TxComplete(htransport->hserialprot);
+	return HAL_OK;
+}
@@ -0,0 +1,313 @@
+/**
+******************************************************************************
+* @file mylib_serialprot_spi.c
+* @author Reiter Roman
+* @brief mylib-Serielles Protokoll, SPI-Slave-Transportschicht.
+* Diese Datei verbindet das serielle Protokoll über die Transportschnittstelle mit einer SPI im Slave-Betrieb:
+* + Empfang vollduplex per zirkulärem DMA, ausgewertet bei halbem/vollem Puffer und am Ende jeder Übertragung (NSS)
+* + Senden der Sendepuffer des Protokolls ohne Kopie per DMA, READY-Leitung zum Master
+* Der SPI-HAL-Treiber ist in diesem Projekt nicht enthalten, SPI und DMA werden daher direkt über die Register betrieben.
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Hardware (in der main.c)
+		(+) SPI1: PA1 (SCK), PA11 (MISO), PA12 (MOSI), Alternate Function AF5, Takt der SPI1 und des DMA1 einschalten
+		(+) NSS: PB0 als GPIO mit EXTI auf beide Flanken, der Slave wird per Software ausgewählt (SSM)
+		(+) READY: PB1 als Ausgang
+		(+) DMA1 Kanal 2 (RX) und Kanal 3 (TX), Request 1; die DMA- und EXTI-Interrupts müssen dieselbe
+			NVIC-Priorität wie die übrigen Transportschichten haben
+
+	(#) Initialisierung
+		(+++) z.B.: hserialspi1.Init.Instance = SPI1;
+		(+++) z.B.: hserialspi1.Init.RxChannel = DMA1_Channel2; hserialspi1.Init.TxChannel = DMA1_Channel3; hserialspi1.Init.DmaRequest = 1;
+		(+++) z.B.: hserialspi1.Init.ReadyPort = SPI_READY_GPIO_Port; hserialspi1.Init.ReadyPin = SPI_READY_Pin;
+		(+++) z.B.: MYLIB_SERIALPROT_SPI_Init(&hserialspi1);
+		(+++) z.B.: MYLIB_SERIALPROT_Init(&hserialprot3, &hserialspi1.Transport);
+		(+++) z.B.: hserialprot3.Quiet = 1;		(kein Echo, keine Eingabeaufforderung)
+
+	(#) Weiterleiten der Interrupts
+		(+++) DMA1_Channel2_IRQHandler ()  -> MYLIB_SERIALPROT_SPI_RxDMA_IRQHandler(&hserialspi1)
+		(+++) DMA1_Channel3_IRQHandler ()  -> MYLIB_SERIALPROT_SPI_TxDMA_IRQHandler(&hserialspi1)
+		(+++) HAL_GPIO_EXTI_Callback ()    -> MYLIB_SERIALPROT_SPI_NSS_Callback(&hserialspi1, HAL_GPIO_ReadPin(SPI_NSS_GPIO_Port, SPI_NSS_Pin))
+
+	(#) Ablauf für den Master (SPI Mode 0, 8 Bit, MSB zuerst)
+		(+) Kommandos werden als Text wie über den UART gesendet (z.B. "#gpo,rt:on\r"), mehrere Kommandos je Übertragung sind möglich.
+		(+) Empfangene Füllzeichen (0x00) und 0xFF werden verworfen, der Master sendet zum Abholen einer Antwort 0x00.
+		(+) READY geht auf High, sobald eine Antwort bereitsteht. Der Master taktet dann Füllzeichen und verwirft
+			alle 0x00 der Antwort, bis READY wieder Low ist, plus 4 Zeichen (Tiefe des TX-FIFO).
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_serialprot_spi.h"
+#include "mylib_dmachannel.h"
+#include "string.h"
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SERIALPROT_SPI_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef SERIALPROT_SPI_Start(SERIALPROTOCOL_TransportTypeDef *htransport);
+static HAL_StatusTypeDef SERIALPROT_SPI_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size);
+static void SERIALPROT_SPI_StartRx(SERIALPROT_SPI_TypeDef *hserialspi);
+static void SERIALPROT_SPI_TxIdle(SERIALPROT_SPI_TypeDef *hserialspi);
+static void SERIALPROT_SPI_RxFlush(SERIALPROT_SPI_TypeDef *hserialspi);
+static void SERIALPROT_SPI_Notify(SERIALPROT_SPI_TypeDef *hserialspi, const uint8_t *pData, uint16_t Size);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	initialisiert die SPI-Transportschicht, die Konfiguration steht in hserialspi->Init
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_SPI_Init(SERIALPROT_SPI_TypeDef *hserialspi){
+
+	SERIALPROT_SPI_InitTypeDef *init = &hserialspi->Init;
+
+	if(init->Instance == NULL || init->RxChannel == NULL || init->TxChannel == NULL || init->ReadyPort == NULL){
+		return HAL_ERROR;
+	}
+
+	memset(&hserialspi->Transport,0,sizeof(SERIALPROTOCOL_TransportTypeDef));
+	hserialspi->Transport.Start = SERIALPROT_SPI_Start;
+	hserialspi->Transport.Transmit = SERIALPROT_SPI_Transmit;
+	hserialspi->RxPos = 0;
+	hserialspi->FillByte = SERIALPROT_SPI_FILL_BYTE;
+	hserialspi->TxActive = 0;
+
+	HAL_GPIO_WritePin(init->ReadyPort, init->ReadyPin, GPIO_PIN_RESET);
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: DMA-Kanäle und SPI als Slave konfigurieren und den Empfang starten
+  * @param  htransport 	Transportschicht
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_SPI_Start(SERIALPROTOCOL_TransportTypeDef *htransport){
+
+	SERIALPROT_SPI_TypeDef *hserialspi = (SERIALPROT_SPI_TypeDef *)htransport;
+	SPI_TypeDef *spi = hserialspi->Init.Instance;
+	DMA_Channel_TypeDef *rx = hserialspi->Init.RxChannel;
+	DMA_Channel_TypeDef *tx = hserialspi->Init.TxChannel;
+
+	spi->CR1 &= ~SPI_CR1_SPE;
+	rx->CCR &= ~DMA_CCR_EN;
+	tx->CCR &= ~DMA_CCR_EN;
+
+	/* DMA-Request der SPI auf beide Kanäle legen */
+	MYLIB_DMACHANNEL_SetRequest(rx, hserialspi->Init.DmaRequest);
+	MYLIB_DMACHANNEL_SetRequest(tx, hserialspi->Init.DmaRequest);
+
+	/* Reihenfolge laut Referenzhandbuch: RXDMAEN, DMA-Kanäle, TXDMAEN, SPE */
+	spi->CR2 = (7UL << SPI_CR2_DS_Pos) | SPI_CR2_FRXTH | SPI_CR2_RXDMAEN;
+	SERIALPROT_SPI_StartRx(hserialspi);
+	SERIALPROT_SPI_TxIdle(hserialspi);
+	spi->CR2 |= SPI_CR2_TXDMAEN;
+
+	/* Slave, Mode 0, Auswahl per Software (SSI=1: nicht ausgewählt bis zur fallenden Flanke an NSS) */
+	spi->CR1 = SPI_CR1_SSM | SPI_CR1_SSI;
+	spi->CR1 |= SPI_CR1_SPE;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Sendepuffer des Protokolls ohne Kopie per DMA bereitstellen und READY setzen
+  * @param  htransport 	Transportschicht
+  * @param  pData 		Sendepuffer, bleibt bis zum Ende des DMA-Transfers unverändert
+  * @param  Size 		Anzahl der zu sendenden Zeichen
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_SPI_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size){
+
+	SERIALPROT_SPI_TypeDef *hserialspi = (SERIALPROT_SPI_TypeDef *)htransport;
+	DMA_Channel_TypeDef *tx = hserialspi->Init.TxChannel;
+
+	if(hserialspi->TxActive || Size == 0){
+		return HAL_BUSY;
+	}
+
+	/* Füllzeichen-Betrieb beenden, die Antwort folgt auf die noch im TX-FIFO stehenden Füllzeichen */
+	tx->CCR &= ~DMA_CCR_EN;
+	MYLIB_DMACHANNEL_ClearFlags(tx);
+	tx->CMAR = (uint32_t)pData;
+	tx->CNDTR = Size;
+	tx->CCR = DMA_CCR_DIR | DMA_CCR_MINC | DMA_CCR_TCIE | DMA_CCR_TEIE;
+	hserialspi->TxActive = 1;
+	tx->CCR |= DMA_CCR_EN;
+
+	HAL_GPIO_WritePin(hserialspi->Init.ReadyPort, hserialspi->Init.ReadyPin, GPIO_PIN_SET);
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des RX-DMA-Kanals aufzurufen: übergibt die neuen Zeichen an das Protokoll
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_SPI_RxDMA_IRQHandler(SERIALPROT_SPI_TypeDef *hserialspi){
+
+	DMA_Channel_TypeDef *rx = hserialspi->Init.RxChannel;
+	uint32_t flags = MYLIB_DMACHANNEL_GetFlags(rx);
+
+	if(flags & DMA_ISR_TEIF1){
+		/* Übertragungsfehler: der Kanal wurde von der DMA abgeschaltet, Eingabe verwerfen und neu starten */
+		hserialspi->Transport.hserialprot->ErrorCounter.RxRearmErrors++;
+		MYLIB_SERIALPROT_RxAbort(hserialspi->Transport.hserialprot);
+		SERIALPROT_SPI_StartRx(hserialspi);
+		return;
+	}
+
+	SERIALPROT_SPI_RxFlush(hserialspi);
+}
+
+/**
+  * @brief  Funktion 	aus dem Interrupt des TX-DMA-Kanals aufzurufen: meldet dem Protokoll das Ende des Sendevorgangs
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_SPI_TxDMA_IRQHandler(SERIALPROT_SPI_TypeDef *hserialspi){
+
+	DMA_Channel_TypeDef *tx = hserialspi->Init.TxChannel;
+	uint32_t flags = MYLIB_DMACHANNEL_GetFlags(tx);
+
+	if(!hserialspi->TxActive || !(flags & (DMA_ISR_TCIF1 | DMA_ISR_TEIF1))){
+		return;
+	}
+
+	if(flags & DMA_ISR_TEIF1){
+		hserialspi->Transport.hserialprot->ErrorCounter.TxErrors++;
+	}
+
+	/* wieder Füllzeichen senden, READY zurücknehmen und den zweiten Sendepuffer anfordern */
+	SERIALPROT_SPI_TxIdle(hserialspi);
+	hserialspi->TxActive = 0;
+	HAL_GPIO_WritePin(hserialspi->Init.ReadyPort, hserialspi->Init.ReadyPin, GPIO_PIN_RESET);
+	MYLIB_SERIALPROT_TxComplete(hserialspi->Transport.hserialprot);
+}
+
+/**
+  * @brief  Funktion 	aus dem EXTI-Callback der NSS-Leitung aufzurufen: wählt den Slave aus bzw. ab und wertet
+  * 					am Ende einer Übertragung die restlichen empfangenen Zeichen aus
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @param  NSS 		Pegel der NSS-Leitung nach der Flanke
+  * @retval none
+  */
+void MYLIB_SERIALPROT_SPI_NSS_Callback(SERIALPROT_SPI_TypeDef *hserialspi, GPIO_PinState NSS){
+
+	SPI_TypeDef *spi = hserialspi->Init.Instance;
+
+	if(NSS == GPIO_PIN_RESET){
+		spi->CR1 &= ~SPI_CR1_SSI;
+		return;
+	}
+
+	spi->CR1 |= SPI_CR1_SSI;
+
+	/* Überlauf: Zeichen gingen verloren, die angefangene Eingabe ist unbrauchbar */
+	if(spi->SR & SPI_SR_OVR){
+		(void)*(__IO uint8_t *)&spi->DR;
+		(void)spi->SR;
+		hserialspi->Transport.hserialprot->ErrorCounter.OverrunErrors++;
+		SERIALPROT_SPI_RxFlush(hserialspi);
+		MYLIB_SERIALPROT_RxAbort(hserialspi->Transport.hserialprot);
+		return;
+	}
+
+	SERIALPROT_SPI_RxFlush(hserialspi);
+}
+
+/**
+  * @brief  Funktion 	startet den zirkulären RX-DMA-Kanal auf das Datenregister der SPI
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @retval none
+  */
+static void SERIALPROT_SPI_StartRx(SERIALPROT_SPI_TypeDef *hserialspi){
+
+	DMA_Channel_TypeDef *rx = hserialspi->Init.RxChannel;
+
+	rx->CCR &= ~DMA_CCR_EN;
+	MYLIB_DMACHANNEL_ClearFlags(rx);
+	rx->CPAR = (uint32_t)&hserialspi->Init.Instance->DR;
+	rx->CMAR = (uint32_t)hserialspi->RxBuffer;
+	rx->CNDTR = SERIALPROT_SPI_RxDMA_SIZE;
+	rx->CCR = DMA_CCR_PL_1 | DMA_CCR_MINC | DMA_CCR_CIRC | DMA_CCR_HTIE | DMA_CCR_TCIE | DMA_CCR_TEIE;
+	hserialspi->RxPos = 0;
+	rx->CCR |= DMA_CCR_EN;
+}
+
+/**
+  * @brief  Funktion 	lässt den TX-DMA-Kanal zirkulär das Füllzeichen senden, solange keine Antwort ansteht
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @retval none
+  */
+static void SERIALPROT_SPI_TxIdle(SERIALPROT_SPI_TypeDef *hserialspi){
+
+	DMA_Channel_TypeDef *tx = hserialspi->Init.TxChannel;
+
+	tx->CCR &= ~DMA_CCR_EN;
+	tx->CPAR = (uint32_t)&hserialspi->Init.Instance->DR;
+	tx->CMAR = (uint32_t)&hserialspi->FillByte;
+	tx->CNDTR = 1;
+	tx->CCR = DMA_CCR_DIR | DMA_CCR_CIRC;
+	tx->CCR |= DMA_CCR_EN;
+}
+
+/**
+  * @brief  Funktion 	übergibt die seit dem letzten Aufruf empfangenen Zeichen des zirkulären Puffers an das Protokoll
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @retval none
+  */
+static void SERIALPROT_SPI_RxFlush(SERIALPROT_SPI_TypeDef *hserialspi){
+
+	uint16_t pos = hserialspi->RxPos;
+	uint16_t head = SERIALPROT_SPI_RxDMA_SIZE - hserialspi->Init.RxChannel->CNDTR;
+
+	if(head == SERIALPROT_SPI_RxDMA_SIZE){
+		head = 0;
+	}
+	if(head == pos){
+		return;
+	}
+
+	if(head > pos){
+		SERIALPROT_SPI_Notify(hserialspi, &hserialspi->RxBuffer[pos], head - pos);
+	}else{
+		/* Umlauf des zirkulären Puffers */
+		SERIALPROT_SPI_Notify(hserialspi, &hserialspi->RxBuffer[pos], SERIALPROT_SPI_RxDMA_SIZE - pos);
+		SERIALPROT_SPI_Notify(hserialspi, hserialspi->RxBuffer, head);
+	}
+	hserialspi->RxPos = head;
+}
+
+/**
+  * @brief  Funktion 	übergibt empfangene Zeichen ohne Füllzeichen (0x00, 0xFF) an das Protokoll
+  * @param  hserialspi 	SERIALPROT_SPI handle
+  * @param  pData 		empfangene Zeichen
+  * @param  Size 		Anzahl der empfangenen Zeichen
+  * @retval none
+  */
+static void SERIALPROT_SPI_Notify(SERIALPROT_SPI_TypeDef *hserialspi, const uint8_t *pData, uint16_t Size){
+
+	uint16_t start = 0;
+
+	for(uint16_t i=0; i<=Size; i++){
+		if(i == Size || pData[i] == SERIALPROT_SPI_FILL_BYTE || pData[i] == 0xFF){
+			if(i > start){
+				MYLIB_SERIALPROT_RxNotify(hserialspi->Transport.hserialprot, &pData[start], i - start);
+			}
+			start = i + 1;
+		}
+	}
+}
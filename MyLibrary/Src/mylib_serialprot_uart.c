@@ -0,0 +1,454 @@
+/**
+******************************************************************************
+* @file mylib_serialprot_uart.c
+* @author Reiter Roman
+* @brief mylib-Serielles Protokoll, UART-Transportschicht.
+* Diese Datei verbindet das serielle Protokoll über die Transportschnittstelle
+* (SERIALPROTOCOL_TransportTypeDef) mit einem oder mehreren UARTs:
+* + Empfang per Interrupt (zeichenweise) oder per zirkulärem DMA mit IDLE-Erkennung
+* + Senden der Sendepuffer des Protokolls ohne Kopie per Interrupt oder DMA
+* + Fehlerbehandlung ohne Error_Handler()
+* + Mehrpunktbetrieb (RS-485) mit Adressmarke und Mute-Modus des UART
+* + Zeilenende ('\r') per Zeichenerkennung des UART ohne Warten auf IDLE (DMA)
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Je UART wird ein SERIALPROT_UART handle und eine Instanz des Protokolls angelegt
+		(+++) z.B.: SERIALPROT_UART_TypeDef hserialuart2;
+		(+++) z.B.: SERIALPROTOCOL_TypeDef hserialprot2;
+
+	(#) Nach der Initialisierung des UART wird die Transportschicht initialisiert und an das Protokoll gebunden
+		(+++) z.B.: MYLIB_SERIALPROT_UART_Init(&hserialuart2, &huart2, SERIALPROT_UART_MODE_DMA);
+		(+++) z.B.: MYLIB_SERIALPROT_Init(&hserialprot2, &hserialuart2.Transport);
+		(+) Für SERIALPROT_UART_MODE_DMA müssen hdmarx (zirkulär) und hdmatx (normal) mit dem UART verknüpft sein.
+			Die DMA-Interrupts müssen dieselbe NVIC-Priorität wie der UART-Interrupt haben.
+
+	(#) Die HAL-Callbacks werden an die Transportschicht weitergeleitet, welche den handle über den UART findet:
+		(+++) HAL_UART_RxCpltCallback ()    -> MYLIB_SERIALPROT_UART_RxCpltCallback(huart)
+		(+++) HAL_UARTEx_RxEventCallback () -> MYLIB_SERIALPROT_UART_RxEventCallback(huart, Size)
+		(+++) HAL_UART_TxCpltCallback ()    -> MYLIB_SERIALPROT_UART_TxCpltCallback(huart)
+		(+++) HAL_UART_ErrorCallback ()     -> MYLIB_SERIALPROT_UART_ErrorCallback(huart)
+
+	(#) Mehrpunktbetrieb (mehrere Boards an einem RS-485-Bus)
+		(+) UART mit HAL_RS485Ex_Init() initialisieren, der Treiber (DE) wird dann vom UART selbst geschaltet
+		(+) Vor MYLIB_SERIALPROT_Init() die Adresse des Knotens (0..127) setzen
+			(+++) z.B.: MYLIB_SERIALPROT_UART_EnableMultiDrop(&hserialuart1, 5);
+		(+) Jeder Rahmen beginnt mit dem Adressbyte 0x80 | Adresse, gefolgt vom Kommando, z.B. 0x85 "#gpo,rt:on\r"
+			(++) Der UART ist im Mute-Modus: Zeichen für andere Knoten lösen keinen Interrupt aus
+			(++) Das passende Adressbyte weckt den UART auf, es wird nicht an das Protokoll übergeben
+			(++) Nach dem '\r' des Kommandos wird der UART wieder stumm geschaltet
+		(+) Die Instanz sollte mit Quiet betrieben werden (kein Echo auf dem Bus)
+
+	(#) Zeilenende sofort melden (nur SERIALPROT_UART_MODE_DMA, nicht im Mehrpunktbetrieb)
+		(+) Ohne Zeichenerkennung kommt das '\r' erst mit dem IDLE (eine Zeichenzeit später) beim Protokoll an
+		(+) Vor MYLIB_SERIALPROT_Init() die Zeichenerkennung auf '\r' setzen
+			(+++) z.B.: MYLIB_SERIALPROT_UART_EnableLineMatch(&hserialuart2);
+		(+) Im UART-Interrupt vor HAL_UART_IRQHandler() aufrufen
+			(+++) z.B.: MYLIB_SERIALPROT_UART_IRQHandler(&huart2);
+
+	(#) Fehlerbehandlung
+		(+) Fehler des UART führen nicht zum Aufruf von Error_Handler(), da dieser die Interrupts sperrt und das Protokoll bis zum Neustart stillsteht.
+			(++) ORE/FE/NE/PE werden in hserialprot.ErrorCounter gezählt, die Fehlerflags gelöscht,
+				 die angefangene Eingabe verworfen und der Empfang wieder aktiviert.
+			(++) Ein hängender Empfang wird abgebrochen und neu gestartet (ErrorCounter.RxRearmErrors).
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_serialprot_uart.h"
+#include "string.h"
+
+/* Private variables ---------------------------------------------------------*/
+/** @addtogroup SERIALPROT_UART_Private_Variables
+  * @{
+  */
+
+/* gebundene UARTs, Zuordnung UART -> SERIALPROT_UART handle für die HAL-Callbacks */
+static SERIALPROT_UART_TypeDef * SERIALPROT_UART_Instances[SERIALPROT_UART_MAX_INSTANCES];
+/**
+  * @}
+  */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SERIALPROT_UART_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef SERIALPROT_UART_Start(SERIALPROTOCOL_TransportTypeDef *htransport);
+static HAL_StatusTypeDef SERIALPROT_UART_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size);
+static HAL_StatusTypeDef SERIALPROT_UART_Receive(SERIALPROT_UART_TypeDef *hserialuart);
+static void SERIALPROT_UART_Deliver(SERIALPROT_UART_TypeDef *hserialuart, const uint8_t *pData, uint16_t Size);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	initialisiert die UART-Transportschicht und trägt sie für die HAL-Callbacks ein
+  * @param  hserialuart SERIALPROT_UART handle
+  * @param  huart 		UART handle (bereits mit HAL_UART_Init() initialisiert)
+  * @param  Mode 		Betriebsart IT oder DMA
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_UART_Init(SERIALPROT_UART_TypeDef *hserialuart, UART_HandleTypeDef *huart, SERIALPROT_UART_ModeTypeDef Mode){
+
+	uint8_t free_slot = SERIALPROT_UART_MAX_INSTANCES;
+
+	/* handle eintragen (ein erneutes Init desselben handles belegt keinen neuen Platz) */
+	for(uint8_t i=0; i<SERIALPROT_UART_MAX_INSTANCES; i++){
+		if(SERIALPROT_UART_Instances[i] == hserialuart){
+			free_slot = i;
+			break;
+		}
+		if(SERIALPROT_UART_Instances[i] == NULL && free_slot == SERIALPROT_UART_MAX_INSTANCES){
+			free_slot = i;
+		}
+	}
+	if(free_slot == SERIALPROT_UART_MAX_INSTANCES){
+		return HAL_ERROR;
+	}
+
+	/* DMA-Betrieb nur mit verknüpften DMA-Kanälen */
+	if(Mode == SERIALPROT_UART_MODE_DMA && (huart->hdmarx == NULL || huart->hdmatx == NULL)){
+		return HAL_ERROR;
+	}
+
+	memset(hserialuart,0,sizeof(SERIALPROT_UART_TypeDef));
+	hserialuart->Transport.Start = SERIALPROT_UART_Start;
+	hserialuart->Transport.Transmit = SERIALPROT_UART_Transmit;
+	hserialuart->huart = huart;
+	hserialuart->Mode = Mode;
+	SERIALPROT_UART_Instances[free_slot] = hserialuart;
+
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	liefert den an den UART gebundenen SERIALPROT_UART handle
+  * @param  huart 		UART handle
+  * @retval SERIALPROT_UART handle oder NULL, falls keine Transportschicht gebunden ist
+  */
+SERIALPROT_UART_TypeDef * MYLIB_SERIALPROT_UART_GetInstance(UART_HandleTypeDef *huart){
+
+	for(uint8_t i=0; i<SERIALPROT_UART_MAX_INSTANCES; i++){
+		if(SERIALPROT_UART_Instances[i] != NULL && SERIALPROT_UART_Instances[i]->huart == huart){
+			return SERIALPROT_UART_Instances[i];
+		}
+	}
+	return NULL;
+}
+
+/**
+  * @brief  Funktion 	schaltet den UART in den Mehrpunktbetrieb: Aufwecken über Adressmarke (MSB gesetzt) mit 7-Bit-Adresse,
+  * 					danach ist der UART stumm, bis sein Adressbyte empfangen wird
+  * @note   Vor MYLIB_SERIALPROT_Init() aufzurufen, der Empfang darf noch nicht laufen
+  * @param  hserialuart SERIALPROT_UART handle
+  * @param  Address 	Adresse des Knotens (0..127)
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_UART_EnableMultiDrop(SERIALPROT_UART_TypeDef *hserialuart, uint8_t Address){
+
+	UART_HandleTypeDef *huart = hserialuart->huart;
+
+	if(Address > 0x7F || huart->RxState != HAL_UART_STATE_READY){
+		return HAL_ERROR;
+	}
+
+	/* Adresse und Aufweckmethode sind nur bei gesperrtem UART änderbar */
+	__HAL_UART_DISABLE(huart);
+	MODIFY_REG(huart->Instance->CR2, USART_CR2_ADD, (uint32_t)Address << UART_CR2_ADDRESS_LSB_POS);
+	MODIFY_REG(huart->Instance->CR1, USART_CR1_WAKE, UART_WAKEUPMETHOD_ADDRESSMARK);
+
+	/* 7-Bit-Adresse, gibt den UART wieder frei */
+	if(HAL_MultiProcessorEx_AddressLength_Set(huart, UART_ADDRESS_DETECT_7B) != HAL_OK){
+		return HAL_ERROR;
+	}
+	if(HAL_MultiProcessor_EnableMuteMode(huart) != HAL_OK){
+		return HAL_ERROR;
+	}
+	HAL_MultiProcessor_EnterMuteMode(huart);
+
+	hserialuart->MultiDrop = 1;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	aktiviert die Zeichenerkennung des UART auf '\r': das Zeilenende wird sofort aus dem DMA-Puffer
+  * 					gemeldet und nicht erst beim IDLE
+  * @note   Vor MYLIB_SERIALPROT_Init() aufzurufen, nur Betriebsart DMA und nicht im Mehrpunktbetrieb (gleiches ADD-Feld)
+  * @param  hserialuart SERIALPROT_UART handle
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_UART_EnableLineMatch(SERIALPROT_UART_TypeDef *hserialuart){
+
+	UART_HandleTypeDef *huart = hserialuart->huart;
+
+	if(hserialuart->Mode != SERIALPROT_UART_MODE_DMA || hserialuart->MultiDrop || huart->RxState != HAL_UART_STATE_READY){
+		return HAL_ERROR;
+	}
+
+	/* Vergleichszeichen ist nur bei gesperrtem UART änderbar, 7-Bit-Vergleich */
+	__HAL_UART_DISABLE(huart);
+	MODIFY_REG(huart->Instance->CR2, USART_CR2_ADD | USART_CR2_ADDM7, ((uint32_t)'\r' << UART_CR2_ADDRESS_LSB_POS) | USART_CR2_ADDM7);
+	__HAL_UART_ENABLE(huart);
+
+	__HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_CMF);
+	__HAL_UART_ENABLE_IT(huart, UART_IT_CM);
+
+	hserialuart->LineMatch = 1;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	aus dem UART-Interrupt vor HAL_UART_IRQHandler() aufzurufen: meldet bei erkanntem '\r'
+  * 					alle bis dahin per DMA empfangenen Zeichen an das Protokoll
+  * @param  huart 		UART handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_UART_IRQHandler(UART_HandleTypeDef *huart){
+
+	if(!__HAL_UART_GET_FLAG(huart, UART_FLAG_CMF)){
+		return;
+	}
+	__HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_CMF);
+
+	SERIALPROT_UART_TypeDef *hserialuart = MYLIB_SERIALPROT_UART_GetInstance(huart);
+	if(hserialuart == NULL || !hserialuart->LineMatch || huart->RxState != HAL_UART_STATE_BUSY_RX){
+		return;
+	}
+
+	/* das '\r' liegt noch im RDR, bis die DMA es abgeholt hat */
+	while(__HAL_UART_GET_FLAG(huart, UART_FLAG_RXNE)){
+	}
+
+	/* HT/TC der DMA stehen noch aus: deren RxEvent meldet die Zeichen, sonst würde die Position überholt */
+	DMA_HandleTypeDef *hdma = huart->hdmarx;
+	if(hdma->DmaBaseAddress->ISR & ((DMA_ISR_HTIF1 | DMA_ISR_TCIF1) << (hdma->ChannelIndex & 0x1CU))){
+		return;
+	}
+
+	uint16_t size = SERIALPROT_UART_RxDMA_SIZE - __HAL_DMA_GET_COUNTER(hdma);
+	/* Zähler bereits umgelaufen: das TC-Ereignis meldet den Rest des Puffers */
+	if(size == 0){
+		return;
+	}
+	MYLIB_SERIALPROT_UART_RxEventCallback(huart, size);
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Empfang starten (von MYLIB_SERIALPROT_Init() aufgerufen)
+  * @param  htransport 	Transportschicht
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_UART_Start(SERIALPROTOCOL_TransportTypeDef *htransport){
+
+	SERIALPROT_UART_TypeDef *hserialuart = (SERIALPROT_UART_TypeDef *)htransport;
+
+	return SERIALPROT_UART_Receive(hserialuart);
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Sendepuffer des Protokolls ohne Kopie per Interrupt oder DMA senden
+  * @param  htransport 	Transportschicht
+  * @param  pData 		Sendepuffer, bleibt bis zum TxCplt-Callback unverändert
+  * @param  Size 		Anzahl der zu sendenden Zeichen
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_UART_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size){
+
+	SERIALPROT_UART_TypeDef *hserialuart = (SERIALPROT_UART_TypeDef *)htransport;
+
+	if(hserialuart->Mode == SERIALPROT_UART_MODE_DMA){
+		return HAL_UART_Transmit_DMA(hserialuart->huart, pData, Size);
+	}
+	return HAL_UART_Transmit_IT(hserialuart->huart, pData, Size);
+}
+
+/**
+  * @brief  Funktion 	aktiviert den Empfang des UART; ein hängender Empfang wird abgebrochen und neu gestartet
+  * @param  hserialuart SERIALPROT_UART handle
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_UART_Receive(SERIALPROT_UART_TypeDef *hserialuart){
+
+	UART_HandleTypeDef *huart = hserialuart->huart;
+	HAL_StatusTypeDef status;
+
+	/* Empfang läuft bereits (z.B. nach nicht blockierendem FE/NE/PE), nichts zu tun */
+	if(huart->RxState == HAL_UART_STATE_BUSY_RX){
+		return HAL_OK;
+	}
+
+	hserialuart->RxPos = 0;
+	if(hserialuart->Mode == SERIALPROT_UART_MODE_DMA){
+		status = HAL_UARTEx_ReceiveToIdle_DMA(huart, hserialuart->RxBuffer, SERIALPROT_UART_RxDMA_SIZE);
+	}else{
+		status = HAL_UART_Receive_IT(huart, hserialuart->RxBuffer, 1);
+	}
+	if(status == HAL_OK){
+		return HAL_OK;
+	}
+
+	/* Empfang abbrechen, Fehlerflags löschen und erneut versuchen */
+	if(hserialuart->Transport.hserialprot != NULL){
+		hserialuart->Transport.hserialprot->ErrorCounter.RxRearmErrors++;
+	}
+	HAL_UART_AbortReceive(huart);
+	__HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_OREF | UART_CLEAR_FEF | UART_CLEAR_NEF | UART_CLEAR_PEF);
+	__HAL_UART_SEND_REQ(huart, UART_RXDATA_FLUSH_REQUEST);
+
+	if(hserialuart->Mode == SERIALPROT_UART_MODE_DMA){
+		return HAL_UARTEx_ReceiveToIdle_DMA(huart, hserialuart->RxBuffer, SERIALPROT_UART_RxDMA_SIZE);
+	}
+	return HAL_UART_Receive_IT(huart, hserialuart->RxBuffer, 1);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_UART_RxCpltCallback aufzurufen (Betriebsart IT): meldet das empfangene Zeichen
+  * 					an das Protokoll und aktiviert den Empfang wieder
+  * @param  huart 		UART handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_UART_RxCpltCallback(UART_HandleTypeDef *huart){
+
+	SERIALPROT_UART_TypeDef *hserialuart = MYLIB_SERIALPROT_UART_GetInstance(huart);
+	if(hserialuart == NULL || hserialuart->Mode != SERIALPROT_UART_MODE_IT){
+		return;
+	}
+
+	SERIALPROT_UART_Deliver(hserialuart, hserialuart->RxBuffer, 1);
+	SERIALPROT_UART_Receive(hserialuart);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_UARTEx_RxEventCallback aufzurufen (Betriebsart DMA): meldet die seit dem letzten Ereignis
+  * 					(Halb-/Vollständig/IDLE) empfangenen Zeichen des zirkulären Puffers an das Protokoll
+  * @param  huart 		UART handle
+  * @param  Size 		aktuelle Schreibposition der DMA im Empfangspuffer
+  * @retval none
+  */
+void MYLIB_SERIALPROT_UART_RxEventCallback(UART_HandleTypeDef *huart, uint16_t Size){
+
+	SERIALPROT_UART_TypeDef *hserialuart = MYLIB_SERIALPROT_UART_GetInstance(huart);
+	if(hserialuart == NULL || hserialuart->Mode != SERIALPROT_UART_MODE_DMA){
+		return;
+	}
+
+	uint16_t pos = hserialuart->RxPos;
+
+	if(Size != pos){
+		if(Size > pos){
+			SERIALPROT_UART_Deliver(hserialuart, &hserialuart->RxBuffer[pos], Size - pos);
+		}else{
+			/* Umlauf des zirkulären Puffers */
+			SERIALPROT_UART_Deliver(hserialuart, &hserialuart->RxBuffer[pos], SERIALPROT_UART_RxDMA_SIZE - pos);
+			SERIALPROT_UART_Deliver(hserialuart, hserialuart->RxBuffer, Size);
+		}
+		hserialuart->RxPos = (Size == SERIALPROT_UART_RxDMA_SIZE) ? 0 : Size;
+	}
+
+	/* Bei nicht zirkulärer DMA endet der Empfang am Pufferende und wird neu gestartet */
+	if(huart->RxState == HAL_UART_STATE_READY){
+		SERIALPROT_UART_Receive(hserialuart);
+	}
+}
+
+/**
+  * @brief  Funktion 	übergibt empfangene Zeichen an das Protokoll; im Mehrpunktbetrieb werden Adressbytes verworfen
+  * 					und der UART nach dem Ende eines Kommandos ('\r') wieder stumm geschaltet
+  * @param  hserialuart SERIALPROT_UART handle
+  * @param  pData 		empfangene Zeichen
+  * @param  Size 		Anzahl der empfangenen Zeichen
+  * @retval none
+  */
+static void SERIALPROT_UART_Deliver(SERIALPROT_UART_TypeDef *hserialuart, const uint8_t *pData, uint16_t Size){
+
+	SERIALPROTOCOL_TypeDef *hserialprot = hserialuart->Transport.hserialprot;
+
+	if(!hserialuart->MultiDrop){
+		MYLIB_SERIALPROT_RxNotify(hserialprot, pData, Size);
+		return;
+	}
+
+	uint16_t start = 0;
+	for(uint16_t i=0; i<Size; i++){
+		if(pData[i] & 0x80){
+			/* Adressbyte: bisherige Zeichen übergeben, Adressbyte überspringen */
+			MYLIB_SERIALPROT_RxNotify(hserialprot, &pData[start], i - start);
+			start = i + 1;
+		}else if(pData[i] == '\r'){
+			MYLIB_SERIALPROT_RxNotify(hserialprot, &pData[start], i + 1 - start);
+			start = i + 1;
+			/* Rahmen zu Ende: bis zum nächsten passenden Adressbyte stumm (kein HAL-Zustandswechsel, nur Anforderung) */
+			__HAL_UART_SEND_REQ(hserialuart->huart, UART_MUTE_MODE_REQUEST);
+		}
+	}
+	MYLIB_SERIALPROT_RxNotify(hserialprot, &pData[start], Size - start);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_UART_TxCpltCallback aufzurufen: meldet dem Protokoll das Ende des Sendevorgangs
+  * @param  huart 		UART handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_UART_TxCpltCallback(UART_HandleTypeDef *huart){
+
+	SERIALPROT_UART_TypeDef *hserialuart = MYLIB_SERIALPROT_UART_GetInstance(huart);
+	if(hserialuart == NULL){
+		return;
+	}
+
+	MYLIB_SERIALPROT_TxComplete(hserialuart->Transport.hserialprot);
+}
+
+/**
+  * @brief  Funktion 	aus HAL_UART_ErrorCallback aufzurufen: zählt die Fehlerart, löscht die Fehlerflags,
+  * 					verwirft die angefangene Eingabe und aktiviert den Empfang wieder
+  * @param  huart 		UART handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_UART_ErrorCallback(UART_HandleTypeDef *huart){
+
+	SERIALPROT_UART_TypeDef *hserialuart = MYLIB_SERIALPROT_UART_GetInstance(huart);
+	if(hserialuart == NULL){
+		return;
+	}
+
+	SERIALPROTOCOL_TypeDef *hserialprot = hserialuart->Transport.hserialprot;
+	uint32_t errorcode = huart->ErrorCode;
+
+	/* Fehlerarten zählen */
+	if(errorcode & HAL_UART_ERROR_ORE){
+		hserialprot->ErrorCounter.OverrunErrors++;
+	}
+	if(errorcode & HAL_UART_ERROR_FE){
+		hserialprot->ErrorCounter.FramingErrors++;
+	}
+	if(errorcode & HAL_UART_ERROR_NE){
+		hserialprot->ErrorCounter.NoiseErrors++;
+	}
+	if(errorcode & HAL_UART_ERROR_PE){
+		hserialprot->ErrorCounter.ParityErrors++;
+	}
+
+	/* Fehlerflags löschen, falls sie noch anstehen */
+	__HAL_UART_CLEAR_FLAG(huart, UART_CLEAR_OREF | UART_CLEAR_FEF | UART_CLEAR_NEF | UART_CLEAR_PEF);
+
+	/* Bei einem Zeichenfehler ist die angefangene Eingabe unbrauchbar und wird verworfen */
+	if(errorcode & (HAL_UART_ERROR_ORE | HAL_UART_ERROR_FE | HAL_UART_ERROR_NE | HAL_UART_ERROR_PE)){
+		MYLIB_SERIALPROT_RxAbort(hserialprot);
+	}
+
+	/* Ein abgebrochener DMA-Sendevorgang gibt den Sendepuffer frei */
+	if((errorcode & HAL_UART_ERROR_DMA) && huart->gState == HAL_UART_STATE_READY && hserialprot->TxBusy){
+		hserialprot->ErrorCounter.TxErrors++;
+		MYLIB_SERIALPROT_TxComplete(hserialprot);
+	}
+
+	/* Empfang wieder aktivieren (nach ORE bzw. im DMA-Betrieb wurde er von der HAL beendet) */
+	SERIALPROT_UART_Receive(hserialuart);
+}
@@ -0,0 +1,164 @@
+/**
+******************************************************************************
+* @file mylib_serialprot_usb.c
+* @author Reiter Roman
+* @brief mylib-Serielles Protokoll, USB-CDC-ACM-Transportschicht.
+* Diese Datei bindet das serielle Protokoll über die Transportschnittstelle an einen virtuellen COM-Port über USB (Full-Speed):
+* + Jedes OUT-Paket wird als Block an das Protokoll übergeben, alle Antworten darauf landen im selben Sendepuffer
+* + Ein Sendepuffer des Protokolls (bis SERIALPROT_TxQueue_SIZE Zeichen) wird als eine IN-Übertragung aus vollen Paketen gesendet,
+*   während sie läuft sammeln sich die weiteren Antworten im zweiten Sendepuffer
+* + Der Endpunkt-Treiber ist austauschbar: am Target die USB-Device-Bibliothek (CDC), am Host ein pty (Tools/serialprot_pty.c)
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Voraussetzungen am Target (nicht im Projekt enthalten, mit CubeMX zu erzeugen)
+		(+) USB_OTG_FS als Device, Middleware USB_DEVICE Klasse CDC, HAL_PCD_MODULE_ENABLED in stm32l4xx_hal_conf.h
+		(+) USB-Takt 48 MHz aus HSI48 mit CRS (Synchronisation auf die SOF des Hosts)
+		(+) USB-Interrupt mit der NVIC-Priorität der anderen Transportschichten (0)
+		(+) PA11/PA12 sind USB DM/DP: die SPI1-Slave-Transportschicht (MISO/MOSI auf PA11/PA12) kann dann nicht verwendet werden
+
+	(#) Transportschicht anlegen und die Instanz daran binden
+		(+++) z.B.: MYLIB_SERIALPROT_USB_Init(&hserialusb, MYLIB_SERIALPROT_USB_CDC_Send, &hUsbDeviceFS);
+		(+++) z.B.: MYLIB_SERIALPROT_Init(&hserialprot5, &hserialusb.Transport);
+
+	(#) Callbacks in usbd_cdc_if.c weiterreichen
+		(+) CDC_Receive_FS():      MYLIB_SERIALPROT_USB_CDC_Receive(&hserialusb, Buf, Len);
+		(+) CDC_TransmitCplt_FS(): MYLIB_SERIALPROT_USB_TxCpltCallback(&hserialusb);
+
+	(#) TxTransfers und TxPackets zeigen, wie gut die Antworten gebündelt werden (Pakete je Übertragung)
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_serialprot_usb.h"
+#include "string.h"
+
+#ifdef HAL_PCD_MODULE_ENABLED
+#include "usbd_cdc.h"
+#endif /* HAL_PCD_MODULE_ENABLED */
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup SERIALPROT_USB_Private_Functions
+  * @{
+  */
+static HAL_StatusTypeDef SERIALPROT_USB_Start(SERIALPROTOCOL_TransportTypeDef *htransport);
+static HAL_StatusTypeDef SERIALPROT_USB_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	initialisiert die USB-Transportschicht
+  * @param  hserialusb 	SERIALPROT_USB handle
+  * @param  Send 		Endpunkt-Treiber zum Senden eines Blocks
+  * @param  pDriver 	Handle des Endpunkt-Treibers
+  * @retval none
+  */
+void MYLIB_SERIALPROT_USB_Init(SERIALPROT_USB_TypeDef *hserialusb, SERIALPROT_USB_SendTypeDef Send, void *pDriver){
+
+	memset(hserialusb,0,sizeof(SERIALPROT_USB_TypeDef));
+	hserialusb->Transport.Start = SERIALPROT_USB_Start;
+	hserialusb->Transport.Transmit = SERIALPROT_USB_Transmit;
+	hserialusb->Send = Send;
+	hserialusb->pDriver = pDriver;
+}
+
+/**
+  * @brief  Funktion 	vom Endpunkt-Treiber nach jedem OUT-Paket aufzurufen, übergibt den Inhalt an das Protokoll
+  * @param  hserialusb 	SERIALPROT_USB handle
+  * @param  pData 		Inhalt des Pakets
+  * @param  Length 		Länge des Pakets
+  * @retval none
+  */
+void MYLIB_SERIALPROT_USB_RxCallback(SERIALPROT_USB_TypeDef *hserialusb, const uint8_t *pData, uint32_t Length){
+
+	if(hserialusb->Transport.hserialprot == NULL){
+		return;
+	}
+	hserialusb->RxPackets++;
+	MYLIB_SERIALPROT_RxNotify(hserialusb->Transport.hserialprot, pData, Length);
+}
+
+/**
+  * @brief  Funktion 	vom Endpunkt-Treiber aufzurufen, wenn die IN-Übertragung vollständig vom Host abgeholt wurde
+  * @param  hserialusb 	SERIALPROT_USB handle
+  * @retval none
+  */
+void MYLIB_SERIALPROT_USB_TxCpltCallback(SERIALPROT_USB_TypeDef *hserialusb){
+
+	if(hserialusb->Transport.hserialprot == NULL){
+		return;
+	}
+	MYLIB_SERIALPROT_TxComplete(hserialusb->Transport.hserialprot);
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Empfang starten, der OUT-Endpunkt wird von der CDC-Klasse bereits beim Enumerieren bereitgestellt
+  * @param  htransport 	Transportschicht
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_USB_Start(SERIALPROTOCOL_TransportTypeDef *htransport){
+
+	(void)htransport;
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	Transportschicht: Sendepuffer als eine IN-Übertragung an den Endpunkt-Treiber übergeben
+  * @param  htransport 	Transportschicht
+  * @param  pData 		Sendepuffer
+  * @param  Size 		Anzahl der zu sendenden Zeichen
+  * @retval HAL status
+  */
+static HAL_StatusTypeDef SERIALPROT_USB_Transmit(SERIALPROTOCOL_TransportTypeDef *htransport, uint8_t *pData, uint16_t Size){
+
+	SERIALPROT_USB_TypeDef *hserialusb = (SERIALPROT_USB_TypeDef *)htransport;
+
+	hserialusb->TxTransfers++;
+	/* volle Pakete plus Restpaket, bei Vielfachen der Paketgröße ein Null-Paket als Ende der Übertragung */
+	hserialusb->TxPackets += Size / SERIALPROT_USB_PACKET_SIZE + 1;
+
+	return hserialusb->Send(hserialusb->pDriver, pData, Size);
+}
+
+#ifdef HAL_PCD_MODULE_ENABLED
+/**
+  * @brief  Funktion 	Endpunkt-Treiber der USB-Device-Bibliothek: Block über den CDC-Daten-IN-Endpunkt senden
+  * @param  pDriver 	USBD_HandleTypeDef des USB-Device
+  * @param  pData 		Sendepuffer
+  * @param  Size 		Anzahl der zu sendenden Zeichen
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_SERIALPROT_USB_CDC_Send(void *pDriver, uint8_t *pData, uint16_t Size){
+
+	USBD_HandleTypeDef *pdev = (USBD_HandleTypeDef *)pDriver;
+
+	if(pdev->dev_state != USBD_STATE_CONFIGURED){
+		return HAL_ERROR;
+	}
+	USBD_CDC_SetTxBuffer(pdev, pData, Size);
+	return (USBD_CDC_TransmitPacket(pdev) == USBD_OK) ? HAL_OK : HAL_BUSY;
+}
+
+/**
+  * @brief  Funktion 	aus CDC_Receive_FS() aufzurufen: Paket an das Protokoll übergeben und den OUT-Endpunkt wieder bereitstellen
+  * @param  hserialusb 	SERIALPROT_USB handle
+  * @param  pData 		Empfangspuffer der CDC-Klasse
+  * @param  Length 		Länge des Pakets
+  * @retval none
+  */
+void MYLIB_SERIALPROT_USB_CDC_Receive(SERIALPROT_USB_TypeDef *hserialusb, uint8_t *pData, uint32_t *Length){
+
+	USBD_HandleTypeDef *pdev = (USBD_HandleTypeDef *)hserialusb->pDriver;
+
+	MYLIB_SERIALPROT_USB_RxCallback(hserialusb, pData, *Length);
+	USBD_CDC_SetRxBuffer(pdev, pData);
+	USBD_CDC_ReceivePacket(pdev);
+}
+#endif /* HAL_PCD_MODULE_ENABLED */
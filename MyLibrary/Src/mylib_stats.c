@@ -0,0 +1,269 @@
+/**
+******************************************************************************
+* @file mylib_stats.c
+* @author Reiter Roman
+* @brief mylib-Statistik.
+* Diese Datei fasst die Werte beliebiger Quellen (ADC, Frequenzmesser, Zufallszahl) im Gerät zusammen:
+* + Je Wert wird Anzahl, Mittelwert und Summe der quadrierten Abweichungen nach Welford nachgeführt,
+*   dazu Minimum und Maximum, ohne die Werte zu speichern
+* + Ein Fenster von n Werten schließt die Kennwerte nach n Werten ab und beginnt von vorne,
+*   der Host fragt die kompakten Kennwerte ab statt jeden Wert zu übertragen
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man diesen Treiber #####
+==============================================================================
+[. . ]
+	(#) Quellen als Tabelle von Namen anlegen und die Statistik initialisieren
+		(+++) z.B.: static const char * const StatsNames[] = {"adc", "per", "hi", "rdm"};
+		(+++) z.B.: MYLIB_STATS_Init(&hstats, StatsNames, 4);
+
+	(#) Werte aus den Callbacks der Quellen übergeben (Index = Zeile der Namenstabelle)
+		(+++) z.B.: void ADCSTREAM_Value_Callback(ADCSTREAM_TypeDef *hadcstream, uint16_t Value)
+		(+++)       { MYLIB_STATS_Add(&hstats, 0, Value); }
+		(+) MYLIB_STATS_Add() darf nur aus Interrupts mit der Priorität der Transportschichten aufgerufen werden
+
+	(#) Kommandos in SERIALPROT_Command_User_Callback() weiterreichen (Name der Quelle als Parameter 1)
+		(+++) z.B.: return MYLIB_STATS_Command(&hstats, hserialprot, Result);
+		(+) "#sgr,<name>:0"  Kennwerte des laufenden Fensters, "#sgr,<name>:1" des letzten abgeschlossenen Fensters
+			"=> #a,<anzahl>,<mittelwert>,<varianz>,<min>,<max>,<fenster>" (Mittelwert und Varianz mit 3 Nachkommastellen)
+		(+) "#sgw,<name>:<n>" setzt das Fenster auf n Werte (0 = ohne Fenster, 1..STATS_WINDOW_MAX) und setzt zurück
+		(+) "#sgc,<name>:0"  setzt die Kennwerte und die Anzahl der Fenster zurück
+
+	(#) Grenzen
+		(+) Mittelwert und Varianz in float (FPU), bei sehr vielen Werten ohne Fenster sinkt die Genauigkeit
+			auf ca. 7 gültige Stellen
+
+@endverbatim
+*/
+
+
+/* Includes ------------------------------------------------------------------*/
+
+#include "mylib_stats.h"
+#include "stdlib.h"
+#include "string.h"
+
+/* Private function prototypes -----------------------------------------------*/
+/** @addtogroup STATS_Private_Functions
+  * @{
+  */
+static void STATS_Clear(STATS_AggregateTypeDef *Aggregate);
+static int8_t STATS_Find(STATS_TypeDef *hstats, const uint8_t *Name);
+static void STATS_FormatFixed(float Value, char *Text);
+/**
+  * @}
+  */
+
+/**
+  * @brief  Funktion 	legt die Quellen an, alle ohne Fenster
+  * @param  hstats 		STATS handle
+  * @param  Names 		Namen der Quellen (Index = Quelle in MYLIB_STATS_Add())
+  * @param  Count 		Anzahl der Quellen (max. STATS_SOURCES_MAX)
+  * @retval HAL status
+  */
+HAL_StatusTypeDef MYLIB_STATS_Init(STATS_TypeDef *hstats, const char * const *Names, uint8_t Count){
+
+	if(Count > STATS_SOURCES_MAX){
+		return HAL_ERROR;
+	}
+
+	memset(hstats, 0, sizeof(STATS_TypeDef));
+	hstats->Count = Count;
+	for(uint8_t i=0; i<Count; i++){
+		hstats->Source[i].Name = Names[i];
+		MYLIB_STATS_Reset(hstats, i);
+	}
+	return HAL_OK;
+}
+
+/**
+  * @brief  Funktion 	nimmt einen Wert in die Kennwerte der Quelle auf (Welford), schließt ein volles Fenster ab
+  * @param  hstats 		STATS handle
+  * @param  Source 		Index der Quelle
+  * @param  Value 		Wert
+  * @retval none
+  */
+void MYLIB_STATS_Add(STATS_TypeDef *hstats, uint8_t Source, int32_t Value){
+
+	if(Source >= hstats->Count){
+		return;
+	}
+
+	STATS_SourceTypeDef *source = &hstats->Source[Source];
+	STATS_AggregateTypeDef *current = &source->Current;
+	float value = (float)Value;
+	float delta;
+
+	current->Count++;
+	delta = value - current->Mean;
+	current->Mean += delta / (float)current->Count;
+	current->M2 += delta * (value - current->Mean);
+	if(Value < current->Min){
+		current->Min = Value;
+	}
+	if(Value > current->Max){
+		current->Max = Value;
+	}
+
+	if(source->Window != 0 && current->Count >= source->Window){
+		source->Last = *current;
+		source->Windows++;
+		STATS_Clear(current);
+	}
+}
+
+/**
+  * @brief  Funktion 	setzt die Kennwerte und die Anzahl der Fenster einer Quelle zurück, das Fenster bleibt
+  * @param  hstats 		STATS handle
+  * @param  Source 		Index der Quelle
+  * @retval none
+  */
+void MYLIB_STATS_Reset(STATS_TypeDef *hstats, uint8_t Source){
+
+	if(Source >= hstats->Count){
+		return;
+	}
+	STATS_Clear(&hstats->Source[Source].Current);
+	STATS_Clear(&hstats->Source[Source].Last);
+	hstats->Source[Source].Windows = 0;
+}
+
+/**
+  * @brief  Funktion 	liefert die Stichprobenvarianz
+  * @param  Aggregate 	Kennwerte
+  * @retval Varianz, 0 bei weniger als zwei Werten
+  */
+float MYLIB_STATS_Variance(const STATS_AggregateTypeDef *Aggregate){
+
+	return (Aggregate->Count > 1) ? Aggregate->M2 / (float)(Aggregate->Count - 1U) : 0.0f;
+}
+
+/**
+  * @brief  Funktion 	führt die Kommandos der Statistik aus, aus SERIALPROT_Command_User_Callback() aufzurufen
+  * @param  hstats 		STATS handle
+  * @param  hserialprot SERIALPROT handle mit dem zu prüfenden Kommando
+  * @param  Result 		Ergebnispuffer (SERIALPROT_Result_SIZE Zeichen)
+  * @retval SERIALPROT_COMMAND_OK, SERIALPROT_COMMAND_INVALID oder SERIALPROT_COMMAND_UNKNOWN
+  */
+uint8_t MYLIB_STATS_Command(STATS_TypeDef *hstats, SERIALPROTOCOL_TypeDef *hserialprot, uint8_t * Result){
+
+	if(!__SERIALPROT_IS_COMMANDNAME(hserialprot,"sgr") && !__SERIALPROT_IS_COMMANDNAME(hserialprot,"sgw")
+			&& !__SERIALPROT_IS_COMMANDNAME(hserialprot,"sgc")){
+		return SERIALPROT_COMMAND_UNKNOWN;
+	}
+
+	/* alle Kommandos der Statistik: Name der Quelle und eine Zahl */
+	if(hserialprot->MessageKind != MESSAGEKIND_TEXT_NUMBER){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+
+	int8_t index = STATS_Find(hstats, hserialprot->Parameter1);
+	uint16_t param2 = atoi((char *)hserialprot->Parameter2);
+
+	if(index < 0){
+		return SERIALPROT_COMMAND_INVALID;
+	}
+	STATS_SourceTypeDef *source = &hstats->Source[index];
+
+	/* Kennwerte lesen */
+	if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sgr")){
+		if(param2 > 1){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		/* Kopie, damit die Antwort zu einem Stand gehört */
+		STATS_AggregateTypeDef aggregate = (param2 == 0) ? source->Current : source->Last;
+		char *text = (char *)Result;
+
+		utoa(aggregate.Count, text, 10);
+		strcat(text, ",");
+		STATS_FormatFixed(aggregate.Mean, text + strlen(text));
+		strcat(text, ",");
+		STATS_FormatFixed(MYLIB_STATS_Variance(&aggregate), text + strlen(text));
+		strcat(text, ",");
+		itoa(aggregate.Count ? aggregate.Min : 0, text + strlen(text), 10);
+		strcat(text, ",");
+		itoa(aggregate.Count ? aggregate.Max : 0, text + strlen(text), 10);
+		strcat(text, ",");
+		utoa(source->Windows, text + strlen(text), 10);
+		return SERIALPROT_COMMAND_OK;
+
+	/* Fenster setzen */
+	}else if(__SERIALPROT_IS_COMMANDNAME(hserialprot,"sgw")){
+		if(param2 > STATS_WINDOW_MAX){
+			return SERIALPROT_COMMAND_INVALID;
+		}
+		source->Window = param2;
+		MYLIB_STATS_Reset(hstats, index);
+		return SERIALPROT_COMMAND_OK;
+
+	/* zurücksetzen */
+	}else{
+		MYLIB_STATS_Reset(hstats, index);
+		return SERIALPROT_COMMAND_OK;
+	}
+}
+
+/**
+  * @brief  Funktion 	setzt Kennwerte auf "keine Werte"
+  * @param  Aggregate 	Kennwerte
+  * @retval none
+  */
+static void STATS_Clear(STATS_AggregateTypeDef *Aggregate){
+
+	Aggregate->Count = 0;
+	Aggregate->Mean = 0.0f;
+	Aggregate->M2 = 0.0f;
+	Aggregate->Min = INT32_MAX;
+	Aggregate->Max = INT32_MIN;
+}
+
+/**
+  * @brief  Funktion 	sucht eine Quelle nach ihrem Namen
+  * @param  hstats 		STATS handle
+  * @param  Name 		Name aus dem Kommando
+  * @retval Index der Quelle, -1 wenn unbekannt
+  */
+static int8_t STATS_Find(STATS_TypeDef *hstats, const uint8_t *Name){
+
+	for(uint8_t i=0; i<hstats->Count; i++){
+		if(!strcmp(hstats->Source[i].Name, (const char *)Name)){
+			return i;
+		}
+	}
+	return -1;
+}
+
+/**
+  * @brief  Funktion 	schreibt eine Gleitkommazahl mit 3 Nachkommastellen (printf ohne float in newlib-nano)
+  * @param  Value 		Wert
+  * @param  Text 		Zielpuffer (max. 25 Zeichen)
+  * @retval none
+  */
+static void STATS_FormatFixed(float Value, char *Text){
+
+	char digits[21];
+	uint8_t count = 0;
+	uint64_t milli;
+
+	if(Value < 0.0f){
+		*Text++ = '-';
+		Value = -Value;
+	}
+	/* größer als 2^63 / 1000 kommt bei 32-Bit-Werten nur in der Varianz vor und wird begrenzt */
+	milli = (Value < 9.2e15f) ? (uint64_t)(Value * 1000.0f + 0.5f) : 9200000000000000000ULL;
+
+	/* Ziffern rückwärts, mindestens "0.000" */
+	do{
+		digits[count++] = '0' + (milli % 10U);
+		milli /= 10U;
+		if(count == 3){
+			digits[count++] = '.';
+		}
+	}while(milli != 0 || count < 5);
+
+	while(count > 0){
+		*Text++ = digits[--count];
+	}
+	*Text = 0;
+}
@@ -0,0 +1,264 @@
+/**
+******************************************************************************
+* @file encode_decode.c
+* @author Reiter Roman
+* @brief Host-Dekoder für die gepackten Streams (mylib_encode).
+* Das Programm liest die Ausgabe des Boards von stdin und schreibt sie nach stdout:
+* + Gepackte Zeilen "=> #e,az,.." (ADC-Stream), "=> #e,lz,.." (Logikanalysator) und "=> #e,cp,z,.." (Ringaufzeichnung)
+*   werden entpackt und im Hex-Format der ungepackten Zeilen ausgegeben ("ad", "la" bzw. "cp,d")
+* + Alle anderen Zeilen werden unverändert durchgereicht
+* Damit arbeiten Auswertungen für das Hex-Format ohne Änderung mit der gepackten Übertragung.
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man dieses Programm #####
+==============================================================================
+	(#) Übersetzen (im Projektverzeichnis)
+		gcc -O2 -DUSE_HAL_DRIVER -DSTM32L432xx -ICore/Inc -IDrivers/STM32L4xx_HAL_Driver/Inc
+			-IDrivers/CMSIS/Device/ST/STM32L4xx/Include -IDrivers/CMSIS/Include -IMyLibrary/Inc
+			-o encode_decode Tools/encode_decode.c
+
+	(#) Ausgabe des Boards durchleiten (z.B. nach stty -F /dev/ttyACM0 raw 115200)
+		(+) cat /dev/ttyACM0 | ./encode_decode
+		(+) Ctrl-C bzw. Ende der Eingabe gibt die Zähler aus: übertragene Zeichen der gepackten Daten
+			und Zeichen, die dieselben Werte im Hex-Format gebraucht hätten
+
+@endverbatim
+*/
+
+#define _GNU_SOURCE
+#include "mylib_encode.h"
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define LINE_SIZE 512
+#define VALUES_MAX (ENCODE_BYTES_MAX * 2)
+
+static volatile sig_atomic_t running = 1;
+static unsigned long packed_chars, hex_chars, lines_decoded, lines_failed;
+
+/* Base64 ohne Füllzeichen -> Bytes, -1 bei ungültigen Zeichen */
+static int base64_decode(const char *text, uint8_t *bytes, int size)
+{
+	static const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+	uint32_t group = 0;
+	int bits = 0, count = 0;
+
+	for(; *text; text++){
+		const char *c = strchr(alphabet, *text);
+		if(c == NULL){
+			return -1;
+		}
+		group = (group << 6) | (uint32_t)(c - alphabet);
+		bits += 6;
+		if(bits >= 8){
+			bits -= 8;
+			if(count >= size){
+				return -1;
+			}
+			bytes[count++] = (group >> bits) & 0xFFU;
+		}
+	}
+	return count;
+}
+
+/* Token der LZ-Stufe -> Varint-Bytes, -1 bei ungültigen Verweisen */
+static int lz_decode(const uint8_t *in, int length, uint8_t *out, int size)
+{
+	int pos = 0, count = 0;
+
+	while(pos < length){
+		uint8_t token = in[pos++];
+		if(token & 0x80U){
+			int match = (token & 0x7FU) + ENCODE_LZ_MATCH_MIN;
+			int offset;
+			if(pos >= length){
+				return -1;
+			}
+			offset = in[pos++];
+			if(offset == 0 || offset > count || count + match > size){
+				return -1;
+			}
+			/* Byte für Byte, der Verweis darf sich mit dem Ziel überlappen */
+			for(int i = 0; i < match; i++, count++){
+				out[count] = out[count - offset];
+			}
+		}else{
+			int literal = token + 1;
+			if(pos + literal > length || count + literal > size){
+				return -1;
+			}
+			memcpy(&out[count], &in[pos], literal);
+			pos += literal;
+			count += literal;
+		}
+	}
+	return count;
+}
+
+/* Varint-Bytes -> Werte, die Differenzen werden je Feld aufsummiert, -1 bei abgeschnittenem Varint */
+static int delta_decode(const uint8_t *bytes, int length, int fields, int32_t *values, int size)
+{
+	int32_t previous[ENCODE_FIELDS_MAX] = {0};
+	int pos = 0, count = 0;
+
+	while(pos < length && count < size){
+		uint32_t zigzag = 0;
+		int shift = 0;
+		uint8_t byte;
+		do{
+			if(pos >= length || shift > 28){
+				return -1;
+			}
+			byte = bytes[pos++];
+			zigzag |= (uint32_t)(byte & 0x7FU) << shift;
+			shift += 7;
+		}while(byte & 0x80U);
+
+		int32_t delta = (int32_t)(zigzag >> 1) ^ -(int32_t)(zigzag & 1U);
+		values[count] = (int32_t)((uint32_t)previous[count % fields] + (uint32_t)delta);
+		previous[count % fields] = values[count];
+		count++;
+	}
+	return count;
+}
+
+/* Daten einer gepackten Zeile "<modus>,<base64>" -> Werte, -1 bei Fehlern */
+static int unpack(const char *data, int fields, int32_t *values)
+{
+	uint8_t packed[ENCODE_LZ_BYTES_MAX], bytes[ENCODE_BYTES_MAX];
+	int mode, length;
+
+	if((data[0] != '1' && data[0] != '2') || data[1] != ','){
+		return -1;
+	}
+	mode = data[0] - '0';
+	length = base64_decode(&data[2], packed, sizeof(packed));
+	if(length < 0){
+		return -1;
+	}
+	if(mode == ENCODE_MODE_DELTA_LZ){
+		length = lz_decode(packed, length, bytes, sizeof(bytes));
+		if(length < 0){
+			return -1;
+		}
+	}else{
+		memcpy(bytes, packed, length);
+	}
+	packed_chars += strlen(&data[2]);
+	return delta_decode(bytes, length, fields, values, VALUES_MAX);
+}
+
+/* "az,<nr>,<modus>,<daten>" -> "ad,<nr>,<je Wert 3 Hex-Stellen>" */
+static int adc_line(const char *event, char *out)
+{
+	int32_t values[VALUES_MAX];
+	int count;
+
+	if(strlen(event) < 8 || event[7] != ','){
+		return -1;
+	}
+	count = unpack(&event[8], 1, values);
+	if(count < 0){
+		return -1;
+	}
+	out += sprintf(out, "ad,%.4s,", &event[3]);
+	for(int i = 0; i < count; i++){
+		out += sprintf(out, "%03X", (unsigned)values[i] & 0xFFFU);
+	}
+	hex_chars += 3 * count;
+	return 0;
+}
+
+/* "lz,<p|d>,<modus>,<daten>" -> "la,<p|d>,<je Lauf 4 Hex-Stellen Pegel, 4 Hex-Stellen Länge>" */
+static int logic_line(const char *event, char *out)
+{
+	int32_t values[VALUES_MAX];
+	int count;
+
+	if(strlen(event) < 5 || event[4] != ','){
+		return -1;
+	}
+	count = unpack(&event[5], 2, values);
+	if(count < 0 || count % 2 != 0){
+		return -1;
+	}
+	out += sprintf(out, "la,%c,", event[3]);
+	for(int i = 0; i < count; i += 2){
+		out += sprintf(out, "%04X%04X", (unsigned)values[i] & 0xFFFFU, (unsigned)values[i + 1] & 0xFFFFU);
+	}
+	hex_chars += 4 * count;
+	return 0;
+}
+
+/* "cp,z,<nr>,<modus>,<daten>" -> "cp,d,<nr>,<je Wert 4 Hex-Stellen>" */
+static int capture_line(const char *event, char *out)
+{
+	int32_t values[VALUES_MAX];
+	int count;
+
+	if(strlen(event) < 10 || event[9] != ','){
+		return -1;
+	}
+	count = unpack(&event[10], 1, values);
+	if(count < 0){
+		return -1;
+	}
+	out += sprintf(out, "cp,d,%.4s,", &event[5]);
+	for(int i = 0; i < count; i++){
+		out += sprintf(out, "%04X", (unsigned)values[i] & 0xFFFFU);
+	}
+	hex_chars += 4 * count;
+	return 0;
+}
+
+static void stop(int sig)
+{
+	(void)sig;
+	running = 0;
+}
+
+int main(void)
+{
+	char line[LINE_SIZE], decoded[LINE_SIZE + 4 * VALUES_MAX];
+
+	struct sigaction sa;
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = stop;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+
+	while(running && fgets(line, sizeof(line), stdin) != NULL){
+		char *event = strstr(line, "#e,");
+		int status = 1;
+
+		line[strcspn(line, "\r\n")] = 0;
+		if(event != NULL){
+			event += 3;
+			if(!strncmp(event, "az,", 3)){
+				status = adc_line(event, decoded);
+			}else if(!strncmp(event, "lz,", 3)){
+				status = logic_line(event, decoded);
+			}else if(!strncmp(event, "cp,z,", 5)){
+				status = capture_line(event, decoded);
+			}
+		}
+
+		if(status == 0){
+			printf("%.*s%s\n", (int)(event - line), line, decoded);
+			lines_decoded++;
+		}else{
+			if(status < 0){
+				lines_failed++;
+			}
+			printf("%s\n", line);
+		}
+		fflush(stdout);
+	}
+
+	fprintf(stderr, "entpackt %lu, fehlerhaft %lu Zeilen, Daten %lu statt %lu Zeichen im Hex-Format\n",
+			lines_decoded, lines_failed, packed_chars, hex_chars);
+	return 0;
+}
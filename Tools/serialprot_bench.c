@@ -0,0 +1,88 @@
+/**
+******************************************************************************
+* @file serialprot_bench.c
+* @author Reiter Roman
+* @brief Durchsatzmessung des seriellen Protokolls am Host (Speicher-Loopback).
+* Das Programm betreibt eine Instanz des Protokolls über die Speicher-Transportschicht und misst je Kommando:
+* + die Zeit je Zeile von MYLIB_SERIALPROT_LOOPBACK_Write() bis zur fertigen Antwort
+* + die verarbeiteten Eingabe- und Ausgabezeichen je Sekunde
+* Damit lassen sich Änderungen am Kern des Protokolls ohne Board vergleichen (die Werte am Target sind
+* um die Taktfrequenz und den Cortex-M4 langsamer, das Verhältnis der Kommandos bleibt ähnlich).
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man dieses Programm #####
+==============================================================================
+	(#) Übersetzen (im Projektverzeichnis)
+		gcc -O2 -DUSE_HAL_DRIVER -DSTM32L432xx -ICore/Inc -IDrivers/STM32L4xx_HAL_Driver/Inc
+			-IDrivers/CMSIS/Device/ST/STM32L4xx/Include -IDrivers/CMSIS/Include -IMyLibrary/Inc
+			-o serialprot_bench Tools/serialprot_bench.c Tools/serialprot_host.c
+			MyLibrary/Src/mylib_serialprot.c MyLibrary/Src/mylib_serialprot_loopback.c
+
+	(#) Starten
+		(+) ./serialprot_bench [zeilen] [quiet]
+		(+) zeilen: Wiederholungen je Kommando (Vorgabe 100000), quiet = 1: ohne Echo und "Input> " wie SPI/I2C
+		(+) Ausgabe je Kommando: ns je Zeile, Zeilen je Sekunde, Eingabe- und Ausgabezeichen je Sekunde
+
+@endverbatim
+*/
+
+#define _GNU_SOURCE
+#include "mylib_serialprot_loopback.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* gemessene Kommandos: eingebaute Kommandos mit und ohne Ergebnis, NACK und die längste Antwort */
+static const char * const Lines[] = {
+	"#add,1234:4321\r",
+	"#asc,a:0\r",
+	"#gpo,rt:on\r",
+	"#xyz,1:1\r",
+	"#sta,0:0\r",
+};
+
+static double now(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+int main(int argc, char *argv[])
+{
+	static SERIALPROTOCOL_TypeDef hserialprot;
+	static SERIALPROT_LOOPBACK_TypeDef hloopback;
+	static uint8_t output[SERIALPROT_TxQueue_SIZE];
+	long count = (argc > 1) ? atol(argv[1]) : 100000;
+	int quiet = (argc > 2) ? atoi(argv[2]) : 0;
+
+	MYLIB_SERIALPROT_LOOPBACK_Init(&hloopback, output, sizeof(output));
+	MYLIB_SERIALPROT_Init(&hserialprot, &hloopback.Transport);
+	hserialprot.Quiet = quiet;
+
+	printf("%-18s %10s %12s %12s %12s\n", "Kommando", "ns/Zeile", "Zeilen/s", "RX Zeichen/s", "TX Zeichen/s");
+	for(size_t c = 0; c < sizeof(Lines)/sizeof(Lines[0]); c++){
+		uint16_t length = strlen(Lines[c]);
+		unsigned long tx = 0;
+		double start = now(), seconds;
+
+		for(long i = 0; i < count; i++){
+			/* die Loopback meldet jeden Block sofort als gesendet, der Ausgabepuffer wird je Zeile geleert */
+			MYLIB_SERIALPROT_LOOPBACK_Write(&hloopback, (const uint8_t *)Lines[c], length);
+			tx += hloopback.OutputLength;
+			MYLIB_SERIALPROT_LOOPBACK_Flush(&hloopback);
+		}
+		seconds = now() - start;
+
+		char name[32];
+		snprintf(name, sizeof(name), "%.*s", (int)(length - 1), Lines[c]);
+		printf("%-18s %10.0f %12.0f %12.0f %12.0f\n", name, seconds * 1e9 / count, count / seconds,
+				count * length / seconds, tx / seconds);
+	}
+
+	fprintf(stderr, "verworfen %u, Ausgabe abgeschnitten %u Zeichen\n",
+			(unsigned)hserialprot.Statistics.TxDropped, (unsigned)hloopback.OutputDropped);
+	return 0;
+}
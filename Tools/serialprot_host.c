@@ -0,0 +1,37 @@
+/**
+******************************************************************************
+* @file serialprot_host.c
+* @author Reiter Roman
+* @brief Ersatzfunktionen der Target-Bibliotheken für die Host-Programme (Linux).
+* Das serielle Protokoll (mylib_serialprot.c) braucht am Host nur diese Funktionen:
+* + HAL_GetTick() für den Startwert von "rdm"
+* + itoa() (in newlib enthalten, in glibc nicht)
+* + SERIALPROT_Command_GPO_Callback(), ohne LEDs wird jedes "gpo"-Kommando bestätigt
+* Verwendet von Tools/serialprot_pty.c und Tools/serialprot_bench.c.
+*
+******************************************************************************
+*/
+
+#include "mylib_serialprot.h"
+#include <stdio.h>
+#include <time.h>
+
+uint32_t HAL_GetTick(void)
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint32_t)(ts.tv_sec * 1000U + ts.tv_nsec / 1000000U);
+}
+
+char * itoa(int value, char * str, int base)
+{
+	(void)base;
+	sprintf(str, "%d", value);
+	return str;
+}
+
+uint8_t SERIALPROT_Command_GPO_Callback(SERIALPROTOCOL_TypeDef *hserialprot)
+{
+	(void)hserialprot;
+	return 0;
+}
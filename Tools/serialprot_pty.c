@@ -0,0 +1,112 @@
+/**
+******************************************************************************
+* @file serialprot_pty.c
+* @author Reiter Roman
+* @brief Host-Ersatz für den USB-CDC-ACM-Port (Linux).
+* Das Programm betreibt das serielle Protokoll mit der USB-Transportschicht am Host und stellt es als
+* Pseudo-Terminal bereit, das sich wie /dev/ttyACM0 verhält:
+* + Eingaben werden wie OUT-Pakete in Blöcken bis SERIALPROT_USB_PACKET_SIZE übergeben
+* + Antworten werden wie IN-Übertragungen in Paketen gesendet und gezählt
+* Damit können Host-Programme und der Durchsatz der Bündelung ohne Board getestet werden.
+*
+@verbatim
+==============================================================================
+###### Wie benutzt man dieses Programm #####
+==============================================================================
+	(#) Übersetzen (im Projektverzeichnis)
+		gcc -O2 -DUSE_HAL_DRIVER -DSTM32L432xx -ICore/Inc -IDrivers/STM32L4xx_HAL_Driver/Inc
+			-IDrivers/CMSIS/Device/ST/STM32L4xx/Include -IDrivers/CMSIS/Include -IMyLibrary/Inc
+			-o serialprot_pty Tools/serialprot_pty.c Tools/serialprot_host.c
+			MyLibrary/Src/mylib_serialprot.c MyLibrary/Src/mylib_serialprot_usb.c
+
+	(#) Starten, das Programm gibt den Namen des Terminals aus (z.B. /dev/pts/3)
+		(+) Mit einem Terminalprogramm verbinden (z.B. picocom /dev/pts/3) oder Kommandos direkt schreiben
+		(+) Ctrl-C beendet das Programm und gibt die Zähler der Übertragungen aus
+
+@endverbatim
+*/
+
+#define _GNU_SOURCE
+#include "mylib_serialprot_usb.h"
+#include <fcntl.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+static volatile sig_atomic_t running = 1;
+
+/* Endpunkt-Treiber: Block in Paketen in den pty schreiben, danach sofort als abgeholt melden */
+static SERIALPROT_USB_TypeDef hserialusb;
+
+static HAL_StatusTypeDef pty_send(void *pDriver, uint8_t *pData, uint16_t Size)
+{
+	int fd = *(int *)pDriver;
+
+	for(uint16_t pos = 0; pos < Size; pos += SERIALPROT_USB_PACKET_SIZE){
+		uint16_t n = (Size - pos > SERIALPROT_USB_PACKET_SIZE) ? SERIALPROT_USB_PACKET_SIZE : Size - pos;
+		if(write(fd, &pData[pos], n) != n){
+			return HAL_ERROR;
+		}
+	}
+	MYLIB_SERIALPROT_USB_TxCpltCallback(&hserialusb);
+	return HAL_OK;
+}
+
+static void stop(int sig)
+{
+	(void)sig;
+	running = 0;
+}
+
+int main(void)
+{
+	static SERIALPROTOCOL_TypeDef hserialprot;
+	struct termios tio;
+	uint8_t packet[SERIALPROT_USB_PACKET_SIZE];
+	int master, slave;
+
+	master = posix_openpt(O_RDWR | O_NOCTTY);
+	if(master < 0 || grantpt(master) != 0 || unlockpt(master) != 0){
+		perror("posix_openpt");
+		return 1;
+	}
+
+	/* Seite der Clients roh schalten und offen halten, damit der pty beim Schließen eines Clients bestehen bleibt */
+	slave = open(ptsname(master), O_RDWR | O_NOCTTY);
+	if(slave < 0){
+		perror("open");
+		return 1;
+	}
+	tcgetattr(slave, &tio);
+	cfmakeraw(&tio);
+	tcsetattr(slave, TCSANOW, &tio);
+
+	MYLIB_SERIALPROT_USB_Init(&hserialusb, pty_send, &master);
+	MYLIB_SERIALPROT_Init(&hserialprot, &hserialusb.Transport);
+
+	/* ohne SA_RESTART, damit read() beim Beenden abbricht */
+	struct sigaction sa;
+	memset(&sa, 0, sizeof(sa));
+	sa.sa_handler = stop;
+	sigaction(SIGINT, &sa, NULL);
+	sigaction(SIGTERM, &sa, NULL);
+	printf("%s\n", ptsname(master));
+	fflush(stdout);
+
+	while(running){
+		ssize_t n = read(master, packet, sizeof(packet));
+		if(n > 0){
+			MYLIB_SERIALPROT_USB_RxCallback(&hserialusb, packet, (uint32_t)n);
+		}
+	}
+
+	fprintf(stderr, "OUT-Pakete %u, IN-Übertragungen %u, IN-Pakete %u, RX %u, TX %u Zeichen\n",
+			(unsigned)hserialusb.RxPackets, (unsigned)hserialusb.TxTransfers, (unsigned)hserialusb.TxPackets,
+			(unsigned)hserialprot.Statistics.RxBytes, (unsigned)hserialprot.Statistics.TxBytes);
+	close(slave);
+	close(master);
+	return 0;
+}